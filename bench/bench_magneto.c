@@ -0,0 +1,770 @@
+// Needed for `clock_gettime`
+#define _POSIX_C_SOURCE 199309L
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "magneto/cache.h"
+#include "magneto/magneto.h"
+#include "magneto/model.h"
+#include "magneto/parallel.h"
+#include "magneto/registry.h"
+#include "magneto/wmm.h"
+
+typedef magneto_real real;
+
+// Number of input points in each data set
+#define NUM_POINTS      (4096U)
+#define MAX_RESULTS     (128U)
+
+typedef char check_grid_points[(64U * 64U == NUM_POINTS) ? 1 : -1];
+
+// ---- Timing ----
+
+/// Monotonic wall-clock time in seconds
+static double now_sec(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq;
+    LARGE_INTEGER count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double) count.QuadPart / (double) freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+#endif
+}
+
+// ---- Input data sets ----
+
+/// Small deterministic PRNG (xorshift64*), so runs are comparable
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+static double rng_uniform(const double lo, const double hi) {
+    rng_state ^= rng_state >> 12U;
+    rng_state ^= rng_state << 25U;
+    rng_state ^= rng_state >> 27U;
+    const uint64_t x = rng_state * 0x2545F4914F6CDD1DULL;
+    return lo + ((hi - lo) * ((double) (x >> 11U) / 9007199254740992.0));
+}
+
+typedef struct {
+    const char *name;
+    real latitude[NUM_POINTS];
+    real longitude[NUM_POINTS];
+    real height[NUM_POINTS];
+    magneto_DecYear time[NUM_POINTS];
+    magneto_Coords coords[NUM_POINTS];
+    magneto_SphericalCoords spherical[NUM_POINTS];
+    magneto_EcefPosition ecef[NUM_POINTS];
+    real vector[NUM_POINTS][3];
+} Inputs;
+
+/// Fill remaining representations of each point from its geodetic coordinates
+static void finish_inputs(Inputs *const in) {
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        const magneto_Coords coords = { in->latitude[i], in->longitude[i], in->height[i] };
+        in->coords[i] = coords;
+        in->spherical[i] = magneto_SphericalCoords_from_coords(coords);
+        in->ecef[i] = magneto_EcefPosition_from_coords(coords);
+        in->vector[i][0] = (real) rng_uniform(-50000.0, 50000.0);
+        in->vector[i][1] = (real) rng_uniform(-50000.0, 50000.0);
+        in->vector[i][2] = (real) rng_uniform(-50000.0, 50000.0);
+    }
+}
+
+/// Uniformly random points & times anywhere on the globe
+static void gen_random_inputs(Inputs *const in) {
+    in->name = "random";
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        in->latitude[i] = (real) rng_uniform(-89.9, 89.9);
+        in->longitude[i] = (real) rng_uniform(-180.0, 180.0);
+        in->height[i] = (real) rng_uniform(-1000.0, 850000.0);
+        in->time[i].year = (real) rng_uniform(2020.0, 2025.0);
+    }
+    finish_inputs(in);
+}
+
+/// Spatially coherent points along a single trajectory, at 1 Hz from the same epoch
+static void gen_coherent_inputs(Inputs *const in) {
+    in->name = "coherent";
+    double lat = 43.6;
+    double lon = -79.4;
+    double height = 10000.0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        lat += 0.002;
+        lon += 0.003;
+        height += rng_uniform(-5.0, 5.0);
+        in->latitude[i] = (real) lat;
+        in->longitude[i] = (real) lon;
+        in->height[i] = (real) height;
+        in->time[i].year = (real) (2022.5 + ((double) i / (365.25 * 86400.0)));
+    }
+    finish_inputs(in);
+}
+
+// ---- Benchmarks ----
+
+/// Sink for results, so work can't be optimized away
+static volatile real sink;
+
+/// Evaluate every point of the input set once
+typedef void (*BenchFn)(const Inputs *in);
+
+static void bench_eval_field(const Inputs *const in) {
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        acc += eval_field(&magneto_MODEL_WMM2020, in->time[i], in->coords[i]).F;
+    }
+    sink = acc;
+}
+
+static void bench_eval_field_registry(const Inputs *const in) {
+    static magneto_RegistryReader readers[1];
+    static magneto_ModelRegistry registry;
+    if (registry.model == NULL) {
+        magneto_ModelRegistry_init(&registry, &magneto_MODEL_WMM2020, readers, 1U);
+    }
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        acc += eval_field_registry(&registry, 0U, in->time[i], in->coords[i]).F;
+    }
+    sink = acc;
+}
+
+static void bench_eval_field_with_rates(const Inputs *const in) {
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        magneto_FieldRates rates;
+        acc += eval_field_with_rates(&magneto_MODEL_WMM2020, in->time[i], in->coords[i], &rates).F;
+        acc += rates.F;
+    }
+    sink = acc;
+}
+
+static void bench_eval_field_with_gradient(const Inputs *const in) {
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        magneto_FieldGradient gradient;
+        acc += eval_field_with_gradient(&magneto_MODEL_WMM2020, in->time[i], in->coords[i], &gradient).F;
+        acc += gradient.dB_ned[2][0];
+    }
+    sink = acc;
+}
+
+/// Same points raised to geostationary height, where most degrees are below 1 nT
+static void bench_eval_field_geo(const Inputs *const in) {
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        magneto_Coords coords = in->coords[i];
+        coords.height += (real) 35786e3;
+        acc += eval_field(&magneto_MODEL_WMM2020, in->time[i], coords).F;
+    }
+    sink = acc;
+}
+
+static void bench_eval_field_truncated(const Inputs *const in, const real height_offset) {
+    const magneto_TruncationOptions options = { 1, 0U };
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        magneto_Coords coords = in->coords[i];
+        coords.height += height_offset;
+        acc += eval_field_truncated(&magneto_MODEL_WMM2020, in->time[i], coords, &options, NULL).F;
+    }
+    sink = acc;
+}
+
+static void bench_eval_field_truncated_1nT(const Inputs *const in) {
+    bench_eval_field_truncated(in, 0);
+}
+
+static void bench_eval_field_truncated_geo_1nT(const Inputs *const in) {
+    bench_eval_field_truncated(in, (real) 35786e3);
+}
+
+static void bench_eval_field_batch(const Inputs *const in) {
+    static real B_n[NUM_POINTS];
+    static real B_e[NUM_POINTS];
+    static real B_d[NUM_POINTS];
+    const magneto_CoordsBatch batch_in = { in->latitude, in->longitude, in->height, in->time };
+    const magneto_FieldStateBatch batch_out = { { B_n, B_e, B_d }, NULL, NULL, NULL, NULL };
+    eval_field_batch(&magneto_MODEL_WMM2020, NUM_POINTS, &batch_in, &batch_out);
+    sink = B_n[NUM_POINTS - 1U];
+}
+
+// Thread scaling of the parallel batch evaluator, on the same points as `eval_field_batch`
+static void bench_eval_field_batch_parallel(const Inputs *const in, const size_t num_threads) {
+    static real B_n[NUM_POINTS];
+    static real B_e[NUM_POINTS];
+    static real B_d[NUM_POINTS];
+    const magneto_CoordsBatch batch_in = { in->latitude, in->longitude, in->height, in->time };
+    const magneto_FieldStateBatch batch_out = { { B_n, B_e, B_d }, NULL, NULL, NULL, NULL };
+    const magneto_ParallelOptions options = { num_threads, NUM_POINTS / 16U, NULL };
+    eval_field_batch_parallel(&magneto_MODEL_WMM2020, NUM_POINTS, &batch_in, &batch_out, &options);
+    sink = B_n[NUM_POINTS - 1U];
+}
+
+#define DEFINE_BENCH_THREADS(N) \
+    static void bench_eval_field_batch_parallel_##N(const Inputs *const in) { bench_eval_field_batch_parallel(in, N##U); }
+
+DEFINE_BENCH_THREADS(1)
+DEFINE_BENCH_THREADS(2)
+DEFINE_BENCH_THREADS(4)
+DEFINE_BENCH_THREADS(8)
+
+static void bench_eval_field_snapshot(const Inputs *const in) {
+    static real buffer[MAGNETO_SNAPSHOT_LEN(90U)];
+    const magneto_ModelSnapshot snapshot = magneto_ModelSnapshot_from_model(
+        &magneto_MODEL_WMM2020, in->time[0], buffer, sizeof(buffer) / sizeof(buffer[0])
+    );
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        acc += eval_field_snapshot(&snapshot, in->coords[i]).F;
+    }
+    sink = acc;
+}
+
+static void bench_eval_field_grid(const Inputs *const in) {
+    // Square grid using the first coordinates of the input set, same number of points
+    enum { GRID_SIZE = 64 };
+    static real B_d[GRID_SIZE * GRID_SIZE];
+    static real workspace[MAGNETO_GRID_WORKSPACE_LEN(12U, GRID_SIZE)];
+    const magneto_CoordsGrid grid = { in->latitude, in->longitude, in->height, GRID_SIZE, GRID_SIZE, 1U };
+    const magneto_FieldStateBatch out = { { NULL, NULL, B_d }, NULL, NULL, NULL, NULL };
+    eval_field_grid(&magneto_MODEL_WMM2020, in->time[0], &grid, &out, workspace, sizeof(workspace) / sizeof(workspace[0]));
+    sink = B_d[0];
+}
+
+static void bench_eval_field_incremental(const Inputs *const in) {
+    static real workspace[MAGNETO_EVALUATOR_WORKSPACE_LEN(12U, 90U)];
+    magneto_Evaluator evaluator = magneto_Evaluator_from_model(
+        &magneto_MODEL_WMM2020, workspace, sizeof(workspace) / sizeof(workspace[0])
+    );
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        acc += eval_field_incremental(&evaluator, in->time[i], in->coords[i]).F;
+    }
+    sink = acc;
+}
+
+static void bench_field_cache_lookup(const Inputs *const in) {
+    // Cache a 1 deg x 1 deg x 10 km region once, & fold every input point into it up front
+    static real buffer[MAGNETO_FIELD_CACHE_SIZE(4096U) / sizeof(real)];
+    static magneto_Coords folded[NUM_POINTS];
+    static const Inputs *folded_inputs = NULL;
+    static const magneto_Coords min = { 44, -76, 0 };
+    static const magneto_Coords max = { 45, -75, 10e3 };
+    if (folded_inputs == NULL) {
+        magneto_FieldCache_build(&magneto_MODEL_WMM2020, in->time[0], min, max, 1, 8U, buffer, sizeof(buffer));
+    }
+    if (folded_inputs != in) {
+        for (size_t i = 0U; i < NUM_POINTS; ++i) {
+            folded[i].latitude = min.latitude + (real) fmod(fabs((double) in->latitude[i]), 1.0);
+            folded[i].longitude = min.longitude + (real) fmod(fabs((double) in->longitude[i]), 1.0);
+            folded[i].height = min.height + (real) fmod(fabs((double) in->height[i]), 10e3);
+        }
+        folded_inputs = in;
+    }
+
+    const magneto_FieldCacheHeader *const cache = (const magneto_FieldCacheHeader *) buffer;
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        real B_ned[3] = { 0, 0, 0 };
+        magneto_FieldCache_lookup(cache, folded[i], B_ned);
+        acc += B_ned[2];
+    }
+    sink = acc;
+}
+
+static void bench_eval_field_cached(const Inputs *const in) {
+    // 16 fixed sites polled about every second, so nearly every query is a hit after the first pass
+    static int64_t buffer[MAGNETO_RESULT_CACHE_SIZE(64U) / sizeof(int64_t)];
+    const magneto_ResultCacheSteps steps = { (real) 1e-4, (real) 1e-4, 1, (real) (1.0 / 365.25) };
+    magneto_ResultCache *const cache = magneto_ResultCache_init(&magneto_MODEL_WMM2020, steps, buffer, sizeof(buffer));
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        const magneto_DecYear t = { in->time[0].year + (real) ((double) (i / 16U) / 31557600.0) };
+        acc += eval_field_cached(cache, t, in->coords[i % 16U]).F;
+    }
+    sink = acc;
+}
+
+// Degree sweep of the Schmidt normalized path, on a synthetic model truncated to each degree
+#define SWEEP_MAX_DEGREE    (720U)
+#define SWEEP_NUM_COEFFS    (MAGNETO_CALC_INDEX(SWEEP_MAX_DEGREE, SWEEP_MAX_DEGREE) + 1U)
+#define SWEEP_POINTS        (16U)
+
+static void bench_eval_field_degree(const Inputs *const in, const size_t degree, const bool is_order_major) {
+    // Spectrum decaying with degree like crustal field models, as interleaved {g, h} stored
+    // degree-major, so a truncated model is just a prefix of the full one
+    static real coeffs[2U * SWEEP_NUM_COEFFS];
+    static real secular[2U * SWEEP_NUM_COEFFS];
+    // Interleaved {root, inv_root} of 0 to twice the degree, like a generated Schmidt model has
+    static real roots[2U * ((2U * SWEEP_MAX_DEGREE) + 1U)];
+    static bool is_init = false;
+    if (!is_init) {
+        for (size_t k = 1U; k <= (2U * SWEEP_MAX_DEGREE); ++k) {
+            roots[2U * k] = (real) sqrt((double) k);
+            roots[(2U * k) + 1U] = (real) (1.0 / sqrt((double) k));
+        }
+        for (size_t n = 1U; n <= SWEEP_MAX_DEGREE; ++n) {
+            for (size_t m = 0U; m <= n; ++m) {
+                const double scale = 3e4 / ((double) n * (double) n);
+                const size_t i = MAGNETO_CALC_INDEX(n, m);
+                coeffs[2U * i] = (real) (scale * sin((double) ((7U * n) + (3U * m))));
+                coeffs[(2U * i) + 1U] = (m > 0U) ? (real) (scale * cos((double) ((5U * n) + (11U * m)))) : 0;
+            }
+        }
+        is_init = true;
+    }
+    // Order-major terms aren't a prefix of the full model's, so are rebuilt for each degree
+    static real terms[4U * SWEEP_NUM_COEFFS];
+    static size_t terms_degree = 0U;
+    if (is_order_major && (terms_degree != degree)) {
+        size_t i_term = 0U;
+        for (size_t m = 0U; m <= degree; ++m) {
+            for (size_t n = ((m > 0U) ? m : 1U); n <= degree; ++n) {
+                const size_t i = MAGNETO_CALC_INDEX(n, m);
+                terms[4U * i_term] = coeffs[2U * i];
+                terms[(4U * i_term) + 1U] = coeffs[(2U * i) + 1U];
+                terms[(4U * i_term) + 2U] = secular[2U * i];
+                terms[(4U * i_term) + 3U] = secular[(2U * i) + 1U];
+                ++i_term;
+            }
+        }
+        terms_degree = degree;
+    }
+    const magneto_ModelCoeffs models[1] = { { (const magneto_SphericalHarmonicCoeff *) coeffs } };
+    const magneto_Model model = {
+        .epoch = { 2020 },
+        .nm_max = degree,
+        .num_model_coeffs = MAGNETO_CALC_INDEX(degree, degree) + 1U,
+        .num_models = 1U,
+        .model_interval = { 5 },
+        .models = models,
+        .last_secular = { (const magneto_SphericalHarmonicCoeff *) secular },
+        .recursion = NULL,
+        .normalization = magneto_NORMALIZATION_SCHMIDT,
+        .terms = is_order_major ? (const magneto_SphericalHarmonicTerm *) terms : NULL,
+        .roots = (const magneto_SquareRoot *) roots
+    };
+
+    real acc = 0;
+    for (size_t i = 0U; i < SWEEP_POINTS; ++i) {
+        acc += eval_field(&model, in->time[i], in->coords[i]).F;
+    }
+    sink = acc;
+}
+
+#define DEFINE_BENCH_DEGREE(N) \
+    static void bench_eval_field_degree_##N(const Inputs *const in) { bench_eval_field_degree(in, N##U, false); } \
+    static void bench_eval_field_order_major_degree_##N(const Inputs *const in) { \
+        bench_eval_field_degree(in, N##U, true); \
+    }
+
+DEFINE_BENCH_DEGREE(12)
+DEFINE_BENCH_DEGREE(50)
+DEFINE_BENCH_DEGREE(100)
+DEFINE_BENCH_DEGREE(200)
+DEFINE_BENCH_DEGREE(360)
+DEFINE_BENCH_DEGREE(720)
+
+static void bench_dec_year_from_date_time(const Inputs *const in) {
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        const magneto_DateTime t = {
+            (uint16_t) (2020U + (i % 5U)), (uint8_t) (1U + (i % 12U)), (uint8_t) (1U + (i % 28U)),
+            (uint8_t) (i % 24U), (uint8_t) (i % 60U), (uint8_t) ((i / 60U) % 60U)
+        };
+        acc += magneto_DecYear_from_date_time(t).year;
+    }
+    (void) in;
+    sink = acc;
+}
+
+/// Unix time of each input point, sorted like a monotonic telemetry stream
+static const double *unix_seconds(const Inputs *const in) {
+    static double seconds[NUM_POINTS];
+    static const Inputs *seconds_inputs = NULL;
+    if (seconds_inputs != in) {
+        // Starting from the first point's time, with a second or so between points
+        const double start = ((double) in->time[0].year - 1970.0) * 31556952.0;
+        for (size_t i = 0U; i < NUM_POINTS; ++i) {
+            seconds[i] = start + (double) i + fmod(fabs((double) in->latitude[i]), 1.0);
+        }
+        seconds_inputs = in;
+    }
+    return seconds;
+}
+
+static void bench_dec_year_from_unix(const Inputs *const in) {
+    const double *const seconds = unix_seconds(in);
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        acc += magneto_DecYear_from_unix(seconds[i]).year;
+    }
+    sink = acc;
+}
+
+static void bench_dec_year_from_unix_cached(const Inputs *const in) {
+    const double *const seconds = unix_seconds(in);
+    magneto_YearCache cache = { 0.0, 0.0, 0.0, 0.0 };
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        acc += magneto_DecYear_from_unix_cached(&cache, seconds[i]).year;
+    }
+    sink = acc;
+}
+
+static void bench_dec_year_from_unix_batch(const Inputs *const in) {
+    static magneto_DecYear out[NUM_POINTS];
+    magneto_DecYear_from_unix_batch(NUM_POINTS, unix_seconds(in), out);
+    sink = out[NUM_POINTS - 1U].year;
+}
+
+static void bench_coords_from_spherical(const Inputs *const in) {
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        acc += magneto_Coords_from_spherical(in->spherical[i]).height;
+    }
+    sink = acc;
+}
+
+static void bench_coords_from_ecef(const Inputs *const in) {
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        acc += magneto_Coords_from_ecef(in->ecef[i]).height;
+    }
+    sink = acc;
+}
+
+static void bench_coords_from_ecef_fast(const Inputs *const in) {
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        acc += magneto_Coords_from_ecef_fast(in->ecef[i]).height;
+    }
+    sink = acc;
+}
+
+static void bench_coords_from_ecef_fast_batch(const Inputs *const in) {
+    // Split into structure-of-arrays once per input set, outside of timing
+    static real x[NUM_POINTS], y[NUM_POINTS], z[NUM_POINTS];
+    static real lat[NUM_POINTS], lon[NUM_POINTS], height[NUM_POINTS];
+    static const Inputs *split_inputs = NULL;
+    if (split_inputs != in) {
+        for (size_t i = 0U; i < NUM_POINTS; ++i) {
+            x[i] = in->ecef[i].x;
+            y[i] = in->ecef[i].y;
+            z[i] = in->ecef[i].z;
+        }
+        split_inputs = in;
+    }
+    magneto_Coords_from_ecef_fast_batch(NUM_POINTS, x, y, z, lat, lon, height);
+    sink = height[NUM_POINTS - 1U];
+}
+
+/// Positions from near the centre out to lunar distance, a quarter of them within ~100 m of a
+/// pole, where geodetic conversions are least accurate or slowest to converge
+static const magneto_EcefPosition *ecef_altitude_sweep(void) {
+    static magneto_EcefPosition sweep[NUM_POINTS];
+    static bool is_init = false;
+    if (!is_init) {
+        for (size_t i = 0U; i < NUM_POINTS; ++i) {
+            const double pole_lat = (i % 2U == 0U) ? 90.0 : -90.0;
+            const double lat = (i % 4U == 0U) ? (pole_lat - rng_uniform(-1e-3, 1e-3)) : rng_uniform(-90.0, 90.0);
+            const double radius = exp(rng_uniform(log(100e3), log(4e8)));
+            const magneto_Coords coords = {
+                (real) lat,
+                (real) rng_uniform(-180.0, 180.0),
+                (real) (radius - (double) magneto_WGS84_A)
+            };
+            sweep[i] = magneto_EcefPosition_from_coords(coords);
+        }
+        is_init = true;
+    }
+    return sweep;
+}
+
+static void bench_coords_from_ecef_sweep(const Inputs *const in) {
+    const magneto_EcefPosition *const sweep = ecef_altitude_sweep();
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        acc += magneto_Coords_from_ecef(sweep[i]).height;
+    }
+    (void) in;
+    sink = acc;
+}
+
+static void bench_coords_from_ecef_fast_sweep(const Inputs *const in) {
+    const magneto_EcefPosition *const sweep = ecef_altitude_sweep();
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        acc += magneto_Coords_from_ecef_fast(sweep[i]).height;
+    }
+    (void) in;
+    sink = acc;
+}
+
+static void bench_spherical_from_coords(const Inputs *const in) {
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        acc += magneto_SphericalCoords_from_coords(in->coords[i]).radius;
+    }
+    sink = acc;
+}
+
+static void bench_geocentric_frame_from_coords(const Inputs *const in) {
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        acc += magneto_GeocentricFrame_from_coords(in->coords[i]).sin_eps;
+    }
+    sink = acc;
+}
+
+static void bench_geocentric_frame_from_coords_batch(const Inputs *const in) {
+    static magneto_GeocentricFrame frames[NUM_POINTS];
+    magneto_GeocentricFrame_from_coords_batch(NUM_POINTS, in->coords, frames);
+    sink = frames[NUM_POINTS - 1U].sin_eps;
+}
+
+static void bench_spherical_from_ecef(const Inputs *const in) {
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        acc += magneto_SphericalCoords_from_ecef(in->ecef[i]).radius;
+    }
+    sink = acc;
+}
+
+static void bench_ecef_from_coords(const Inputs *const in) {
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        acc += magneto_EcefPosition_from_coords(in->coords[i]).z;
+    }
+    sink = acc;
+}
+
+static void bench_ecef_from_spherical(const Inputs *const in) {
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        acc += magneto_EcefPosition_from_spherical(in->spherical[i]).z;
+    }
+    sink = acc;
+}
+
+static void bench_field_state_from_ned(const Inputs *const in) {
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        acc += magneto_FieldState_from_ned(in->vector[i]).D;
+    }
+    sink = acc;
+}
+
+static void bench_vector_ned_to_ecef(const Inputs *const in) {
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        real ecef[3];
+        magneto_convert_vector_ned_to_ecef(in->coords[i], in->vector[i], ecef);
+        acc += ecef[2];
+    }
+    sink = acc;
+}
+
+static void bench_vector_ecef_to_ned(const Inputs *const in) {
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        real ned[3];
+        magneto_convert_vector_ecef_to_ned(in->coords[i], in->vector[i], ned);
+        acc += ned[2];
+    }
+    sink = acc;
+}
+
+static void bench_matrix_ned_to_ecef(const Inputs *const in) {
+    real acc = 0;
+    for (size_t i = 0U; i < NUM_POINTS; ++i) {
+        real matrix[9];
+        magneto_matrix_ned_to_ecef(in->coords[i], matrix);
+        acc += matrix[0];
+    }
+    sink = acc;
+}
+
+typedef struct {
+    const char *name;
+    BenchFn fn;
+    size_t num_points;  ///< Points evaluated per pass, all of the input set if 0
+} Benchmark;
+
+static const Benchmark BENCHMARKS[] = {
+    { "eval_field", bench_eval_field, 0U },
+    { "eval_field_registry", bench_eval_field_registry, 0U },
+    { "eval_field_with_rates", bench_eval_field_with_rates, 0U },
+    { "eval_field_with_gradient", bench_eval_field_with_gradient, 0U },
+    { "eval_field_geo", bench_eval_field_geo, 0U },
+    { "eval_field_truncated_1nT", bench_eval_field_truncated_1nT, 0U },
+    { "eval_field_truncated_geo_1nT", bench_eval_field_truncated_geo_1nT, 0U },
+    { "eval_field_batch", bench_eval_field_batch, 0U },
+    { "eval_field_batch_parallel_1", bench_eval_field_batch_parallel_1, 0U },
+    { "eval_field_batch_parallel_2", bench_eval_field_batch_parallel_2, 0U },
+    { "eval_field_batch_parallel_4", bench_eval_field_batch_parallel_4, 0U },
+    { "eval_field_batch_parallel_8", bench_eval_field_batch_parallel_8, 0U },
+    { "eval_field_snapshot", bench_eval_field_snapshot, 0U },
+    { "eval_field_grid", bench_eval_field_grid, 0U },
+    { "eval_field_incremental", bench_eval_field_incremental, 0U },
+    { "magneto_FieldCache_lookup", bench_field_cache_lookup, 0U },
+    { "eval_field_cached_fixed_sites", bench_eval_field_cached, 0U },
+    { "eval_field_schmidt_degree_12", bench_eval_field_degree_12, SWEEP_POINTS },
+    { "eval_field_schmidt_degree_50", bench_eval_field_degree_50, SWEEP_POINTS },
+    { "eval_field_schmidt_degree_100", bench_eval_field_degree_100, SWEEP_POINTS },
+    { "eval_field_schmidt_degree_200", bench_eval_field_degree_200, SWEEP_POINTS },
+    { "eval_field_schmidt_degree_360", bench_eval_field_degree_360, SWEEP_POINTS },
+    { "eval_field_schmidt_degree_720", bench_eval_field_degree_720, SWEEP_POINTS },
+    { "eval_field_schmidt_order_major_degree_12", bench_eval_field_order_major_degree_12, SWEEP_POINTS },
+    { "eval_field_schmidt_order_major_degree_50", bench_eval_field_order_major_degree_50, SWEEP_POINTS },
+    { "eval_field_schmidt_order_major_degree_100", bench_eval_field_order_major_degree_100, SWEEP_POINTS },
+    { "eval_field_schmidt_order_major_degree_200", bench_eval_field_order_major_degree_200, SWEEP_POINTS },
+    { "eval_field_schmidt_order_major_degree_360", bench_eval_field_order_major_degree_360, SWEEP_POINTS },
+    { "eval_field_schmidt_order_major_degree_720", bench_eval_field_order_major_degree_720, SWEEP_POINTS },
+    { "magneto_DecYear_from_date_time", bench_dec_year_from_date_time, 0U },
+    { "magneto_DecYear_from_unix", bench_dec_year_from_unix, 0U },
+    { "magneto_DecYear_from_unix_cached", bench_dec_year_from_unix_cached, 0U },
+    { "magneto_DecYear_from_unix_batch", bench_dec_year_from_unix_batch, 0U },
+    { "magneto_Coords_from_spherical", bench_coords_from_spherical, 0U },
+    { "magneto_Coords_from_ecef", bench_coords_from_ecef, 0U },
+    { "magneto_Coords_from_ecef_fast", bench_coords_from_ecef_fast, 0U },
+    { "magneto_Coords_from_ecef_fast_batch", bench_coords_from_ecef_fast_batch, 0U },
+    { "magneto_Coords_from_ecef_altitude_sweep", bench_coords_from_ecef_sweep, 0U },
+    { "magneto_Coords_from_ecef_fast_altitude_sweep", bench_coords_from_ecef_fast_sweep, 0U },
+    { "magneto_SphericalCoords_from_coords", bench_spherical_from_coords, 0U },
+    { "magneto_GeocentricFrame_from_coords", bench_geocentric_frame_from_coords, 0U },
+    { "magneto_GeocentricFrame_from_coords_batch", bench_geocentric_frame_from_coords_batch, 0U },
+    { "magneto_SphericalCoords_from_ecef", bench_spherical_from_ecef, 0U },
+    { "magneto_EcefPosition_from_coords", bench_ecef_from_coords, 0U },
+    { "magneto_EcefPosition_from_spherical", bench_ecef_from_spherical, 0U },
+    { "magneto_FieldState_from_ned", bench_field_state_from_ned, 0U },
+    { "magneto_convert_vector_ned_to_ecef", bench_vector_ned_to_ecef, 0U },
+    { "magneto_convert_vector_ecef_to_ned", bench_vector_ecef_to_ned, 0U },
+    { "magneto_matrix_ned_to_ecef", bench_matrix_ned_to_ecef, 0U },
+};
+
+#define NUM_BENCHMARKS  (sizeof(BENCHMARKS) / sizeof(BENCHMARKS[0]))
+
+typedef struct {
+    const char *name;
+    const char *inputs;
+    double ns_per_eval;
+    double evals_per_sec;
+} Result;
+
+/// Run `fn` over the inputs repeatedly for at least `min_time` seconds, keeping the best pass
+static Result run_benchmark(const Benchmark *const bench, const Inputs *const in, const double min_time) {
+    // Warm up caches & branch predictors
+    bench->fn(in);
+
+    double best = -1.0;
+    const double start = now_sec();
+    do {
+        const double t0 = now_sec();
+        bench->fn(in);
+        const double elapsed = now_sec() - t0;
+        if ((best < 0.0) || (elapsed < best)) {
+            best = elapsed;
+        }
+    } while ((now_sec() - start) < min_time);
+
+    const double num_points = (double) ((bench->num_points > 0U) ? bench->num_points : NUM_POINTS);
+    Result result;
+    result.name = bench->name;
+    result.inputs = in->name;
+    result.ns_per_eval = (best * 1e9) / num_points;
+    result.evals_per_sec = (best > 0.0) ? (num_points / best) : 0.0;
+    return result;
+}
+
+static void write_json(FILE *const out, const Result *const results, const size_t num_results) {
+    fprintf(out, "{\n");
+    fprintf(out, "  \"library\": \"magneto\",\n");
+    fprintf(out, "  \"precision\": \"%s\",\n", (sizeof(real) == sizeof(float)) ? "single" : "double");
+    fprintf(out, "  \"points_per_pass\": %u,\n", NUM_POINTS);
+    fprintf(out, "  \"results\": [\n");
+    for (size_t i = 0U; i < num_results; ++i) {
+        fprintf(
+            out,
+            "    { \"name\": \"%s\", \"inputs\": \"%s\", \"ns_per_eval\": %.3f, \"evals_per_sec\": %.1f }%s\n",
+            results[i].name, results[i].inputs, results[i].ns_per_eval, results[i].evals_per_sec,
+            ((i + 1U) < num_results) ? "," : ""
+        );
+    }
+    fprintf(out, "  ]\n");
+    fprintf(out, "}\n");
+}
+
+static void print_usage(const char *const prog) {
+    fprintf(stderr, "Usage: %s [--min-time SECONDS] [--filter SUBSTRING] [--output FILE]\n", prog);
+}
+
+int main(const int argc, const char *const argv[]) {
+    double min_time = 0.2;
+    const char *filter = NULL;
+    const char *output = NULL;
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = ((i + 1) < argc);
+        if ((strcmp(argv[i], "--min-time") == 0) && has_value) {
+            min_time = atof(argv[++i]);
+        } else if ((strcmp(argv[i], "--filter") == 0) && has_value) {
+            filter = argv[++i];
+        } else if ((strcmp(argv[i], "--output") == 0) && has_value) {
+            output = argv[++i];
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    static Inputs random_inputs;
+    static Inputs coherent_inputs;
+    gen_random_inputs(&random_inputs);
+    gen_coherent_inputs(&coherent_inputs);
+    const Inputs *const input_sets[] = { &random_inputs, &coherent_inputs };
+
+    static Result results[MAX_RESULTS];
+    size_t num_results = 0U;
+    for (size_t b = 0U; b < NUM_BENCHMARKS; ++b) {
+        if ((filter != NULL) && (strstr(BENCHMARKS[b].name, filter) == NULL)) {
+            continue;
+        }
+        for (size_t s = 0U; s < (sizeof(input_sets) / sizeof(input_sets[0])); ++s) {
+            if (num_results < MAX_RESULTS) {
+                results[num_results] = run_benchmark(&BENCHMARKS[b], input_sets[s], min_time);
+                fprintf(
+                    stderr, "%-40s %-9s %12.1f ns/eval\n",
+                    results[num_results].name, results[num_results].inputs, results[num_results].ns_per_eval
+                );
+                ++num_results;
+            }
+        }
+    }
+
+    FILE *const out = (output != NULL) ? fopen(output, "w") : stdout;
+    if (out == NULL) {
+        fprintf(stderr, "Could not open output file: %s\n", output);
+        return 1;
+    }
+    write_json(out, results, num_results);
+    if (out != stdout) {
+        fclose(out);
+    }
+    return 0;
+}
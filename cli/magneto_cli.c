@@ -0,0 +1,643 @@
+// Needed for pthreads
+#define _POSIX_C_SOURCE 200112L
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef MAGNETO_THREADS
+#include <pthread.h>
+#endif
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+#include "magneto/magneto.h"
+#include "magneto/model.h"
+#include "magneto/model_binary.h"
+#include "magneto/wmm.h"
+
+typedef magneto_real real;
+
+// Points per block, the unit handed between pipeline stages
+#define BLOCK_POINTS        (8192U)
+// Blocks in flight, so each stage can work on one while the others fill & drain the rest
+#define NUM_BLOCKS          (4U)
+// Longest CSV input line, excluding the newline
+#define MAX_LINE_LEN        (255U)
+// Bytes read from a stream at a time, when the input can't be mapped
+#define READ_CHUNK_SIZE     (1U << 20U)
+// Longest CSV output record, 7 fields of at most 23 characters & separators
+#define MAX_RECORD_LEN      (7U * 24U)
+// Decimal places of CSV output, well below model uncertainty
+#define NT_DECIMALS         (4U)
+#define DEG_DECIMALS        (6U)
+
+// Binary input records are {latitude, longitude, height, year} in native `magneto_real`
+#define INPUT_RECORD_SIZE   (4U * sizeof(real))
+
+typedef char check_record_fits[(sizeof(magneto_FieldState) <= MAX_RECORD_LEN) ? 1 : -1];
+
+typedef enum {
+    FORMAT_CSV,
+    FORMAT_BINARY
+} Format;
+
+// ---- Input ----
+
+/// Unread input, either a whole mapped file or a window of a stream refilled on demand
+typedef struct {
+    const char *data;
+    size_t size;
+    FILE *stream;               ///< `NULL` if the whole input is in `data`
+    char *buffer;               ///< `READ_CHUNK_SIZE` bytes, if streaming
+    size_t line;                ///< Lines or records consumed, for error messages
+} Source;
+
+/// Move any unread bytes to the start of the buffer & read more after them,
+/// returns false if nothing more could be read
+static bool source_refill(Source *const src) {
+    if ((src->stream == NULL) || (src->size >= READ_CHUNK_SIZE)) {
+        return false;
+    }
+    memmove(src->buffer, src->data, src->size);
+    const size_t len = fread(&src->buffer[src->size], 1U, READ_CHUNK_SIZE - src->size, src->stream);
+    src->data = src->buffer;
+    src->size += len;
+    return len > 0U;
+}
+
+static void source_consume(Source *const src, const size_t len) {
+    src->data += len;
+    src->size -= len;
+    ++src->line;
+}
+
+// ---- Blocks ----
+
+typedef enum {
+    BLOCK_EMPTY,
+    BLOCK_PARSED,
+    BLOCK_EVALUATED
+} BlockStage;
+
+typedef struct {
+    BlockStage stage;
+    bool is_last;               ///< No blocks follow this one
+    size_t count;
+    real latitude[BLOCK_POINTS];
+    real longitude[BLOCK_POINTS];
+    real height[BLOCK_POINTS];
+    magneto_DecYear time[BLOCK_POINTS];
+    real B_ned[3][BLOCK_POINTS];
+    real F[BLOCK_POINTS];
+    real H[BLOCK_POINTS];
+    real D[BLOCK_POINTS];
+    real I[BLOCK_POINTS];
+    size_t out_len;
+    char out[BLOCK_POINTS * MAX_RECORD_LEN];
+} Block;
+
+typedef enum {
+    PARSE_OK,                   ///< Block is full
+    PARSE_END,                  ///< Input ran out, block may be partially full
+    PARSE_ERROR
+} ParseStatus;
+
+static bool is_blank(const char *s) {
+    while ((*s == ' ') || (*s == '\t') || (*s == '\r')) {
+        ++s;
+    }
+    return *s == '\0';
+}
+
+/// Parse a number like `strtod`, but much faster for plain decimals of at most 15 digits
+///
+/// Their digits & power of 10 are exact doubles, so a single division rounds correctly & the
+/// result matches `strtod`. Anything else, e.g. with an exponent, falls back to it.
+static double parse_number(const char *const s, const char **const end) {
+    static const double POW10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15
+    };
+    const char *p = s;
+    while ((*p == ' ') || (*p == '\t')) {
+        ++p;
+    }
+    const bool is_negative = (*p == '-');
+    p += ((*p == '-') || (*p == '+')) ? 1 : 0;
+    uint64_t digits = 0U;
+    size_t num_digits = 0U;
+    size_t num_decimals = 0U;
+    for (; (*p >= '0') && (*p <= '9'); ++p, ++num_digits) {
+        digits = (digits * 10U) + (uint64_t) (*p - '0');
+    }
+    if (*p == '.') {
+        for (++p; (*p >= '0') && (*p <= '9'); ++p, ++num_digits, ++num_decimals) {
+            digits = (digits * 10U) + (uint64_t) (*p - '0');
+        }
+    }
+    if ((num_digits == 0U) || (num_digits > 15U) || (*p == 'e') || (*p == 'E')) {
+        char *strtod_end = NULL;
+        const double value = strtod(s, &strtod_end);
+        *end = strtod_end;
+        return value;
+    }
+    *end = p;
+    const double value = (double) digits / POW10[num_decimals];
+    return is_negative ? -value : value;
+}
+
+/// Parse "latitude,longitude,height,year" into the next point of `block`, where blank &
+/// '#' comment lines are skipped. Returns false if the line is invalid.
+static bool parse_csv_line(const char *const line, const size_t len, Block *const block) {
+    char text[MAX_LINE_LEN + 1U];
+    if (len > MAX_LINE_LEN) {
+        return false;
+    }
+    memcpy(text, line, len);
+    text[len] = '\0';
+    const char *pos = text;
+    while ((*pos == ' ') || (*pos == '\t')) {
+        ++pos;
+    }
+    if (is_blank(pos) || (*pos == '#')) {
+        return true;
+    }
+
+    double values[4];
+    for (size_t i = 0U; i < 4U; ++i) {
+        const char *end = NULL;
+        values[i] = parse_number(pos, &end);
+        if (end == pos) {
+            return false;
+        }
+        pos = end;
+        if (i < 3U) {
+            if (*pos != ',') {
+                return false;
+            }
+            ++pos;
+        }
+    }
+    if (!is_blank(pos)) {
+        return false;
+    }
+
+    const size_t i = block->count++;
+    block->latitude[i] = (real) values[0];
+    block->longitude[i] = (real) values[1];
+    block->height[i] = (real) values[2];
+    block->time[i].year = (real) values[3];
+    return true;
+}
+
+static ParseStatus parse_csv_block(Source *const src, Block *const block) {
+    while (block->count < BLOCK_POINTS) {
+        const char *newline = (const char *) memchr(src->data, '\n', src->size);
+        size_t len = 0U;
+        if (newline != NULL) {
+            len = (size_t) (newline - src->data);
+        } else if (source_refill(src)) {
+            continue;
+        } else if (src->size == 0U) {
+            return PARSE_END;
+        } else if ((src->stream != NULL) && (src->size >= READ_CHUNK_SIZE)) {
+            // A full buffer without a newline
+            ++src->line;
+            return PARSE_ERROR;
+        } else {
+            // Last line, without a trailing newline
+            len = src->size;
+        }
+        const bool is_valid = parse_csv_line(src->data, len, block);
+        source_consume(src, (newline != NULL) ? (len + 1U) : len);
+        if (!is_valid) {
+            return PARSE_ERROR;
+        }
+    }
+    return PARSE_OK;
+}
+
+static ParseStatus parse_binary_block(Source *const src, Block *const block) {
+    while (block->count < BLOCK_POINTS) {
+        if ((src->size < INPUT_RECORD_SIZE) && !source_refill(src)) {
+            if (src->size == 0U) {
+                return PARSE_END;
+            }
+            // Truncated last record
+            ++src->line;
+            return PARSE_ERROR;
+        }
+        if (src->size < INPUT_RECORD_SIZE) {
+            continue;
+        }
+        real record[4];
+        memcpy(record, src->data, INPUT_RECORD_SIZE);
+        source_consume(src, INPUT_RECORD_SIZE);
+        const size_t i = block->count++;
+        block->latitude[i] = record[0];
+        block->longitude[i] = record[1];
+        block->height[i] = record[2];
+        block->time[i].year = record[3];
+    }
+    return PARSE_OK;
+}
+
+/// Write `x` rounded to `decimals` places into `out`, returns the length written
+///
+/// Far faster than `snprintf`, which would otherwise bound the whole pipeline.
+/// Values too large to round exactly fall back to it, so every field fits in 23 characters.
+static size_t format_fixed(char *const out, const double x, const size_t decimals) {
+    static const double POW10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6 };
+    const double scaled = fabs(x) * POW10[decimals];
+    if (!(scaled < 1e15)) {
+        const int n = snprintf(out, 24U, "%.9g", x);
+        return (n > 0) ? (size_t) n : 0U;
+    }
+    const uint64_t rounded = (uint64_t) (scaled + 0.5);
+    uint64_t value = rounded;
+    char digits[24];
+    size_t num_digits = 0U;
+    do {
+        digits[num_digits++] = (char) ('0' + (value % 10U));
+        value /= 10U;
+    } while ((value > 0U) || (num_digits <= decimals));
+
+    size_t len = 0U;
+    if ((x < 0) && (rounded > 0U)) {
+        out[len++] = '-';
+    }
+    for (size_t i = num_digits; i-- > 0U;) {
+        out[len++] = digits[i];
+        if ((i == decimals) && (decimals > 0U)) {
+            out[len++] = '.';
+        }
+    }
+    return len;
+}
+
+/// Evaluate every point of a parsed block as one batch & encode the results into `out`
+static void eval_block(const magneto_Model *const model, const Format format, Block *const block) {
+    const magneto_CoordsBatch in = { block->latitude, block->longitude, block->height, block->time };
+    const magneto_FieldStateBatch out = {
+        { block->B_ned[0], block->B_ned[1], block->B_ned[2] },
+        block->F, block->H, block->D, block->I
+    };
+    eval_field_batch(model, block->count, &in, &out);
+
+    size_t len = 0U;
+    for (size_t i = 0U; i < block->count; ++i) {
+        if (format == FORMAT_BINARY) {
+            const magneto_FieldState state = {
+                { block->B_ned[0][i], block->B_ned[1][i], block->B_ned[2][i] },
+                block->F[i], block->H[i], block->D[i], block->I[i]
+            };
+            memcpy(&block->out[len], &state, sizeof(state));
+            len += sizeof(state);
+        } else {
+            const real fields[7] = {
+                block->B_ned[0][i], block->B_ned[1][i], block->B_ned[2][i],
+                block->F[i], block->H[i], block->D[i], block->I[i]
+            };
+            for (size_t k = 0U; k < 7U; ++k) {
+                len += format_fixed(&block->out[len], (double) fields[k], (k < 5U) ? NT_DECIMALS : DEG_DECIMALS);
+                block->out[len++] = (k < 6U) ? ',' : '\n';
+            }
+        }
+    }
+    block->out_len = len;
+}
+
+// ---- Pipeline ----
+
+typedef struct {
+    const magneto_Model *model;
+    Format input_format;
+    Format output_format;
+    Source *src;
+    FILE *out;
+    Block *blocks;
+    bool is_parse_error;
+    bool is_write_error;
+#ifdef MAGNETO_THREADS
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+#endif
+} Pipeline;
+
+/// Fill `block` from the input, returns false once it is the last block
+static bool run_parse_stage(Pipeline *const pipe, Block *const block) {
+    block->count = 0U;
+    const ParseStatus status = (pipe->input_format == FORMAT_BINARY)
+        ? parse_binary_block(pipe->src, block)
+        : parse_csv_block(pipe->src, block);
+    pipe->is_parse_error = (status == PARSE_ERROR);
+    block->is_last = (status != PARSE_OK);
+    return !block->is_last;
+}
+
+/// Write an evaluated block, skipping any after a failed write. Returns false if it failed.
+static bool run_write_stage(const Pipeline *const pipe, const Block *const block) {
+    if (pipe->is_write_error || (block->out_len == 0U)) {
+        return !pipe->is_write_error;
+    }
+    return fwrite(block->out, 1U, block->out_len, pipe->out) == block->out_len;
+}
+
+#ifdef MAGNETO_THREADS
+
+/// Wait until `block` reaches `stage`, blocks move through stages in a ring
+static void wait_for_stage(Pipeline *const pipe, const Block *const block, const BlockStage stage) {
+    pthread_mutex_lock(&pipe->lock);
+    while (block->stage != stage) {
+        pthread_cond_wait(&pipe->changed, &pipe->lock);
+    }
+    pthread_mutex_unlock(&pipe->lock);
+}
+
+static void set_stage(Pipeline *const pipe, Block *const block, const BlockStage stage) {
+    pthread_mutex_lock(&pipe->lock);
+    block->stage = stage;
+    pthread_cond_broadcast(&pipe->changed);
+    pthread_mutex_unlock(&pipe->lock);
+}
+
+static void *eval_thread_main(void *const arg) {
+    Pipeline *const pipe = (Pipeline *) arg;
+    for (size_t i = 0U;; i = (i + 1U) % NUM_BLOCKS) {
+        Block *const block = &pipe->blocks[i];
+        wait_for_stage(pipe, block, BLOCK_PARSED);
+        eval_block(pipe->model, pipe->output_format, block);
+        const bool is_last = block->is_last;
+        set_stage(pipe, block, BLOCK_EVALUATED);
+        if (is_last) {
+            return NULL;
+        }
+    }
+}
+
+static void *write_thread_main(void *const arg) {
+    Pipeline *const pipe = (Pipeline *) arg;
+    for (size_t i = 0U;; i = (i + 1U) % NUM_BLOCKS) {
+        Block *const block = &pipe->blocks[i];
+        wait_for_stage(pipe, block, BLOCK_EVALUATED);
+        const bool is_written = run_write_stage(pipe, block);
+        const bool is_last = block->is_last;
+        // Error is read by the parse thread, so only set it under the lock
+        pthread_mutex_lock(&pipe->lock);
+        pipe->is_write_error = !is_written;
+        block->stage = BLOCK_EMPTY;
+        pthread_cond_broadcast(&pipe->changed);
+        pthread_mutex_unlock(&pipe->lock);
+        if (is_last) {
+            return NULL;
+        }
+    }
+}
+
+/// Parse on the calling thread, while evaluating & writing on their own threads.
+/// Returns false if the threads couldn't be started, before anything was consumed.
+static bool run_pipelined(Pipeline *const pipe) {
+    if ((pthread_mutex_init(&pipe->lock, NULL) != 0) || (pthread_cond_init(&pipe->changed, NULL) != 0)) {
+        return false;
+    }
+    pthread_t eval_thread;
+    pthread_t write_thread;
+    if (pthread_create(&eval_thread, NULL, eval_thread_main, pipe) != 0) {
+        return false;
+    }
+    if (pthread_create(&write_thread, NULL, write_thread_main, pipe) != 0) {
+        // Let the evaluation thread finish on an empty last block
+        pipe->blocks[0].count = 0U;
+        pipe->blocks[0].is_last = true;
+        set_stage(pipe, &pipe->blocks[0], BLOCK_PARSED);
+        pthread_join(eval_thread, NULL);
+        pipe->blocks[0].stage = BLOCK_EMPTY;
+        return false;
+    }
+
+    for (size_t i = 0U;; i = (i + 1U) % NUM_BLOCKS) {
+        Block *const block = &pipe->blocks[i];
+        wait_for_stage(pipe, block, BLOCK_EMPTY);
+        // Stop early once output has failed, the write thread drains what's in flight
+        pthread_mutex_lock(&pipe->lock);
+        const bool is_write_error = pipe->is_write_error;
+        pthread_mutex_unlock(&pipe->lock);
+        bool has_more = false;
+        if (is_write_error) {
+            block->count = 0U;
+            block->is_last = true;
+        } else {
+            has_more = run_parse_stage(pipe, block);
+        }
+        set_stage(pipe, block, BLOCK_PARSED);
+        if (!has_more) {
+            break;
+        }
+    }
+    pthread_join(eval_thread, NULL);
+    pthread_join(write_thread, NULL);
+    pthread_cond_destroy(&pipe->changed);
+    pthread_mutex_destroy(&pipe->lock);
+    return true;
+}
+
+#endif  // MAGNETO_THREADS
+
+/// Run every stage in turn on the calling thread, with a single block
+static void run_serial(Pipeline *const pipe) {
+    Block *const block = &pipe->blocks[0];
+    bool has_more = true;
+    while (has_more && !pipe->is_write_error) {
+        has_more = run_parse_stage(pipe, block);
+        eval_block(pipe->model, pipe->output_format, block);
+        pipe->is_write_error = !run_write_stage(pipe, block);
+    }
+}
+
+// ---- Main ----
+
+static bool parse_format(const char *const name, Format *const format) {
+    if (strcmp(name, "csv") == 0) {
+        *format = FORMAT_CSV;
+    } else if (strcmp(name, "binary") == 0) {
+        *format = FORMAT_BINARY;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static void print_usage(const char *const prog) {
+    fprintf(
+        stderr,
+        "Usage: %s [--model FILE] [--input-format csv|binary] [--output-format csv|binary]\n"
+        "          [--output FILE] [--serial] [INPUT]\n"
+        "\n"
+        "Evaluates the field at every point of INPUT, or stdin if absent or '-', in order.\n"
+        "  csv input      lines of 'latitude,longitude,height,year' in deg, deg, m & decimal\n"
+        "                 years, blank lines & lines starting with '#' are skipped\n"
+        "  binary input   packed records of 4 native magneto_real with the same fields\n"
+        "  csv output     lines of 'B_n,B_e,B_d,F,H,D,I' in nT & deg, to 4 & 6 decimals\n"
+        "  binary output  packed native magneto_FieldState records\n"
+        "  --model        binary model written by tools/gen_coeffs.py, default WMM2020\n"
+        "  --serial       parse, evaluate & write on one thread\n",
+        prog
+    );
+}
+
+/// View the binary model file at `path`, if any, with sub-models in `*models` to be freed by the caller
+static magneto_Model load_model(const char *const path, magneto_ModelFile *const file, magneto_ModelCoeffs **const models) {
+    const magneto_Model invalid = { 0 };
+    if (path == NULL) {
+        return invalid;
+    }
+    *file = magneto_ModelFile_open(path);
+    if (file->size < sizeof(magneto_ModelBinaryHeader)) {
+        return invalid;
+    }
+    magneto_ModelBinaryHeader header;
+    memcpy(&header, file->data, sizeof(header));
+    // Every sub-model's coefficients must fit in the file, which bounds the allocation below
+    const uint64_t model_size = (uint64_t) header.num_model_coeffs * sizeof(magneto_SphericalHarmonicCoeff);
+    if ((header.magic != MAGNETO_MODEL_BINARY_MAGIC) || (header.version != MAGNETO_MODEL_BINARY_VERSION)) {
+        return invalid;
+    }
+    if ((header.num_models == 0U) || (model_size == 0U) || (header.num_models > ((uint64_t) file->size / model_size))) {
+        return invalid;
+    }
+    *models = (magneto_ModelCoeffs *) calloc(header.num_models, sizeof(magneto_ModelCoeffs));
+    if (*models == NULL) {
+        return invalid;
+    }
+    return magneto_Model_from_binary(file->data, file->size, *models, header.num_models);
+}
+
+int main(const int argc, const char *const argv[]) {
+    const char *model_path = NULL;
+    const char *input_path = NULL;
+    const char *output_path = NULL;
+    Format input_format = FORMAT_CSV;
+    Format output_format = FORMAT_CSV;
+    bool is_serial = false;
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = ((i + 1) < argc);
+        if ((strcmp(argv[i], "--model") == 0) && has_value) {
+            model_path = argv[++i];
+        } else if ((strcmp(argv[i], "--input-format") == 0) && has_value && parse_format(argv[i + 1], &input_format)) {
+            ++i;
+        } else if ((strcmp(argv[i], "--output-format") == 0) && has_value && parse_format(argv[i + 1], &output_format)) {
+            ++i;
+        } else if ((strcmp(argv[i], "--output") == 0) && has_value) {
+            output_path = argv[++i];
+        } else if (strcmp(argv[i], "--serial") == 0) {
+            is_serial = true;
+        } else if ((input_path == NULL) && ((argv[i][0] != '-') || (strcmp(argv[i], "-") == 0))) {
+            input_path = argv[i];
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    magneto_ModelFile model_file = { NULL, 0U };
+    magneto_ModelCoeffs *models = NULL;
+    const magneto_Model loaded = load_model(model_path, &model_file, &models);
+    const magneto_Model *const model = (model_path != NULL) ? &loaded : &magneto_MODEL_WMM2020;
+    if (model_path != NULL) {
+        if (loaded.nm_max == 0U) {
+            fprintf(stderr, "Could not load model: %s\n", model_path);
+            free(models);
+            magneto_ModelFile_close(&model_file);
+            return 1;
+        }
+    }
+
+    // Map the input if possible, otherwise stream it through a buffer
+    Source src = { NULL, 0U, NULL, NULL, 0U };
+    magneto_ModelFile input_file = { NULL, 0U };
+    FILE *input_stream = NULL;
+    const bool is_stdin = (input_path == NULL) || (strcmp(input_path, "-") == 0);
+    if (!is_stdin) {
+        input_file = magneto_ModelFile_open(input_path);
+    }
+    if (input_file.data != NULL) {
+        src.data = (const char *) input_file.data;
+        src.size = input_file.size;
+    } else {
+#ifdef _WIN32
+        // Standard streams translate line endings on Windows, which would corrupt binary records
+        if (is_stdin && (input_format == FORMAT_BINARY)) {
+            (void) _setmode(_fileno(stdin), _O_BINARY);
+        }
+#endif
+        input_stream = is_stdin ? stdin : fopen(input_path, "rb");
+        src.buffer = (char *) malloc(READ_CHUNK_SIZE);
+        src.stream = input_stream;
+        src.data = src.buffer;
+    }
+#ifdef _WIN32
+    if ((output_path == NULL) && (output_format == FORMAT_BINARY)) {
+        (void) _setmode(_fileno(stdout), _O_BINARY);
+    }
+#endif
+    FILE *const out = (output_path != NULL) ? fopen(output_path, "wb") : stdout;
+    Block *const blocks = (Block *) calloc(NUM_BLOCKS, sizeof(Block));
+
+    int status = 0;
+    if ((input_file.data == NULL) && ((input_stream == NULL) || (src.buffer == NULL))) {
+        fprintf(stderr, "Could not read input: %s\n", is_stdin ? "stdin" : input_path);
+        status = 1;
+    } else if (out == NULL) {
+        fprintf(stderr, "Could not open output file: %s\n", output_path);
+        status = 1;
+    } else if (blocks == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        status = 1;
+    } else {
+        Pipeline pipe;
+        memset(&pipe, 0, sizeof(pipe));
+        pipe.model = model;
+        pipe.input_format = input_format;
+        pipe.output_format = output_format;
+        pipe.src = &src;
+        pipe.out = out;
+        pipe.blocks = blocks;
+        bool is_done = false;
+#ifdef MAGNETO_THREADS
+        is_done = !is_serial && run_pipelined(&pipe);
+#else
+        (void) is_serial;
+#endif
+        if (!is_done) {
+            run_serial(&pipe);
+        }
+        if (pipe.is_parse_error) {
+            fprintf(stderr, "Invalid input at %s %zu\n", (input_format == FORMAT_CSV) ? "line" : "record", src.line);
+            status = 1;
+        }
+        if (pipe.is_write_error || (fflush(out) != 0)) {
+            fprintf(stderr, "Could not write output\n");
+            status = 1;
+        }
+    }
+
+    if ((out != NULL) && (out != stdout)) {
+        fclose(out);
+    }
+    if ((input_stream != NULL) && (input_stream != stdin)) {
+        fclose(input_stream);
+    }
+    free(blocks);
+    free(src.buffer);
+    magneto_ModelFile_close(&input_file);
+    free(models);
+    magneto_ModelFile_close(&model_file);
+    return status;
+}
@@ -0,0 +1,142 @@
+#ifndef MAGNETO_CACHE_H
+#define MAGNETO_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "magneto.h"
+#include "model.h"
+
+/// Identifies a field cache buffer, "MGFC" in little-endian
+#define MAGNETO_FIELD_CACHE_MAGIC   (0x4346474DUL)
+#define MAGNETO_FIELD_CACHE_VERSION (1U)
+
+/// Start of a flat, pointer-free field cache buffer, immediately followed by its nodes
+///
+/// The whole buffer can be copied or placed in read-only memory as-is, but is only
+/// valid for the same `magneto_real` precision and endianness it was built with.
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t real_size;             ///< `sizeof(magneto_real)` it was built with
+    uint32_t num_nodes;
+    uint32_t depth;                 ///< Deepest level of any leaf, root is level 0
+    magneto_Coords min;             ///< Lower corner of the cached region
+    magneto_Coords max;             ///< Upper corner of the cached region
+    magneto_DecYear t;              ///< Time the field is cached at
+    magneto_real tolerance;         ///< [nT] Requested interpolation tolerance
+    magneto_real max_error;         ///< [nT] Largest interpolation error sampled in any leaf
+} magneto_FieldCacheHeader;
+
+/// Node of the octree, either with 8 children or a leaf with field values at its corners
+typedef struct {
+    uint32_t first_child;           ///< Index of first of 8 consecutive children, 0 for leaves
+    uint32_t reserved;
+    magneto_real B_ned[8][3];       ///< [nT] Corners of leaves, indexed by bits (lat, lon, height)
+} magneto_FieldCacheNode;
+
+/// Size of a field cache buffer holding `num_nodes` nodes
+#define MAGNETO_FIELD_CACHE_SIZE(num_nodes) \
+    (sizeof(magneto_FieldCacheHeader) + ((num_nodes) * sizeof(magneto_FieldCacheNode)))
+
+/// Build an octree cache of B_ned for the box between `min` and `max` at time `t`
+///
+/// Each box is subdivided into 8 until trilinear interpolation of its corners is within
+/// `tolerance` of `eval_field` at the 19 other points of its 3x3x3 lattice (face & edge
+/// midpoints & centre), or it reaches `max_depth`. The largest of those sampled errors over
+/// all leaves is stored as `max_error`, which can exceed `tolerance` only if `max_depth` was
+/// reached. It isn't a bound, errors between the samples can be larger where the field curves
+/// sharply within a leaf.
+/// The box may not cross the antimeridian.
+///
+/// The `buffer` must be aligned for `magneto_real`. Returns the number of bytes used,
+/// or 0 if any input is invalid or `buffer_size` is too small.
+size_t magneto_FieldCache_build(
+    const magneto_Model *model,
+    magneto_DecYear t,
+    magneto_Coords min,
+    magneto_Coords max,
+    magneto_real tolerance,
+    size_t max_depth,
+    void *buffer,
+    size_t buffer_size
+);
+
+/// Check that a buffer holds a valid cache built with the same precision, whose nodes
+/// all lead to leaves within it
+bool magneto_FieldCache_is_valid(const magneto_FieldCacheHeader *cache, size_t buffer_size);
+
+/// Look up B_ned by trilinear interpolation in O(depth), assumes a valid cache
+///
+/// Returns false if `coords` is outside the cached region.
+bool magneto_FieldCache_lookup(
+    const magneto_FieldCacheHeader *cache,
+    magneto_Coords coords,
+    magneto_real *B_ned
+);
+
+/// Quantization steps of a result cache, each coordinate is rounded to the nearest multiple
+/// of its step. A step of 0 only matches that coordinate exactly.
+typedef struct {
+    magneto_real latitude;          ///< [deg]
+    magneto_real longitude;         ///< [deg]
+    magneto_real height;            ///< [m]
+    magneto_real time;              ///< [year]
+} magneto_ResultCacheSteps;
+
+/// Entry of a result cache, guarded by a sequence lock so it can be read & replaced concurrently
+typedef struct {
+    size_t sequence;                ///< Odd while being written, 0 if never written
+    int64_t key[4];                 ///< Quantized latitude, longitude, height & time
+    magneto_FieldState state;
+} magneto_ResultCacheSlot;
+
+typedef struct {
+    size_t hits;                    ///< Lookups answered from the cache
+    size_t misses;                  ///< Lookups evaluated with `eval_field`
+} magneto_ResultCacheStats;
+
+/// Start of a result cache block, immediately followed by its slots
+typedef struct {
+    const magneto_Model *model;
+    magneto_ResultCacheSteps steps;
+    size_t num_slots;               ///< Power of 2
+    magneto_ResultCacheStats stats; ///< Updated atomically, read with `magneto_ResultCache_stats`
+} magneto_ResultCache;
+
+/// Size of a result cache block holding `num_slots` slots
+#define MAGNETO_RESULT_CACHE_SIZE(num_slots) \
+    (sizeof(magneto_ResultCache) + ((num_slots) * sizeof(magneto_ResultCacheSlot)))
+
+/// Set up a cache of `eval_field` results in a caller-provided `buffer`, for repeated queries
+/// from fixed sites
+///
+/// The cache has as many slots as fit, rounded down to a power of 2, in 4-way buckets, and
+/// a query colliding with a full bucket replaces one of its entries. The `buffer` must be aligned for `int64_t`
+/// & not be used by anything else while the cache is. Returns `NULL` if any input is
+/// invalid or `buffer_size` is too small for a single slot.
+magneto_ResultCache *magneto_ResultCache_init(
+    const magneto_Model *model,
+    magneto_ResultCacheSteps steps,
+    void *buffer,
+    size_t buffer_size
+);
+
+/// Same as `eval_field`, but evaluated at the nearest point of the quantization lattice
+/// & cached
+///
+/// Results are the same whether they hit or not, so only depend on the quantized query.
+/// Any number of threads may share a cache without locking, each slot is a sequence lock
+/// that readers retry as a miss if it changes under them, & writers skip if it is being
+/// written already. Coordinates too far from the lattice origin to quantize are evaluated
+/// directly & counted as misses. Requires GCC, Clang or MSVC atomics to share between threads.
+magneto_FieldState eval_field_cached(
+    magneto_ResultCache *cache,
+    magneto_DecYear t,
+    magneto_Coords coords
+);
+
+/// Read the hit & miss counters of a cache, which may be updated concurrently
+magneto_ResultCacheStats magneto_ResultCache_stats(const magneto_ResultCache *cache);
+
+#endif  // MAGNETO_CACHE_H
@@ -1,9 +1,12 @@
 #ifndef MAGNETO_MAGNETO_H
 #define MAGNETO_MAGNETO_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "precision.h"
+
 // Default is double-precision if not defined
 #ifdef MAGNETO_SINGLE_PRECISION
 typedef float magneto_real;
@@ -25,6 +28,8 @@ extern const magneto_real magneto_WGS84_F;
 extern const magneto_real magneto_WGS84_F_INV;
 /// [ ] Eccentricity squared (e^2) of the WGS84 ellipsoid
 extern const magneto_real magneto_WGS84_E_SQ;
+/// [m] Geomagnetic reference radius (mean Earth radius) used by WMM & IGRF
+extern const magneto_real magneto_GEOMAG_REF_RADIUS;
 
 // Time
 
@@ -42,6 +47,15 @@ typedef struct {
     uint8_t sec;    ///< [sec]      Second in [0, 60)
 } magneto_DateTime;
 
+/// Bounds of the last year a timestamp fell in, so conversions of monotonic streams skip
+/// the calendar math. Zero-initialize before first use.
+typedef struct {
+    double start;               ///< [s] Unix time of January 1st
+    double end;                 ///< [s] Unix time of the next January 1st
+    double year;                ///< [year] Integer Gregorian year
+    double inv_length;          ///< [1/s] Inverse of the length of the year
+} magneto_YearCache;
+
 // Position
 
 /// Earth-centered geographic coordinates (geodetic)
@@ -58,6 +72,15 @@ typedef struct {
     magneto_real radius;        ///< [m]    Distance from centre of WGS84 ellipsoid
 } magneto_SphericalCoords;
 
+/// Geocentric position of a geodetic point, with the rotation between their local frames
+typedef struct {
+    magneto_SphericalCoords spherical;
+    magneto_real sin_polar;     ///< Sine of the geocentric latitude
+    magneto_real cos_polar;     ///< Cosine of the geocentric latitude
+    magneto_real sin_eps;       ///< Sine of geodetic minus geocentric latitude
+    magneto_real cos_eps;       ///< Cosine of geodetic minus geocentric latitude
+} magneto_GeocentricFrame;
+
 /// Earth-centered cartesian coordinates (TODO: Define axes)
 typedef struct {
     magneto_real x;
@@ -75,6 +98,15 @@ typedef struct {
     magneto_real I;
 } magneto_FieldState;
 
+/// Rate of change of each field quantity, also known as the secular variation
+typedef struct {
+    magneto_real B_ned[3];      ///< [nT/year]
+    magneto_real F;             ///< [nT/year]
+    magneto_real H;             ///< [nT/year]
+    magneto_real D;             ///< [deg/year]
+    magneto_real I;             ///< [deg/year]
+} magneto_FieldRates;
+
 // Math
 
 /// Convert radians to degrees
@@ -88,6 +120,21 @@ bool magneto_DateTime_is_valid(magneto_DateTime t);
 bool magneto_DecYear_is_valid(magneto_DecYear t);
 
 magneto_DecYear magneto_DecYear_from_date_time(magneto_DateTime t);
+/// Convert seconds since the Unix epoch (1970-01-01 00:00:00 UTC) in O(1)
+///
+/// Like Unix time itself, leap seconds are ignored so every day is 86400 s long.
+/// Returns a zero year if the result would be invalid.
+magneto_DecYear magneto_DecYear_from_unix(double seconds);
+/// Same as `magneto_DecYear_from_unix`, but only redoing the calendar math when `seconds`
+/// leaves the year of the previous call with the same `cache`
+magneto_DecYear magneto_DecYear_from_unix_cached(magneto_YearCache *cache, double seconds);
+/// Convert a GPS week since 1980-01-06 (not wrapped at 1024) & seconds of that week
+///
+/// GPS time runs ahead of UTC by the leap seconds since 1980 (18 s as of 2017), which is
+/// ignored as it's far below the time resolution of any model.
+magneto_DecYear magneto_DecYear_from_gps(uint32_t week, double seconds);
+/// Convert `count` Unix times, vectorized for runs of timestamps within the same year
+void magneto_DecYear_from_unix_batch(size_t count, const double *seconds, magneto_DecYear *out);
 // magneto_DateTime magneto_DateTime_from_dec_year(magneto_DecYear t);  TODO: Do we need this?
 
 // Position conversions
@@ -95,15 +142,51 @@ magneto_DecYear magneto_DecYear_from_date_time(magneto_DateTime t);
 magneto_Coords magneto_Coords_from_spherical(magneto_SphericalCoords pos);
 magneto_Coords magneto_Coords_from_ecef(magneto_EcefPosition pos);
 
+/// Same as `magneto_Coords_from_ecef`, but faster & more accurate at any distance from the centre
+///
+/// Non-iterative closed form (Vermeille, 2011) rearranged to avoid cancellation, so rounding
+/// is the only error. In double-precision, that's a few ULPs of the distance from the centre,
+/// well below a millimetre anywhere from the centre out past lunar distance, poles included.
+/// Positions within ~43 km of the centre, which have several geodetic solutions, take the
+/// one with the nearest surface point.
+magneto_Coords magneto_Coords_from_ecef_fast(magneto_EcefPosition pos);
+/// Structure-of-arrays batch of `magneto_Coords_from_ecef_fast`, each array has length `count`
+void magneto_Coords_from_ecef_fast_batch(
+    size_t count,
+    const magneto_real *x,
+    const magneto_real *y,
+    const magneto_real *z,
+    magneto_real *latitude,
+    magneto_real *longitude,
+    magneto_real *height
+);
+
 magneto_SphericalCoords magneto_SphericalCoords_from_coords(magneto_Coords pos);
 magneto_SphericalCoords magneto_SphericalCoords_from_ecef(magneto_EcefPosition pos);
 
 magneto_EcefPosition magneto_EcefPosition_from_coords(magneto_Coords pos);
 magneto_EcefPosition magneto_EcefPosition_from_spherical(magneto_SphericalCoords pos);
 
+/// Same as `magneto_SphericalCoords_from_coords`, but in closed form without going through ECEF,
+/// and also returns the sine & cosine of the geocentric latitude & of the rotation angle to NED
+magneto_GeocentricFrame magneto_GeocentricFrame_from_coords(magneto_Coords pos);
+
+// Batched position conversions, each converts `count` points from `in` into `out`
+
+void magneto_Coords_from_spherical_batch(size_t count, const magneto_SphericalCoords *in, magneto_Coords *out);
+void magneto_Coords_from_ecef_batch(size_t count, const magneto_EcefPosition *in, magneto_Coords *out);
+void magneto_SphericalCoords_from_coords_batch(size_t count, const magneto_Coords *in, magneto_SphericalCoords *out);
+void magneto_SphericalCoords_from_ecef_batch(size_t count, const magneto_EcefPosition *in, magneto_SphericalCoords *out);
+void magneto_EcefPosition_from_coords_batch(size_t count, const magneto_Coords *in, magneto_EcefPosition *out);
+void magneto_EcefPosition_from_spherical_batch(size_t count, const magneto_SphericalCoords *in, magneto_EcefPosition *out);
+void magneto_GeocentricFrame_from_coords_batch(size_t count, const magneto_Coords *in, magneto_GeocentricFrame *out);
+
 // Magnetic field conversions
 
 magneto_FieldState magneto_FieldState_from_ned(const magneto_real *B_ned);
+/// Rates of every field quantity from the field & its rate of change, both in NED.
+/// Rates of D & I are zero where they're undefined, i.e. H or F is zero.
+magneto_FieldRates magneto_FieldRates_from_ned(const magneto_real *B_ned, const magneto_real *B_ned_dot);
 
 void magneto_convert_vector_ned_to_ecef(
     magneto_Coords pos,
@@ -117,4 +200,20 @@ void magneto_convert_vector_ecef_to_ned(
 );
 void magneto_matrix_ned_to_ecef(magneto_Coords pos, magneto_real *matrix);
 
+// Batched field conversions, vectors are `count` consecutive {x, y, z} triples
+
+void magneto_FieldState_from_ned_batch(size_t count, const magneto_real *B_ned, magneto_FieldState *out);
+void magneto_convert_vector_ned_to_ecef_batch(
+    size_t count,
+    const magneto_Coords *pos,
+    const magneto_real *ned,
+    magneto_real *ecef
+);
+void magneto_convert_vector_ecef_to_ned_batch(
+    size_t count,
+    const magneto_Coords *pos,
+    const magneto_real *ecef,
+    magneto_real *ned
+);
+
 #endif  // MAGNETO_MAGNETO_H
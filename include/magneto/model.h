@@ -6,26 +6,80 @@
 #include "magneto.h"
 
 #define MAGNETO_CALC_INDEX(n, m) (((n) * ((n) + 1) / 2) + (m) - 1)
+/// Index of term (n, m) in the order-major layout of a model of degree `nm_max`, where the
+/// degrees max(m, 1) to `nm_max` of each order are consecutive
+#define MAGNETO_CALC_ORDER_INDEX(n, m, nm_max) (((m) * ((2 * (nm_max)) + 1 - (m)) / 2) + (n) - 1)
 
 typedef struct {
     const magneto_real g;
     const magneto_real h;
 } magneto_SphericalHarmonicCoeff;
 
+/// Coefficients of term (n, m) of a sub-model & their rate of change, interleaved so a term is one load
 typedef struct {
-    // Length is `magneto_Model.num_model_coeffs`
-    const magneto_SphericalHarmonicCoeff *const coeffs;
+    const magneto_real g;
+    const magneto_real h;
+    const magneto_real g_dot;       ///< [nT/year] Towards the next sub-model, or the secular variation
+    const magneto_real h_dot;       ///< [nT/year] Towards the next sub-model, or the secular variation
+} magneto_SphericalHarmonicTerm;
+
+typedef struct {
+    // Length is `magneto_Model.num_model_coeffs`, not const so views can be filled at runtime
+    const magneto_SphericalHarmonicCoeff *coeffs;
 } magneto_ModelCoeffs;
 
+/// Constants of the Legendre recursion & summation for term (n, m), only depend on degree & order
+typedef struct {
+    const magneto_real K;           ///< Recursion constant K_{n,m}
+    const magneto_real n_plus_1;    ///< Radial multiplier (n + 1)
+    const magneto_real m;           ///< Longitudinal multiplier m
+} magneto_RecursionConsts;
+
+/// Square root of an integer & its reciprocal
+typedef struct {
+    const magneto_real root;        ///< sqrt(k)
+    const magneto_real inv_root;    ///< 1 / sqrt(k), or 0 for k = 0
+} magneto_SquareRoot;
+
+/// Normalization of the associated Legendre functions a model's coefficients are scaled for
+typedef enum {
+    /// Gauss normalized, coefficients pre-multiplied by the Schmidt factors, fastest up to degree ~100
+    magneto_NORMALIZATION_GAUSS = 0,
+    /// Schmidt semi-normalized as published, evaluated with a scaled recursion that stays
+    /// stable for high-degree models up to degree ~2000 (~150 in single-precision)
+    magneto_NORMALIZATION_SCHMIDT
+} magneto_Normalization;
+
+/// Spherical harmonic model, made up of a series of sub-models evenly spaced in time
+///
+/// The i-th sub-model has an epoch of `epoch + i * model_interval` and is linearly interpolated
+/// towards the next one, like IGRF. The last one is extrapolated with its secular variation.
 typedef struct {
-    const magneto_DecYear epoch;
+    const magneto_DecYear epoch;            ///< Epoch of the first sub-model
     const size_t nm_max;
     const size_t num_model_coeffs;
     const size_t num_models;
-    const magneto_DecYear model_interval;
+    const magneto_DecYear model_interval;   ///< Time between sub-models, must be positive if more than 1
     // Length is `num_models`
     const magneto_ModelCoeffs *const models;
     const magneto_ModelCoeffs last_secular;
+    // Length is `num_model_coeffs`, optional but avoids divisions when evaluating
+    const magneto_RecursionConsts *const recursion;
+    // Gauss if left out, Schmidt models don't use the recursion table
+    const magneto_Normalization normalization;
+    /// [nT] Optional bound on the field of each degree at the reference radius, indexed by degree
+    /// up to `nm_max`. Only needed for `eval_field_truncated`, and holds from the epoch to the end
+    /// of the last sub-model's interval.
+    const magneto_real *const degree_bounds;
+    /// Optional copy of every sub-model's coefficients & rates in the order the expansion sums
+    /// them, `num_models` consecutive arrays of `num_model_coeffs` terms indexed by
+    /// `MAGNETO_CALC_ORDER_INDEX`. Each order is then read sequentially, which matters most for
+    /// high-degree models whose degree-major tables are strided over many cache lines.
+    const magneto_SphericalHarmonicTerm *const terms;
+    /// Optional square roots of 0 to `2 * nm_max` & their reciprocals, indexed by the integer.
+    /// Only Schmidt models use them, whose recursion then factors each sqrt((n - m)(n + m)) into
+    /// two lookups instead of a square root & division per term.
+    const magneto_SquareRoot *const roots;
 } magneto_Model;
 
 magneto_FieldState eval_field(
@@ -34,4 +88,195 @@ magneto_FieldState eval_field(
     magneto_Coords coords
 );
 
+/// Same as `eval_field`, but also computes the secular variation into `rates`
+///
+/// The field & its rate of change share every Legendre, trig & radial term, so both
+/// are summed in a single pass over the coefficients, unlike finite differencing.
+magneto_FieldState eval_field_with_rates(
+    const magneto_Model *model,
+    magneto_DecYear t,
+    magneto_Coords coords,
+    magneto_FieldRates *rates
+);
+
+/// Spatial gradient of the field in NED w.r.t. geodetic coordinates
+typedef struct {
+    /// Derivative of `B_ned[i]` w.r.t. latitude, longitude & height for j = 0, 1 & 2,
+    /// in [nT/deg] for latitude & longitude and [nT/m] for height
+    magneto_real dB_ned[3][3];
+} magneto_FieldGradient;
+
+/// Same as `eval_field`, but also computes the spatial gradient of the field into `gradient`
+///
+/// Derivatives are analytic & summed in the same pass as the field, including the change in
+/// rotation from the geocentric to the geodetic frame. They're undefined exactly at the poles.
+/// Returns a zeroed state for Schmidt normalized models, which aren't supported.
+magneto_FieldState eval_field_with_gradient(
+    const magneto_Model *model,
+    magneto_DecYear t,
+    magneto_Coords coords,
+    magneto_FieldGradient *gradient
+);
+
+/// Limits on the degree of a truncated evaluation, the lowest degree meeting both is used
+typedef struct {
+    /// [nT] Largest acceptable bound on the truncation error, 0 to truncate only by `max_degree`
+    magneto_real tolerance;
+    size_t max_degree;          ///< Highest degree to evaluate, 0 for the model's `nm_max`
+} magneto_TruncationOptions;
+
+/// Degree a truncated evaluation actually used
+typedef struct {
+    size_t degree;
+    /// [nT] Bound on the magnitude of the field vector of all the left out degrees, which
+    /// is infinite if the model has no `degree_bounds` but degrees were left out
+    magneto_real error_bound;
+} magneto_TruncationInfo;
+
+/// Same as `eval_field`, but only up to the lowest degree within the `options`
+///
+/// Terms of degree n fall off with radius as (a/r)^(n+2), so far from the Earth high degrees
+/// are below a sensor's noise. The truncation degree is chosen from the radius & the model's
+/// `degree_bounds`, so costs O(nm_max) on top of an evaluation of quadratically fewer terms.
+/// Without bounds, the `tolerance` is ignored. The degree used & its error bound are reported
+/// in `info`, if not `NULL`.
+magneto_FieldState eval_field_truncated(
+    const magneto_Model *model,
+    magneto_DecYear t,
+    magneto_Coords coords,
+    const magneto_TruncationOptions *options,
+    magneto_TruncationInfo *info
+);
+
+/// Length of a snapshot buffer for a model with `num_coeffs` coefficients
+#define MAGNETO_SNAPSHOT_LEN(num_coeffs) (2U * (num_coeffs))
+
+/// Model coefficients fully interpolated to a single time
+typedef struct {
+    const magneto_Model *model;
+    magneto_DecYear t;
+    /// Interleaved {g, h} indexed by `MAGNETO_CALC_INDEX`, caller-owned
+    const magneto_real *coeffs;
+} magneto_ModelSnapshot;
+
+/// Interpolate all coefficients of `model` to time `t` into `buffer`
+///
+/// The `buffer` must have a length of at least `MAGNETO_SNAPSHOT_LEN(model->num_model_coeffs)`
+/// and outlive the snapshot. Returns a zeroed snapshot if any input is invalid.
+magneto_ModelSnapshot magneto_ModelSnapshot_from_model(
+    const magneto_Model *model,
+    magneto_DecYear t,
+    magneto_real *buffer,
+    size_t buffer_len
+);
+
+/// Same as `eval_field` at the snapshot's time, but without any time interpolation
+///
+/// Terms whose interpolated coefficients are exactly zero are skipped.
+magneto_FieldState eval_field_snapshot(
+    const magneto_ModelSnapshot *snapshot,
+    magneto_Coords coords
+);
+
+/// Structure-of-arrays batch of query points, each array has the same length
+typedef struct {
+    const magneto_real *latitude;       ///< [deg]  Geodetic latitudes
+    const magneto_real *longitude;      ///< [deg]  Longitudes
+    const magneto_real *height;         ///< [m]    Heights above WGS84 reference ellipsoid
+    const magneto_DecYear *time;        ///< Decimal year of each point
+} magneto_CoordsBatch;
+
+/// Structure-of-arrays batch of caller-owned outputs, any `NULL` array is not computed
+typedef struct {
+    magneto_real *B_ned[3];     ///< North, east & down components
+    magneto_real *F;
+    magneto_real *H;
+    magneto_real *D;
+    magneto_real *I;
+} magneto_FieldStateBatch;
+
+/// Evaluate the field at `count` points, without any allocation
+///
+/// Per-call setup is shared across the batch and only the non-`NULL`
+/// outputs are computed. Each output matches `eval_field` up to rounding.
+/// Points spanning several sub-models are evaluated in one pass per sub-model,
+/// so batches sorted by time are fastest.
+/// Schmidt normalized models are evaluated point by point.
+void eval_field_batch(
+    const magneto_Model *model,
+    size_t count,
+    const magneto_CoordsBatch *in,
+    const magneto_FieldStateBatch *out
+);
+
+/// Regular grid of geodetic coordinates, with each axis given by its own array
+typedef struct {
+    const magneto_real *latitude;       ///< [deg]  Geodetic latitude of each row
+    const magneto_real *longitude;      ///< [deg]  Longitude of each column
+    const magneto_real *height;         ///< [m]    Height of each layer
+    size_t num_latitude;
+    size_t num_longitude;
+    size_t num_height;
+} magneto_CoordsGrid;
+
+/// Length of the workspace needed by `eval_field_grid`
+#define MAGNETO_GRID_WORKSPACE_LEN(nm_max, num_longitude) ((6U + (2U * (num_longitude))) * ((nm_max) + 1U))
+
+/// Evaluate the field over a regular grid at a single time
+///
+/// Outputs are contiguous rasters indexed by `(i_height * num_latitude + i_latitude) * num_longitude + i_longitude`,
+/// any `NULL` output is not computed. The Legendre recursion & radial terms are only evaluated once per
+/// row of each layer and the longitude terms once per column, so each point only costs a sum over orders.
+/// Schmidt normalized models are evaluated point by point, but still need the workspace.
+/// The caller-owned `workspace` must have a length of at least `MAGNETO_GRID_WORKSPACE_LEN`.
+void eval_field_grid(
+    const magneto_Model *model,
+    magneto_DecYear t,
+    const magneto_CoordsGrid *grid,
+    const magneto_FieldStateBatch *out,
+    magneto_real *workspace,
+    size_t workspace_len
+);
+
+/// Length of the workspace needed by a `magneto_Evaluator`
+#define MAGNETO_EVALUATOR_WORKSPACE_LEN(nm_max, num_coeffs) ((4U * (num_coeffs)) + (3U * ((nm_max) + 1U)))
+
+/// Reusable evaluation context which caches every stage for its last inputs
+///
+/// All arrays point into a caller-owned workspace. Initialize with `magneto_Evaluator_from_model`.
+typedef struct {
+    const magneto_Model *model;
+    magneto_real *P;            ///< P_{n,m} indexed by `MAGNETO_CALC_INDEX`
+    magneto_real *dP;           ///< dP_{n,m}/dtheta indexed by `MAGNETO_CALC_INDEX`
+    magneto_real *cos_mphi;     ///< cos(m*phi) indexed by order
+    magneto_real *sin_mphi;     ///< sin(m*phi) indexed by order
+    magneto_real *r_pow;        ///< (a/r)^(n+2) indexed by degree
+    magneto_real *coeffs;       ///< Interleaved {g, h} at `t`, indexed by `MAGNETO_CALC_INDEX`
+    magneto_ModelSnapshot snapshot;
+    bool has_position;
+    bool has_longitude;
+    magneto_Coords coords;      ///< Last geodetic coordinates
+    magneto_GeocentricFrame frame;  ///< Last geocentric coordinates & rotation to NED
+} magneto_Evaluator;
+
+/// Set up an evaluator of `model` in `workspace`, which must outlive it
+///
+/// The `workspace` must have a length of at least `MAGNETO_EVALUATOR_WORKSPACE_LEN`.
+/// Returns a zeroed evaluator if any input is invalid or the model isn't Gauss normalized.
+magneto_Evaluator magneto_Evaluator_from_model(
+    const magneto_Model *model,
+    magneto_real *workspace,
+    size_t workspace_len
+);
+
+/// Same as `eval_field`, but only recomputes the stages whose inputs changed since the last call
+///
+/// The Legendre recursion & radial terms are skipped if latitude & height are unchanged,
+/// longitude terms if longitude is unchanged & the coefficients if the time is unchanged.
+magneto_FieldState eval_field_incremental(
+    magneto_Evaluator *evaluator,
+    magneto_DecYear t,
+    magneto_Coords coords
+);
+
 #endif  // MAGNETO_MODEL_H
@@ -0,0 +1,79 @@
+#ifndef MAGNETO_MODEL_BINARY_H
+#define MAGNETO_MODEL_BINARY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "magneto.h"
+#include "model.h"
+
+// A binary model is a header followed by sections of raw `magneto_real` arrays laid out
+// exactly like the compiled-in tables, so a model can be used straight out of a mapped
+// file without parsing or copying. All fields are in native (little-endian) byte order.
+
+/// Identifies a binary model, "MGMD" in little-endian
+#define MAGNETO_MODEL_BINARY_MAGIC      (0x444D474DUL)
+#define MAGNETO_MODEL_BINARY_VERSION    (4U)
+/// Every section starts at a multiple of this many bytes from the start of the file
+#define MAGNETO_MODEL_BINARY_ALIGNMENT  (64U)
+
+/// Flag set if the file has a recursion constants section
+#define MAGNETO_MODEL_BINARY_HAS_RECURSION  (1UL << 0U)
+/// Flag set if the coefficients are Schmidt semi-normalized, see `magneto_NORMALIZATION_SCHMIDT`
+#define MAGNETO_MODEL_BINARY_SCHMIDT        (1UL << 1U)
+/// Flag set if the file has a per-degree field bounds section, see `magneto_Model.degree_bounds`
+#define MAGNETO_MODEL_BINARY_HAS_BOUNDS     (1UL << 2U)
+/// Flag set if the file has an order-major terms section, see `magneto_Model.terms`
+#define MAGNETO_MODEL_BINARY_HAS_TERMS      (1UL << 3U)
+/// Flag set if the file has a square roots section, see `magneto_Model.roots`
+#define MAGNETO_MODEL_BINARY_HAS_ROOTS      (1UL << 4U)
+
+/// Fixed-size header at the start of a binary model, written by `tools/gen_coeffs.py`
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t real_size;             ///< `sizeof(magneto_real)` of every section
+    uint32_t nm_max;                ///< Maximum degree & order
+    uint32_t num_model_coeffs;      ///< Coefficients per sub-model, `MAGNETO_CALC_INDEX(nm_max, nm_max) + 1`
+    uint32_t num_models;            ///< Number of sub-models
+    uint32_t flags;                 ///< Bitwise OR of `MAGNETO_MODEL_BINARY_*` flags
+    double epoch;                   ///< [year] Epoch of the first sub-model
+    double model_interval;          ///< [year] Time between consecutive sub-models
+    uint64_t file_size;             ///< Total size in bytes, including this header
+    uint64_t coeffs_offset;         ///< `num_models` consecutive arrays of {g, h}
+    uint64_t secular_offset;        ///< Array of {g_dot, h_dot} after the last sub-model
+    uint64_t recursion_offset;      ///< Array of {K, n + 1, m}, 0 if absent
+    uint64_t bounds_offset;         ///< Array of `nm_max + 1` per-degree bounds, 0 if absent
+    uint64_t terms_offset;          ///< `num_models` consecutive arrays of {g, h, g_dot, h_dot}, 0 if absent
+    uint64_t roots_offset;          ///< Array of `2 * nm_max + 1` square roots {root, inv_root}, 0 if absent
+    char name[32];                  ///< Null-terminated model name
+} magneto_ModelBinaryHeader;
+
+/// View a binary model in `data` as a `magneto_Model`, without copying any coefficients
+///
+/// The `data` must be aligned to `MAGNETO_MODEL_BINARY_ALIGNMENT` and outlive the model, as
+/// must `models`, which is filled with one entry per sub-model and must have a length of at
+/// least the header's `num_models`. Returns a zeroed model if the data is invalid, was built
+/// for a different precision or byte order, or is truncated.
+magneto_Model magneto_Model_from_binary(
+    const void *data,
+    size_t size,
+    magneto_ModelCoeffs *models,
+    size_t models_len
+);
+
+/// Read-only memory mapping of a whole file
+typedef struct {
+    const void *data;
+    size_t size;
+} magneto_ModelFile;
+
+/// Map the file at `path` read-only, so pages are loaded lazily & shared between processes
+///
+/// Only supported on POSIX & Windows. Returns a zeroed mapping if the file can't be mapped.
+magneto_ModelFile magneto_ModelFile_open(const char *path);
+
+/// Unmap a file, any model viewing it must no longer be used
+void magneto_ModelFile_close(magneto_ModelFile *file);
+
+#endif  // MAGNETO_MODEL_BINARY_H
@@ -0,0 +1,45 @@
+#ifndef MAGNETO_PARALLEL_H
+#define MAGNETO_PARALLEL_H
+
+#include <stddef.h>
+
+#include "magneto.h"
+#include "model.h"
+
+/// Default points per task, a multiple of the batch kernel width whose inputs & outputs fit in L1/L2
+#define MAGNETO_PARALLEL_DEFAULT_CHUNK  (1024U)
+
+/// Task of a parallel loop, `i_task` is in [0, num_tasks)
+typedef void (*magneto_TaskFn)(void *context, size_t i_task);
+
+/// Caller-provided thread pool, so evaluation can share the application's threads
+typedef struct {
+    /// Run `fn(context, i)` for every `i` in [0, num_tasks) in any order & on any threads,
+    /// only returning once all tasks have finished. Tasks write disjoint outputs.
+    void (*parallel_for)(void *pool, magneto_TaskFn fn, void *context, size_t num_tasks);
+    void *pool;                 ///< Passed through to `parallel_for`
+} magneto_TaskPool;
+
+typedef struct {
+    /// Threads to evaluate on, including the calling thread, if spawning them.
+    /// 0 or 1 evaluates serially, as does any count if built without threads.
+    size_t num_threads;
+    size_t chunk_size;          ///< Points per task, 0 for `MAGNETO_PARALLEL_DEFAULT_CHUNK`
+    const magneto_TaskPool *pool;   ///< Pool to run tasks on, or `NULL` to spawn threads per call
+} magneto_ParallelOptions;
+
+/// Same as `eval_field_batch`, but split into chunks evaluated in parallel
+///
+/// Chunks are rounded up to whole kernel widths & every point is evaluated exactly as by
+/// `eval_field_batch`, so results are bitwise identical to the serial path. Spawned threads
+/// take chunks round-robin & are joined before returning. If a thread can't be spawned, its
+/// chunks are evaluated on the calling thread instead.
+void eval_field_batch_parallel(
+    const magneto_Model *model,
+    size_t count,
+    const magneto_CoordsBatch *in,
+    const magneto_FieldStateBatch *out,
+    const magneto_ParallelOptions *options
+);
+
+#endif  // MAGNETO_PARALLEL_H
@@ -0,0 +1,84 @@
+#ifndef MAGNETO_PRECISION_H
+#define MAGNETO_PRECISION_H
+
+// A dual-precision build (`MAGNETO_DUAL_PRECISION`) compiles the library twice, double-precision
+// with the usual names & single-precision with every external symbol suffixed by `_f`, so both
+// link into one process. A translation unit picks its precision by defining `MAGNETO_SINGLE_PRECISION`
+// before including any header, which then maps the usual names onto the suffixed ones.
+// Both are built from the same sources & tables, so models like `magneto_MODEL_WMM2020` exist in each.
+
+#if defined(MAGNETO_DUAL_PRECISION) && defined(MAGNETO_SINGLE_PRECISION)
+
+#define eval_field                                 eval_field_f
+#define eval_field_batch                           eval_field_batch_f
+#define eval_field_batch_parallel                  eval_field_batch_parallel_f
+#define eval_field_cached                          eval_field_cached_f
+#define eval_field_grid                            eval_field_grid_f
+#define eval_field_incremental                     eval_field_incremental_f
+#define eval_field_registry                        eval_field_registry_f
+#define eval_field_snapshot                        eval_field_snapshot_f
+#define eval_field_truncated                       eval_field_truncated_f
+#define eval_field_with_gradient                   eval_field_with_gradient_f
+#define eval_field_with_rates                      eval_field_with_rates_f
+#define magneto_Coords_from_ecef                   magneto_Coords_from_ecef_f
+#define magneto_Coords_from_ecef_batch             magneto_Coords_from_ecef_batch_f
+#define magneto_Coords_from_ecef_fast              magneto_Coords_from_ecef_fast_f
+#define magneto_Coords_from_ecef_fast_batch        magneto_Coords_from_ecef_fast_batch_f
+#define magneto_Coords_from_spherical              magneto_Coords_from_spherical_f
+#define magneto_Coords_from_spherical_batch        magneto_Coords_from_spherical_batch_f
+#define magneto_DateTime_is_valid                  magneto_DateTime_is_valid_f
+#define magneto_DecYear_from_date_time             magneto_DecYear_from_date_time_f
+#define magneto_DecYear_from_gps                   magneto_DecYear_from_gps_f
+#define magneto_DecYear_from_unix                  magneto_DecYear_from_unix_f
+#define magneto_DecYear_from_unix_batch            magneto_DecYear_from_unix_batch_f
+#define magneto_DecYear_from_unix_cached           magneto_DecYear_from_unix_cached_f
+#define magneto_DecYear_is_valid                   magneto_DecYear_is_valid_f
+#define magneto_EcefPosition_from_coords           magneto_EcefPosition_from_coords_f
+#define magneto_EcefPosition_from_coords_batch     magneto_EcefPosition_from_coords_batch_f
+#define magneto_EcefPosition_from_spherical        magneto_EcefPosition_from_spherical_f
+#define magneto_EcefPosition_from_spherical_batch  magneto_EcefPosition_from_spherical_batch_f
+#define magneto_Evaluator_from_model               magneto_Evaluator_from_model_f
+#define magneto_FieldCache_build                   magneto_FieldCache_build_f
+#define magneto_FieldCache_is_valid                magneto_FieldCache_is_valid_f
+#define magneto_FieldCache_lookup                  magneto_FieldCache_lookup_f
+#define magneto_FieldRates_from_ned                magneto_FieldRates_from_ned_f
+#define magneto_FieldState_from_ned                magneto_FieldState_from_ned_f
+#define magneto_FieldState_from_ned_batch          magneto_FieldState_from_ned_batch_f
+#define magneto_GEOMAG_REF_RADIUS                  magneto_GEOMAG_REF_RADIUS_f
+#define magneto_GeocentricFrame_from_coords        magneto_GeocentricFrame_from_coords_f
+#define magneto_GeocentricFrame_from_coords_batch  magneto_GeocentricFrame_from_coords_batch_f
+#define magneto_MODEL_WMM2020                      magneto_MODEL_WMM2020_f
+#define magneto_ModelFile_close                    magneto_ModelFile_close_f
+#define magneto_ModelFile_open                     magneto_ModelFile_open_f
+#define magneto_ModelRegistry_acquire              magneto_ModelRegistry_acquire_f
+#define magneto_ModelRegistry_init                 magneto_ModelRegistry_init_f
+#define magneto_ModelRegistry_publish              magneto_ModelRegistry_publish_f
+#define magneto_ModelRegistry_release              magneto_ModelRegistry_release_f
+#define magneto_ModelSnapshot_from_model           magneto_ModelSnapshot_from_model_f
+#define magneto_Model_from_binary                  magneto_Model_from_binary_f
+#define magneto_PI                                 magneto_PI_f
+#define magneto_ResultCache_init                   magneto_ResultCache_init_f
+#define magneto_ResultCache_stats                  magneto_ResultCache_stats_f
+#define magneto_SphericalCoords_from_coords        magneto_SphericalCoords_from_coords_f
+#define magneto_SphericalCoords_from_coords_batch  magneto_SphericalCoords_from_coords_batch_f
+#define magneto_SphericalCoords_from_ecef          magneto_SphericalCoords_from_ecef_f
+#define magneto_SphericalCoords_from_ecef_batch    magneto_SphericalCoords_from_ecef_batch_f
+#define magneto_WGS84_A                            magneto_WGS84_A_f
+#define magneto_WGS84_B                            magneto_WGS84_B_f
+#define magneto_WGS84_E_SQ                         magneto_WGS84_E_SQ_f
+#define magneto_WGS84_F                            magneto_WGS84_F_f
+#define magneto_WGS84_F_INV                        magneto_WGS84_F_INV_f
+#define magneto_convert_vector_ecef_to_ned         magneto_convert_vector_ecef_to_ned_f
+#define magneto_convert_vector_ecef_to_ned_batch   magneto_convert_vector_ecef_to_ned_batch_f
+#define magneto_convert_vector_ned_to_ecef         magneto_convert_vector_ned_to_ecef_f
+#define magneto_convert_vector_ned_to_ecef_batch   magneto_convert_vector_ned_to_ecef_batch_f
+#define magneto_deg_to_rad                         magneto_deg_to_rad_f
+#define magneto_matrix_ned_to_ecef                 magneto_matrix_ned_to_ecef_f
+#define magneto_rad_to_deg                         magneto_rad_to_deg_f
+#define magneto_trace_reset                        magneto_trace_reset_f
+#define magneto_trace_set_hook                     magneto_trace_set_hook_f
+#define magneto_trace_stats                        magneto_trace_stats_f
+
+#endif  // MAGNETO_DUAL_PRECISION && MAGNETO_SINGLE_PRECISION
+
+#endif  // MAGNETO_PRECISION_H
@@ -0,0 +1,65 @@
+#ifndef MAGNETO_REGISTRY_H
+#define MAGNETO_REGISTRY_H
+
+#include <stddef.h>
+
+#include "magneto.h"
+#include "model.h"
+
+/// Per-thread reader state of a registry, padded to a cache line so readers never share one
+typedef struct {
+    size_t epoch;               ///< Epoch of the registry when the model was acquired, 0 if none
+    char reserved[64U - sizeof(size_t)];
+} magneto_RegistryReader;
+
+/// Current model, which can be replaced at runtime while other threads evaluate it
+///
+/// Readers announce which epoch they read the model in, & a replaced model is only handed back
+/// to be freed once every reader that could hold it has released it, like RCU. Readers never
+/// lock or wait, and only write their own `magneto_RegistryReader`.
+typedef struct {
+    const magneto_Model *model;
+    size_t epoch;               ///< Incremented on every publish, starting at 1
+    magneto_RegistryReader *readers;
+    size_t num_readers;
+} magneto_ModelRegistry;
+
+/// Set up a registry with an initial `model`, read by up to `num_readers` threads
+///
+/// Each reading thread uses its own index into the caller-provided `readers`, which must outlive
+/// the registry. Returns false if any input is invalid.
+bool magneto_ModelRegistry_init(
+    magneto_ModelRegistry *registry,
+    const magneto_Model *model,
+    magneto_RegistryReader *readers,
+    size_t num_readers
+);
+
+/// Get the current model for reader `i_reader`, which it may use until released
+///
+/// Never blocks. A reader must release its model before acquiring again. Returns `NULL` if
+/// `i_reader` is out of range.
+const magneto_Model *magneto_ModelRegistry_acquire(magneto_ModelRegistry *registry, size_t i_reader);
+
+/// Stop using the model last acquired by reader `i_reader`
+void magneto_ModelRegistry_release(magneto_ModelRegistry *registry, size_t i_reader);
+
+/// Replace the current model, returning the previous one once no reader can still use it
+///
+/// The `model` must be fully set up, and it & everything it points to must stay valid until it
+/// is itself replaced & returned, after which the caller may free it. Readers acquiring after
+/// the swap see the new model, & this waits for those still holding the previous one to release
+/// it, so it must not be called by a thread holding a model. Any number of threads may publish
+/// concurrently, each getting back the model it replaced. Returns `NULL` if any input is invalid.
+/// Requires GCC, Clang or MSVC atomics to share between threads.
+const magneto_Model *magneto_ModelRegistry_publish(magneto_ModelRegistry *registry, const magneto_Model *model);
+
+/// Same as `eval_field` on the current model of a registry, acquired & released by `i_reader`
+magneto_FieldState eval_field_registry(
+    magneto_ModelRegistry *registry,
+    size_t i_reader,
+    magneto_DecYear t,
+    magneto_Coords coords
+);
+
+#endif  // MAGNETO_REGISTRY_H
@@ -0,0 +1,54 @@
+#ifndef MAGNETO_TRACE_H
+#define MAGNETO_TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "magneto.h"
+
+// Instrumentation is only compiled in if `MAGNETO_TRACE` is defined, otherwise
+// the hooks compile to nothing, the hook is never called & all stats are zero.
+
+/// Stages of evaluating a field, each with its own counters
+typedef enum {
+    magneto_TRACE_STAGE_COORDS = 0,     ///< Geodetic to geocentric coordinate conversion
+    magneto_TRACE_STAGE_LEGENDRE,       ///< Associated Legendre recursion
+    magneto_TRACE_STAGE_COEFFS,         ///< Coefficient lookup & time interpolation
+    magneto_TRACE_STAGE_SUMMATION,      ///< Summation of expansion terms
+    magneto_TRACE_STAGE_ROTATION,       ///< Rotation from geocentric to geodetic NED frame
+    magneto_TRACE_NUM_STAGES
+} magneto_TraceStage;
+
+typedef struct {
+    uint64_t calls;     ///< Number of times the stage ran
+    uint64_t cycles;    ///< Total timestamp counter ticks spent in the stage
+} magneto_TraceStageStats;
+
+typedef struct {
+    magneto_TraceStageStats stages[magneto_TRACE_NUM_STAGES];
+    uint64_t terms;     ///< Number of (n, m) expansion terms evaluated
+} magneto_TraceStats;
+
+/// Single (n, m) term of a scalar spherical harmonic expansion
+typedef struct {
+    size_t n;
+    size_t m;
+    magneto_real P;     ///< P_{n,m}
+    magneto_real dP;    ///< dP_{n,m}/dtheta
+    magneto_real g;     ///< Time interpolated g_{n,m}
+    magneto_real h;     ///< Time interpolated h_{n,m}
+} magneto_TraceTerm;
+
+typedef void (*magneto_TraceHook)(const magneto_TraceTerm *term, void *context);
+
+/// Set the hook called for every term, or `NULL` to remove it
+void magneto_trace_set_hook(magneto_TraceHook hook, void *context);
+
+/// Global stage counters, which aren't synchronized across threads
+///
+/// The lane-wise batch kernel fuses the Legendre recursion, coefficient
+/// interpolation & summation, so all of it is counted as summation.
+magneto_TraceStats magneto_trace_stats(void);
+void magneto_trace_reset(void);
+
+#endif  // MAGNETO_TRACE_H
@@ -0,0 +1,443 @@
+#include "magneto/cache.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "magneto/model.h"
+#include "common_private.h"
+
+// Points of the 3x3x3 lattice over a box, indexed by (lat, lon, height) steps in [0, 2]
+#define LATTICE_INDEX(i, j, k)  ((9U * (i)) + (3U * (j)) + (k))
+#define LATTICE_SIZE            (27U)
+#define NUM_CORNERS             (8U)
+#define CORNER_BIT(c, axis)     (((c) >> (2U - (axis))) & 1U)
+
+typedef struct {
+    const magneto_Model *model;
+    DecYear t;
+    real tolerance;
+    size_t max_depth;
+    magneto_FieldCacheNode *nodes;
+    size_t capacity;
+    size_t num_nodes;
+    size_t depth;
+    real max_error;
+} CacheBuilder;
+
+static magneto_FieldCacheNode *cache_nodes(const magneto_FieldCacheHeader *const cache) {
+    // Nodes immediately follow the header, which has at least the same alignment
+    return (magneto_FieldCacheNode *) (uintptr_t) (cache + 1);
+}
+
+/// Fraction of `x` along the interval [lo, hi], which may be empty
+static real interval_fraction(const real x, const real lo, const real hi) {
+    return (hi > lo) ? ((x - lo) / (hi - lo)) : 0;
+}
+
+/// Trilinear interpolation between the flattened corners of a box, at fractions (u, v, w) along each axis
+static void interp_trilinear(
+    const real *const corners,
+    const real u,
+    const real v,
+    const real w,
+    real *const B_ned
+) {
+    B_ned[0] = 0;
+    B_ned[1] = 0;
+    B_ned[2] = 0;
+    for (size_t c = 0U; c < NUM_CORNERS; ++c) {
+        const real weight = (CORNER_BIT(c, 0U) ? u : (1 - u))
+            * (CORNER_BIT(c, 1U) ? v : (1 - v))
+            * (CORNER_BIT(c, 2U) ? w : (1 - w));
+        B_ned[0] += weight * corners[(3U * c) + 0U];
+        B_ned[1] += weight * corners[(3U * c) + 1U];
+        B_ned[2] += weight * corners[(3U * c) + 2U];
+    }
+}
+
+static Coords lattice_coords(const Coords min, const Coords max, const size_t i, const size_t j, const size_t k) {
+    const Coords coords = {
+        .latitude = min.latitude + (((real) i / 2) * (max.latitude - min.latitude)),
+        .longitude = min.longitude + (((real) j / 2) * (max.longitude - min.longitude)),
+        .height = min.height + (((real) k / 2) * (max.height - min.height))
+    };
+    return coords;
+}
+
+/// Fill node `idx` for the box between `min` and `max`, subdividing it if needed
+static bool build_node(
+    CacheBuilder *const builder,
+    const size_t idx,
+    const size_t depth,
+    const Coords min,
+    const Coords max,
+    real corners[NUM_CORNERS][3]
+) {
+    // Evaluate the field at every lattice point, reusing the known corners
+    real lattice[LATTICE_SIZE][3];
+    real error = 0;
+    for (size_t i = 0U; i <= 2U; ++i) {
+        for (size_t j = 0U; j <= 2U; ++j) {
+            for (size_t k = 0U; k <= 2U; ++k) {
+                real *const B = lattice[LATTICE_INDEX(i, j, k)];
+                const bool is_corner = ((i != 1U) && (j != 1U) && (k != 1U));
+                if (is_corner) {
+                    const size_t c = ((i / 2U) << 2U) | ((j / 2U) << 1U) | (k / 2U);
+                    B[0] = corners[c][0];
+                    B[1] = corners[c][1];
+                    B[2] = corners[c][2];
+                    continue;
+                }
+                const FieldState field = eval_field(builder->model, builder->t, lattice_coords(min, max, i, j, k));
+                B[0] = field.B_ned[0];
+                B[1] = field.B_ned[1];
+                B[2] = field.B_ned[2];
+
+                real B_interp[3];
+                interp_trilinear(corners[0], (real) i / 2, (real) j / 2, (real) k / 2, B_interp);
+                const real error_i = SQRT(sq(B[0] - B_interp[0]) + sq(B[1] - B_interp[1]) + sq(B[2] - B_interp[2]));
+                error = MAX_OF(error, error_i);
+            }
+        }
+    }
+
+    magneto_FieldCacheNode *const node = &builder->nodes[idx];
+    node->first_child = 0U;
+    node->reserved = 0U;
+
+    // Leaf if accurate enough or can't go deeper
+    if ((error <= builder->tolerance) || (depth >= builder->max_depth)) {
+        for (size_t c = 0U; c < NUM_CORNERS; ++c) {
+            node->B_ned[c][0] = corners[c][0];
+            node->B_ned[c][1] = corners[c][1];
+            node->B_ned[c][2] = corners[c][2];
+        }
+        builder->max_error = MAX_OF(builder->max_error, error);
+        builder->depth = MAX_OF(builder->depth, depth);
+        return true;
+    }
+
+    // Reserve 8 consecutive children
+    if ((builder->capacity - builder->num_nodes) < NUM_CORNERS) {
+        return false;
+    }
+    const size_t first_child = builder->num_nodes;
+    builder->num_nodes += NUM_CORNERS;
+    node->first_child = (uint32_t) first_child;
+    for (size_t c = 0U; c < NUM_CORNERS; ++c) {
+        node->B_ned[c][0] = 0;
+        node->B_ned[c][1] = 0;
+        node->B_ned[c][2] = 0;
+    }
+
+    for (size_t octant = 0U; octant < NUM_CORNERS; ++octant) {
+        const size_t i0 = CORNER_BIT(octant, 0U);
+        const size_t j0 = CORNER_BIT(octant, 1U);
+        const size_t k0 = CORNER_BIT(octant, 2U);
+        real child_corners[NUM_CORNERS][3];
+        for (size_t c = 0U; c < NUM_CORNERS; ++c) {
+            const real *const B = lattice[LATTICE_INDEX(i0 + CORNER_BIT(c, 0U), j0 + CORNER_BIT(c, 1U), k0 + CORNER_BIT(c, 2U))];
+            child_corners[c][0] = B[0];
+            child_corners[c][1] = B[1];
+            child_corners[c][2] = B[2];
+        }
+        const Coords child_min = lattice_coords(min, max, i0, j0, k0);
+        const Coords child_max = lattice_coords(min, max, i0 + 1U, j0 + 1U, k0 + 1U);
+        if (!build_node(builder, first_child + octant, depth + 1U, child_min, child_max, child_corners)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t magneto_FieldCache_build(
+    const magneto_Model *const model,
+    const magneto_DecYear t,
+    const magneto_Coords min,
+    const magneto_Coords max,
+    const magneto_real tolerance,
+    const size_t max_depth,
+    void *const buffer,
+    const size_t buffer_size
+) {
+    if ((model == NULL) || (buffer == NULL) || (buffer_size < MAGNETO_FIELD_CACHE_SIZE(1U))) {
+        return 0U;
+    }
+    const bool valid_box = (min.latitude <= max.latitude)
+        && (min.longitude <= max.longitude)
+        && (min.height <= max.height);
+    if (!valid_box || !(tolerance > 0)) {
+        return 0U;
+    }
+
+    magneto_FieldCacheHeader *const cache = (magneto_FieldCacheHeader *) buffer;
+    const size_t capacity = (buffer_size - sizeof(magneto_FieldCacheHeader)) / sizeof(magneto_FieldCacheNode);
+    CacheBuilder builder = {
+        .model = model,
+        .t = t,
+        .tolerance = tolerance,
+        .max_depth = max_depth,
+        .nodes = cache_nodes(cache),
+        .capacity = (capacity < UINT32_MAX) ? capacity : UINT32_MAX,
+        .num_nodes = 1U,
+        .depth = 0U,
+        .max_error = 0
+    };
+
+    real corners[NUM_CORNERS][3];
+    for (size_t c = 0U; c < NUM_CORNERS; ++c) {
+        const Coords coords = lattice_coords(min, max, 2U * CORNER_BIT(c, 0U), 2U * CORNER_BIT(c, 1U), 2U * CORNER_BIT(c, 2U));
+        const FieldState field = eval_field(model, t, coords);
+        corners[c][0] = field.B_ned[0];
+        corners[c][1] = field.B_ned[1];
+        corners[c][2] = field.B_ned[2];
+    }
+    if (!build_node(&builder, 0U, 0U, min, max, corners)) {
+        return 0U;
+    }
+
+    cache->magic = MAGNETO_FIELD_CACHE_MAGIC;
+    cache->version = MAGNETO_FIELD_CACHE_VERSION;
+    cache->real_size = (uint16_t) sizeof(real);
+    cache->num_nodes = (uint32_t) builder.num_nodes;
+    cache->depth = (uint32_t) builder.depth;
+    cache->min = min;
+    cache->max = max;
+    cache->t = t;
+    cache->tolerance = tolerance;
+    cache->max_error = builder.max_error;
+    return MAGNETO_FIELD_CACHE_SIZE(builder.num_nodes);
+}
+
+bool magneto_FieldCache_is_valid(const magneto_FieldCacheHeader *const cache, const size_t buffer_size) {
+    if ((cache == NULL) || (buffer_size < sizeof(magneto_FieldCacheHeader))) {
+        return false;
+    }
+    bool valid = true;
+    valid &= (cache->magic == MAGNETO_FIELD_CACHE_MAGIC);
+    valid &= (cache->version == MAGNETO_FIELD_CACHE_VERSION);
+    valid &= (cache->real_size == sizeof(real));
+    valid &= (cache->num_nodes > 0U);
+    valid &= (buffer_size >= MAGNETO_FIELD_CACHE_SIZE((size_t) cache->num_nodes));
+    if (!valid) {
+        return false;
+    }
+
+    // Children must come after their parent, so lookups always descend & stay in the buffer
+    const magneto_FieldCacheNode *const nodes = cache_nodes(cache);
+    const size_t num_nodes = cache->num_nodes;
+    for (size_t i = 0U; i < num_nodes; ++i) {
+        const size_t first_child = nodes[i].first_child;
+        if ((first_child != 0U) && ((first_child <= i) || ((first_child + 8U) > num_nodes))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool magneto_FieldCache_lookup(
+    const magneto_FieldCacheHeader *const cache,
+    const magneto_Coords coords,
+    magneto_real *const B_ned
+) {
+    if ((cache == NULL) || (B_ned == NULL)) {
+        return false;
+    }
+    const bool inside = (coords.latitude >= cache->min.latitude) && (coords.latitude <= cache->max.latitude)
+        && (coords.longitude >= cache->min.longitude) && (coords.longitude <= cache->max.longitude)
+        && (coords.height >= cache->min.height) && (coords.height <= cache->max.height);
+    if (!inside) {
+        return false;
+    }
+
+    // Fractions along each axis of the current node's box
+    real u = interval_fraction(coords.latitude, cache->min.latitude, cache->max.latitude);
+    real v = interval_fraction(coords.longitude, cache->min.longitude, cache->max.longitude);
+    real w = interval_fraction(coords.height, cache->min.height, cache->max.height);
+
+    const magneto_FieldCacheNode *const nodes = cache_nodes(cache);
+    const magneto_FieldCacheNode *node = &nodes[0];
+    while (node->first_child != 0U) {
+        // Pick the octant & rescale the fractions to it
+        const uint32_t i = (u >= REAL(0.5)) ? 1U : 0U;
+        const uint32_t j = (v >= REAL(0.5)) ? 1U : 0U;
+        const uint32_t k = (w >= REAL(0.5)) ? 1U : 0U;
+        u = (2 * u) - (real) i;
+        v = (2 * v) - (real) j;
+        w = (2 * w) - (real) k;
+        node = &nodes[node->first_child + ((i << 2U) | (j << 1U) | k)];
+    }
+    interp_trilinear(node->B_ned[0], u, v, w, B_ned);
+    return true;
+}
+
+// Slots per bucket of a result cache, a power of 2
+#define RESULT_CACHE_WAYS   (4U)
+
+// Quantized coordinates must fit in an `int64_t` key exactly
+#define QUANTIZE_LIMIT  REAL(4.0e18)
+
+typedef magneto_ResultCache ResultCache;
+typedef magneto_ResultCacheSlot ResultCacheSlot;
+
+static ResultCacheSlot *cache_slots(ResultCache *const cache) {
+    // Slots immediately follow the header, which has at least the same alignment
+    return (ResultCacheSlot *) (uintptr_t) (cache + 1);
+}
+
+/// Round `x` to the nearest multiple of `step`, as its index in `key`, or keep its exact bits
+/// if there's no step. Returns false if it can't be quantized.
+static bool quantize(const real x, const real step, int64_t *const key, real *const quantized) {
+    if (!(step > 0)) {
+        int64_t bits = 0;
+        memcpy(&bits, &x, sizeof(x));
+        *key = bits;
+        *quantized = x;
+        return true;
+    }
+    const real index = REAL(floor)((x / step) + REAL(0.5));
+    if (!(REAL(fabs)(index) < QUANTIZE_LIMIT)) {
+        return false;
+    }
+    *key = (int64_t) index;
+    *quantized = index * step;
+    return true;
+}
+
+static size_t hash_key(const int64_t *const key) {
+    // Mix every coordinate, then fold the high bits down so masking keeps them
+    uint64_t hash = 0U;
+    for (size_t i = 0U; i < 4U; ++i) {
+        hash = (hash ^ (uint64_t) key[i]) * 0x9E3779B97F4A7C15ULL;
+    }
+    return (size_t) (hash ^ (hash >> 32U));
+}
+
+/// Read the state of `slot` if it holds `key` & isn't being written concurrently
+static bool read_slot(const ResultCacheSlot *const slot, const int64_t *const key, FieldState *const state) {
+    const size_t sequence = ATOMIC_LOAD_ACQUIRE(&slot->sequence);
+    if ((sequence == 0U) || ((sequence & 1U) != 0U)) {
+        return false;
+    }
+    int64_t slot_key[4];
+    memcpy(slot_key, slot->key, sizeof(slot_key));
+    const FieldState slot_state = slot->state;
+    // Both reads must complete before checking nothing was written in between
+    ATOMIC_FENCE_ACQUIRE();
+    if (ATOMIC_LOAD_RELAXED(&slot->sequence) != sequence) {
+        return false;
+    }
+    if (memcmp(slot_key, key, sizeof(slot_key)) != 0) {
+        return false;
+    }
+    *state = slot_state;
+    return true;
+}
+
+/// Replace the contents of `slot`, unless another thread is already writing it
+static void write_slot(ResultCacheSlot *const slot, const int64_t *const key, const FieldState *const state) {
+    size_t sequence = ATOMIC_LOAD_RELAXED(&slot->sequence);
+    if (((sequence & 1U) != 0U) || !ATOMIC_CAS(&slot->sequence, &sequence, sequence + 1U)) {
+        return;
+    }
+    // The odd sequence must be visible before any of the new contents, which the CAS alone
+    // doesn't order on weakly ordered CPUs
+    ATOMIC_FENCE_RELEASE();
+    memcpy(slot->key, key, sizeof(slot->key));
+    slot->state = *state;
+    ATOMIC_STORE_RELEASE(&slot->sequence, sequence + 2U);
+}
+
+magneto_ResultCache *magneto_ResultCache_init(
+    const magneto_Model *const model,
+    const magneto_ResultCacheSteps steps,
+    void *const buffer,
+    const size_t buffer_size
+) {
+    if ((model == NULL) || (buffer == NULL) || (buffer_size < MAGNETO_RESULT_CACHE_SIZE(1U))) {
+        return NULL;
+    }
+    if (((uintptr_t) buffer % sizeof(int64_t)) != 0U) {
+        return NULL;
+    }
+
+    // Power of 2 so the slot of a hash is just a mask
+    const size_t capacity = (buffer_size - sizeof(ResultCache)) / sizeof(ResultCacheSlot);
+    size_t num_slots = 1U;
+    while (num_slots <= (capacity / 2U)) {
+        num_slots *= 2U;
+    }
+
+    ResultCache *const cache = (ResultCache *) buffer;
+    cache->model = model;
+    cache->steps = steps;
+    cache->num_slots = num_slots;
+    cache->stats.hits = 0U;
+    cache->stats.misses = 0U;
+    memset(cache_slots(cache), 0, num_slots * sizeof(ResultCacheSlot));
+    return cache;
+}
+
+magneto_FieldState eval_field_cached(
+    magneto_ResultCache *const cache,
+    const magneto_DecYear t,
+    const magneto_Coords coords
+) {
+    if (cache == NULL) {
+        const FieldState invalid = { 0 };
+        return invalid;
+    }
+
+    int64_t key[4];
+    Coords quantized = coords;
+    DecYear quantized_t = t;
+    bool valid = true;
+    valid &= quantize(coords.latitude, cache->steps.latitude, &key[0], &quantized.latitude);
+    valid &= quantize(coords.longitude, cache->steps.longitude, &key[1], &quantized.longitude);
+    valid &= quantize(coords.height, cache->steps.height, &key[2], &quantized.height);
+    valid &= quantize(t.year, cache->steps.time, &key[3], &quantized_t.year);
+    if (!valid) {
+        (void) ATOMIC_FETCH_ADD(&cache->stats.misses, 1U);
+        return eval_field(cache->model, t, coords);
+    }
+    // Rounding may step just past a pole
+    quantized.latitude = (quantized.latitude > 90) ? 90 : quantized.latitude;
+    quantized.latitude = (quantized.latitude < -90) ? -90 : quantized.latitude;
+
+    // Any way of the bucket may hold the key, so a few colliding sites don't evict each other
+    const size_t hash = hash_key(key);
+    const size_t num_ways = (cache->num_slots < RESULT_CACHE_WAYS) ? cache->num_slots : RESULT_CACHE_WAYS;
+    ResultCacheSlot *const bucket = &cache_slots(cache)[hash & (cache->num_slots - num_ways)];
+    FieldState B = { 0 };
+    for (size_t i = 0U; i < num_ways; ++i) {
+        if (read_slot(&bucket[i], key, &B)) {
+            (void) ATOMIC_FETCH_ADD(&cache->stats.hits, 1U);
+            return B;
+        }
+    }
+    (void) ATOMIC_FETCH_ADD(&cache->stats.misses, 1U);
+    B = eval_field(cache->model, quantized_t, quantized);
+
+    // Fill an empty way first, otherwise evict a pseudo-random one
+    size_t i_victim = (hash >> 16U) & (num_ways - 1U);
+    for (size_t i = 0U; i < num_ways; ++i) {
+        if (ATOMIC_LOAD_RELAXED(&bucket[i].sequence) == 0U) {
+            i_victim = i;
+            break;
+        }
+    }
+    write_slot(&bucket[i_victim], key, &B);
+    return B;
+}
+
+magneto_ResultCacheStats magneto_ResultCache_stats(const magneto_ResultCache *const cache) {
+    magneto_ResultCacheStats stats = { 0U, 0U };
+    if (cache != NULL) {
+        stats.hits = ATOMIC_LOAD_RELAXED(&cache->stats.hits);
+        stats.misses = ATOMIC_LOAD_RELAXED(&cache->stats.misses);
+    }
+    return stats;
+}
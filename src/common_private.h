@@ -7,12 +7,123 @@
 #define MAX_OF(a, b)    (((a) > (b)) ? (a) : (b))
 #define ARRAY_SIZE(x)   (sizeof(x) / sizeof((x)[0]))
 
+// Hint to fetch memory into cache ahead of use, if supported by the compiler
+#ifdef __GNUC__
+#define PREFETCH(addr)  __builtin_prefetch(addr)
+#else
+#define PREFETCH(addr)  ((void) (addr))
+#endif
+
+// Atomics for structures shared between threads without locks. Integer operations are only
+// used on `size_t`, and pointers have their own `_PTR` variants, which MSVC needs as its
+// intrinsics aren't type-generic. Other compilers get plain accesses, so those structures are
+// only safe to use from one thread there.
+#if defined(__GNUC__)
+#define HAVE_ATOMICS
+#define ATOMIC_LOAD_RELAXED(ptr)            __atomic_load_n((ptr), __ATOMIC_RELAXED)
+#define ATOMIC_LOAD_ACQUIRE(ptr)            __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define ATOMIC_STORE_RELEASE(ptr, value)    __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#define ATOMIC_FETCH_ADD(ptr, value)        __atomic_fetch_add((ptr), (value), __ATOMIC_RELAXED)
+#define ATOMIC_CAS(ptr, expected, desired) \
+    __atomic_compare_exchange_n((ptr), (expected), (desired), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#define ATOMIC_LOAD_ACQUIRE_PTR(ptr)        ATOMIC_LOAD_ACQUIRE(ptr)
+#define ATOMIC_STORE_RELEASE_PTR(ptr, value) ATOMIC_STORE_RELEASE((ptr), (value))
+#define ATOMIC_EXCHANGE_PTR(ptr, value)     __atomic_exchange_n((ptr), (value), __ATOMIC_SEQ_CST)
+#define ATOMIC_FENCE_ACQUIRE()              __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define ATOMIC_FENCE_RELEASE()              __atomic_thread_fence(__ATOMIC_RELEASE)
+#define ATOMIC_FENCE()                      __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define HAVE_ATOMICS
+// Interlocked intrinsics are full barriers on every architecture, so loads & stores are
+// ordered by one on the appropriate side, like `MemoryBarrier` does w/o needing <windows.h>
+static inline void atomic_fence_interlocked(void) {
+    volatile long barrier = 0;
+    (void) _InterlockedExchange(&barrier, 1);
+}
+static inline size_t atomic_load_acquire_size(const volatile size_t *const ptr) {
+    const size_t value = *ptr;
+    atomic_fence_interlocked();
+    return value;
+}
+static inline void atomic_store_release_size(volatile size_t *const ptr, const size_t value) {
+    atomic_fence_interlocked();
+    *ptr = value;
+}
+static inline size_t atomic_fetch_add_size(volatile size_t *const ptr, const size_t value) {
+#ifdef _WIN64
+    return (size_t) _InterlockedExchangeAdd64((volatile __int64 *) ptr, (__int64) value);
+#else
+    return (size_t) _InterlockedExchangeAdd((volatile long *) ptr, (long) value);
+#endif
+}
+static inline int atomic_cas_size(volatile size_t *const ptr, size_t *const expected, const size_t desired) {
+#ifdef _WIN64
+    const size_t prev = (size_t) _InterlockedCompareExchange64(
+        (volatile __int64 *) ptr, (__int64) desired, (__int64) *expected
+    );
+#else
+    const size_t prev = (size_t) _InterlockedCompareExchange((volatile long *) ptr, (long) desired, (long) *expected);
+#endif
+    if (prev == *expected) {
+        return 1;
+    }
+    *expected = prev;
+    return 0;
+}
+static inline void *atomic_load_acquire_ptr(void *const volatile *const ptr) {
+    void *const value = *ptr;
+    atomic_fence_interlocked();
+    return value;
+}
+static inline void *atomic_exchange_ptr(void *volatile *const ptr, void *const value) {
+#ifdef _WIN64
+    return _InterlockedExchangePointer(ptr, value);
+#else
+    return (void *) (intptr_t) _InterlockedExchange((volatile long *) ptr, (long) (intptr_t) value);
+#endif
+}
+#define ATOMIC_LOAD_RELAXED(ptr)            (*(const volatile size_t *) (ptr))
+#define ATOMIC_LOAD_ACQUIRE(ptr)            atomic_load_acquire_size(ptr)
+#define ATOMIC_STORE_RELEASE(ptr, value)    atomic_store_release_size((ptr), (value))
+#define ATOMIC_FETCH_ADD(ptr, value)        atomic_fetch_add_size((ptr), (value))
+#define ATOMIC_CAS(ptr, expected, desired)  atomic_cas_size((ptr), (expected), (desired))
+#define ATOMIC_LOAD_ACQUIRE_PTR(ptr)        atomic_load_acquire_ptr((void *const volatile *) (ptr))
+#define ATOMIC_STORE_RELEASE_PTR(ptr, value) ((void) ATOMIC_EXCHANGE_PTR((ptr), (value)))
+#define ATOMIC_EXCHANGE_PTR(ptr, value)     atomic_exchange_ptr((void *volatile *) (ptr), (void *) (value))
+#define ATOMIC_FENCE_ACQUIRE()              atomic_fence_interlocked()
+#define ATOMIC_FENCE_RELEASE()              atomic_fence_interlocked()
+#define ATOMIC_FENCE()                      atomic_fence_interlocked()
+
+#else
+#define ATOMIC_LOAD_RELAXED(ptr)            (*(ptr))
+#define ATOMIC_LOAD_ACQUIRE(ptr)            (*(ptr))
+#define ATOMIC_STORE_RELEASE(ptr, value)    ((void) (*(ptr) = (value)))
+#define ATOMIC_FETCH_ADD(ptr, value)        ((*(ptr) += (value)) - (value))
+#define ATOMIC_CAS(ptr, expected, desired) \
+    ((*(ptr) == *(expected)) ? ((*(ptr) = (desired)), 1) : ((*(expected) = *(ptr)), 0))
+#define ATOMIC_LOAD_ACQUIRE_PTR(ptr)        (*(ptr))
+#define ATOMIC_STORE_RELEASE_PTR(ptr, value) ((void) (*(ptr) = (value)))
+#define ATOMIC_EXCHANGE_PTR(ptr, value)     atomic_exchange_fallback((void **) (ptr), (void *) (value))
+#define ATOMIC_FENCE_ACQUIRE()              ((void) 0)
+#define ATOMIC_FENCE_RELEASE()              ((void) 0)
+#define ATOMIC_FENCE()                      ((void) 0)
+static inline void *atomic_exchange_fallback(void **const ptr, void *const value) {
+    void *const prev = *ptr;
+    *ptr = value;
+    return prev;
+}
+#endif
+
 // Support single and double precision floating point
 
 #ifdef MAGNETO_SINGLE_PRECISION
 #define REAL(x) x ## f
+#define REAL_MIN    FLT_MIN     // Needs <float.h>
 #else
 #define REAL(x) x
+#define REAL_MIN    DBL_MIN     // Needs <float.h>
 #endif
 
 #define SIN         REAL(sin)
@@ -30,10 +141,13 @@
 typedef NS(real)            real;
 typedef NS(DecYear)         DecYear;
 typedef NS(DateTime)        DateTime;
+typedef NS(YearCache)       YearCache;
 typedef NS(Coords)          Coords;
 typedef NS(SphericalCoords) SphericalCoords;
 typedef NS(EcefPosition)    EcefPosition;
+typedef NS(GeocentricFrame) GeocentricFrame;
 typedef NS(FieldState)      FieldState;
+typedef NS(FieldRates)      FieldRates;
 
 // General utility functions
 
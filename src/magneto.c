@@ -12,6 +12,7 @@ const real magneto_WGS84_B = REAL(6356752.314245);
 const real magneto_WGS84_F = (real) (1000000000.0 / 298257223563LL);
 const real magneto_WGS84_F_INV = (real) (298257223563LL / 1000000000.0);
 const real magneto_WGS84_E_SQ = (magneto_WGS84_F * (2 - magneto_WGS84_F));
+const real magneto_GEOMAG_REF_RADIUS = REAL(6371200.0);
 
 static const real RAD_PER_DEG = REAL(0.017453292519943295769);
 static const real DEG_PER_RAD = REAL(57.29577951308232087680);
@@ -34,6 +35,17 @@ static const uint16_t DAYS_IN_YEAR = 365U;  ///< Not in a leap year
 /// Cumulative number of days in year at start of month, index by month (0 is unused)
 static const uint16_t DAY_PER_MONTH[13U] = { 0U, 0U, 31U, 59U, 90U, 120U, 151U, 181U, 212U, 243U, 273U, 304U, 334U };
 
+static const double SEC_PER_DAY = 86400.0;
+static const double SEC_PER_WEEK = 604800.0;
+/// [s] Start of GPS time, 1980-01-06 00:00:00 UTC, since the Unix epoch
+static const double GPS_EPOCH_UNIX = 315964800.0;
+/// [day] Days from 0001-01-01 to the Unix epoch, in the proleptic Gregorian calendar
+static const int64_t UNIX_EPOCH_DAYS = 719162;
+static const double INV_SEC_PER_YEAR = 1.0 / (365.0 * 86400.0);
+static const double INV_SEC_PER_LEAP_YEAR = 1.0 / (366.0 * 86400.0);
+/// [day] Mean length of a Gregorian year
+static const double MEAN_DAYS_IN_YEAR = 365.2425;
+
 real magneto_rad_to_deg(const real rad) {
     return rad * DEG_PER_RAD;
 }
@@ -111,6 +123,82 @@ DecYear magneto_DecYear_from_date_time(const DateTime t) {
     };
 }
 
+/// Days from the Unix epoch to January 1st of `year`, assumes `year` is positive
+static int64_t days_before_year(const int64_t year) {
+    const int64_t y = year - 1;
+    return (365 * y) + (y / 4) - (y / 100) + (y / 400) - UNIX_EPOCH_DAYS;
+}
+
+/// Find the valid year containing `seconds` since the Unix epoch, only updating `cache` if found
+static bool find_unix_year(const double seconds, YearCache *const cache) {
+    // Also rejects NaN, before it's converted to an integer
+    const double min_seconds = (double) days_before_year(YEAR_MIN) * SEC_PER_DAY;
+    const double max_seconds = (double) days_before_year(YEAR_MAX + 1) * SEC_PER_DAY;
+    if (!((min_seconds <= seconds) && (seconds < max_seconds))) {
+        return false;
+    }
+    const int64_t days = (int64_t) floor(seconds / SEC_PER_DAY);
+    // Mean year length is within a day of any real calendar, so at most one step off
+    int64_t year = 1970 + (int64_t) floor((double) days / MEAN_DAYS_IN_YEAR);
+    int64_t start = days_before_year(year);
+    if (days < start) {
+        --year;
+        start = days_before_year(year);
+    }
+    int64_t end = days_before_year(year + 1);
+    if (days >= end) {
+        ++year;
+        start = end;
+        end = days_before_year(year + 1);
+    }
+    cache->start = (double) start * SEC_PER_DAY;
+    cache->end = (double) end * SEC_PER_DAY;
+    cache->year = (double) year;
+    cache->inv_length = ((end - start) > DAYS_IN_YEAR) ? INV_SEC_PER_LEAP_YEAR : INV_SEC_PER_YEAR;
+    return true;
+}
+
+DecYear magneto_DecYear_from_unix(const double seconds) {
+    YearCache cache = { 0.0, 0.0, 0.0, 0.0 };
+    return magneto_DecYear_from_unix_cached(&cache, seconds);
+}
+
+DecYear magneto_DecYear_from_unix_cached(YearCache *const cache, const double seconds) {
+    if (cache == NULL) {
+        return magneto_DecYear_from_unix(seconds);
+    }
+    if (!((cache->start <= seconds) && (seconds < cache->end)) && !find_unix_year(seconds, cache)) {
+        return (DecYear) { .year = REAL(0.0) };
+    }
+    return (DecYear) {
+        .year = (real) (cache->year + ((seconds - cache->start) * cache->inv_length))
+    };
+}
+
+DecYear magneto_DecYear_from_gps(const uint32_t week, const double seconds) {
+    return magneto_DecYear_from_unix(GPS_EPOCH_UNIX + ((double) week * SEC_PER_WEEK) + seconds);
+}
+
+void magneto_DecYear_from_unix_batch(const size_t count, const double *const seconds, DecYear *const out) {
+    if ((count == 0U) || (seconds == NULL) || (out == NULL)) {
+        return;
+    }
+    // Assume every point is in the year of the first, so the loop is branch-free
+    YearCache cache = { 0.0, 0.0, 0.0, 0.0 };
+    find_unix_year(seconds[0], &cache);
+    for (size_t i = 0U; i < count; ++i) {
+        out[i].year = (real) (cache.year + ((seconds[i] - cache.start) * cache.inv_length));
+    }
+    // Then redo any outside it, with the calendar math only as often as the year changes.
+    // Kept as a separate loop, since the range check stops the first from vectorizing.
+    YearCache other = cache;
+    for (size_t i = 0U; i < count; ++i) {
+        if (!((cache.start <= seconds[i]) && (seconds[i] < cache.end))) {
+            out[i] = magneto_DecYear_from_unix_cached(&other, seconds[i]);
+        }
+    }
+}
+
 Coords magneto_Coords_from_spherical(const SphericalCoords pos) {
     const EcefPosition ecef = magneto_EcefPosition_from_spherical(pos);
     return magneto_Coords_from_ecef(ecef);
@@ -136,8 +224,7 @@ Coords magneto_Coords_from_ecef(const EcefPosition pos) {
     const real u = (p / SQRT(q));
     const real v = sq(magneto_WGS84_B * u) / q;
     const real P = (27 * v * s / q);
-    // TODO: Use `sq(cbrt(...))` for better precision
-    const real Q = REAL(pow)(SQRT(P + 1) + SQRT(P), (REAL(2.0) / 3));
+    const real Q = sq(REAL(cbrt)(SQRT(P + 1) + SQRT(P)));
     if (Q == REAL(0.0)) {
         return coords;
     }
@@ -160,21 +247,116 @@ Coords magneto_Coords_from_ecef(const EcefPosition pos) {
     return coords;
 }
 
+Coords magneto_Coords_from_ecef_fast(const EcefPosition pos) {
+    Coords coords = { 0 };
+
+    // Vermeille's closed form (J. Geodesy, 2011), arranged as in GeographicLib (Karney) to avoid
+    // cancellation, so it's exact up to rounding without iterating, including near the centre
+    const real e_sq = magneto_WGS84_E_SQ;
+    const real e_4 = sq(e_sq);
+    const real one_minus_e_sq = 1 - e_sq;
+    const real rho_sq = sq(pos.x) + sq(pos.y);
+    const real rho = SQRT(rho_sq);
+    const real p = rho_sq / sq(magneto_WGS84_A);
+    const real q = one_minus_e_sq * sq(pos.z / magneto_WGS84_A);
+    const real r = (p + q - e_4) / 6;
+
+    real phi = 0;
+    if (!((e_4 * q == 0) && (r <= 0))) {
+        // Multiplied through by powers of r, which may be zero
+        const real S = e_4 * p * q / 4;
+        const real r_sq = sq(r);
+        const real r_cb = r * r_sq;
+        const real disc = S * ((2 * r_cb) + S);
+        real u = r;
+        if (disc >= 0) {
+            // Sign of the root maximizes |T3|, which avoids cancellation
+            real T3 = S + r_cb;
+            T3 += (T3 < 0) ? -SQRT(disc) : SQRT(disc);
+            const real T = REAL(cbrt)(T3);
+            u += T + ((T != 0) ? (r_sq / T) : 0);
+        } else {
+            // Inside the evolute near the centre, the real root of 3 complex ones
+            const real angle = REAL(atan2)(SQRT(-disc), -(S + r_cb));
+            u += 2 * r * COS(angle / 3);
+        }
+        const real v = SQRT(sq(u) + (e_4 * q));
+        const real uv = (u < 0) ? ((e_4 * q) / (v - u)) : (u + v);
+        const real w_raw = e_sq * (uv - q) / (2 * v);
+        const real w = (w_raw > 0) ? w_raw : 0;
+        const real k = uv / (SQRT(uv + sq(w)) + w);
+        const real k_plus_e_sq = k + e_sq;
+        const real d = k * rho / k_plus_e_sq;
+        // Same as `atan2(z / k, rho / (k + e^2))`, as `k` is positive
+        phi = REAL(atan2)(pos.z * k_plus_e_sq, rho * k);
+        coords.height = (1 - (one_minus_e_sq / k)) * SQRT(sq(d) + sq(pos.z));
+    } else {
+        // On the equatorial plane inside the evolute, take the limit as z -> 0
+        const real z_limit_sq = (e_4 - p) / one_minus_e_sq;
+        const real z_limit = SQRT(z_limit_sq);
+        phi = REAL(atan2)((pos.z < 0) ? -z_limit : z_limit, SQRT(p));
+        coords.height = -magneto_WGS84_A * one_minus_e_sq * SQRT(z_limit_sq + p) / e_sq;
+    }
+
+    coords.latitude = rad_to_deg(phi);
+    coords.longitude = rad_to_deg(REAL(atan2)(pos.y, pos.x));
+    return coords;
+}
+
+void magneto_Coords_from_ecef_fast_batch(
+    const size_t count,
+    const magneto_real *const x,
+    const magneto_real *const y,
+    const magneto_real *const z,
+    magneto_real *const latitude,
+    magneto_real *const longitude,
+    magneto_real *const height
+) {
+    if ((x == NULL) || (y == NULL) || (z == NULL) || (latitude == NULL) || (longitude == NULL) || (height == NULL)) {
+        return;
+    }
+    for (size_t i = 0U; i < count; ++i) {
+        const EcefPosition pos = { x[i], y[i], z[i] };
+        const Coords coords = magneto_Coords_from_ecef_fast(pos);
+        latitude[i] = coords.latitude;
+        longitude[i] = coords.longitude;
+        height[i] = coords.height;
+    }
+}
+
 SphericalCoords magneto_SphericalCoords_from_coords(const Coords pos) {
-    SphericalCoords spherical = { 0 };
+    return magneto_GeocentricFrame_from_coords(pos).spherical;
+}
 
-    const Coords pos_with_no_lon = {
-        .latitude = pos.latitude,
-        .longitude = 0,
-        .height = pos.height
-    };
-    const EcefPosition ecef_no_lon = magneto_EcefPosition_from_coords(pos_with_no_lon);
-    const SphericalCoords partial_no_azi = magneto_SphericalCoords_from_ecef(ecef_no_lon);
+GeocentricFrame magneto_GeocentricFrame_from_coords(const Coords pos) {
+    GeocentricFrame frame = { 0 };
 
-    spherical.radius = partial_no_azi.radius;
-    spherical.polar = partial_no_azi.polar;
-    spherical.azimuth = pos.longitude;
-    return spherical;
+    const real lat = deg_to_rad(pos.latitude);
+    const real sin_lat = SIN(lat);
+    const real cos_lat = COS(lat);
+    const real denom = SQRT(1 - magneto_WGS84_E_SQ * sq(sin_lat));
+    if (denom == REAL(0.0)) {
+        return frame;
+    }
+    const real R_c = (magneto_WGS84_A / denom);  // Radius of curvature
+
+    // Same as the ECEF position in the meridian plane, with distance from the axis `p`
+    const real p = (R_c + pos.height) * cos_lat;
+    const real z = (R_c * (1 - magneto_WGS84_E_SQ) + pos.height) * sin_lat;
+    const real r = HYPOT(p, z);
+    if (r == REAL(0.0)) {
+        return frame;
+    }
+    frame.sin_polar = z / r;
+    frame.cos_polar = p / r;
+    frame.spherical.radius = r;
+    frame.spherical.polar = rad_to_deg(REAL(atan2)(z, p));
+    frame.spherical.azimuth = pos.longitude;
+
+    // Angle differences from the sines & cosines of both latitudes
+    frame.sin_eps = (sin_lat * frame.cos_polar) - (cos_lat * frame.sin_polar);
+    frame.cos_eps = (cos_lat * frame.cos_polar) + (sin_lat * frame.sin_polar);
+    return frame;
 }
 
 SphericalCoords  magneto_SphericalCoords_from_ecef(const EcefPosition pos) {
@@ -243,6 +425,57 @@ FieldState magneto_FieldState_from_ned(const real *const B_ned) {
     return field;
 }
 
+FieldRates magneto_FieldRates_from_ned(const real *const B_ned, const real *const B_ned_dot) {
+    FieldRates rates = { 0 };
+    if ((B_ned == NULL) || (B_ned_dot == NULL)) {
+        return rates;
+    }
+    rates.B_ned[0] = B_ned_dot[0];
+    rates.B_ned[1] = B_ned_dot[1];
+    rates.B_ned[2] = B_ned_dot[2];
+
+    // Derivatives of the same expressions as `magneto_FieldState_from_ned`
+    const real H = HYPOT(B_ned[0], B_ned[1]);
+    const real F = HYPOT(H, B_ned[2]);
+    if (H > 0) {
+        rates.H = ((B_ned[0] * B_ned_dot[0]) + (B_ned[1] * B_ned_dot[1])) / H;
+        rates.D = rad_to_deg(((B_ned[0] * B_ned_dot[1]) - (B_ned[1] * B_ned_dot[0])) / sq(H));
+    }
+    if (F > 0) {
+        rates.F = ((H * rates.H) + (B_ned[2] * B_ned_dot[2])) / F;
+        rates.I = rad_to_deg(((H * B_ned_dot[2]) - (B_ned[2] * rates.H)) / sq(F));
+    }
+    return rates;
+}
+
+// Batched conversions are simple loops, which keeps each scalar conversion inlinable
+#define DEFINE_BATCH_CONVERSION(name, In, Out) \
+    void name##_batch(const size_t count, const In *const in, Out *const out) { \
+        if ((in == NULL) || (out == NULL)) { \
+            return; \
+        } \
+        for (size_t i = 0U; i < count; ++i) { \
+            out[i] = name(in[i]); \
+        } \
+    }
+
+DEFINE_BATCH_CONVERSION(magneto_Coords_from_spherical, SphericalCoords, Coords)
+DEFINE_BATCH_CONVERSION(magneto_Coords_from_ecef, EcefPosition, Coords)
+DEFINE_BATCH_CONVERSION(magneto_SphericalCoords_from_coords, Coords, SphericalCoords)
+DEFINE_BATCH_CONVERSION(magneto_SphericalCoords_from_ecef, EcefPosition, SphericalCoords)
+DEFINE_BATCH_CONVERSION(magneto_EcefPosition_from_coords, Coords, EcefPosition)
+DEFINE_BATCH_CONVERSION(magneto_EcefPosition_from_spherical, SphericalCoords, EcefPosition)
+DEFINE_BATCH_CONVERSION(magneto_GeocentricFrame_from_coords, Coords, GeocentricFrame)
+
+void magneto_FieldState_from_ned_batch(const size_t count, const real *const B_ned, FieldState *const out) {
+    if ((B_ned == NULL) || (out == NULL)) {
+        return;
+    }
+    for (size_t i = 0U; i < count; ++i) {
+        out[i] = magneto_FieldState_from_ned(&B_ned[3U * i]);
+    }
+}
+
 void magneto_convert_vector_ned_to_ecef(
     const magneto_Coords pos,
     const magneto_real *const ned,
@@ -277,6 +510,34 @@ void magneto_convert_vector_ecef_to_ned(
     ned[2] = (A_T[2] * ecef[0]) + (A_T[5] * ecef[1]) + (A_T[8] * ecef[2]);
 }
 
+void magneto_convert_vector_ned_to_ecef_batch(
+    const size_t count,
+    const magneto_Coords *const pos,
+    const magneto_real *const ned,
+    magneto_real *const ecef
+) {
+    if ((pos == NULL) || (ned == NULL) || (ecef == NULL)) {
+        return;
+    }
+    for (size_t i = 0U; i < count; ++i) {
+        magneto_convert_vector_ned_to_ecef(pos[i], &ned[3U * i], &ecef[3U * i]);
+    }
+}
+
+void magneto_convert_vector_ecef_to_ned_batch(
+    const size_t count,
+    const magneto_Coords *const pos,
+    const magneto_real *const ecef,
+    magneto_real *const ned
+) {
+    if ((pos == NULL) || (ecef == NULL) || (ned == NULL)) {
+        return;
+    }
+    for (size_t i = 0U; i < count; ++i) {
+        magneto_convert_vector_ecef_to_ned(pos[i], &ecef[3U * i], &ned[3U * i]);
+    }
+}
+
 void magneto_matrix_ned_to_ecef(const Coords pos, real *const matrix) {
     if (matrix == NULL) {
         return;
@@ -1,101 +1,318 @@
 #include "magneto/model.h"
 
+#include <float.h>
 #include <math.h>
 #include <stdbool.h>
 #include <stddef.h>
 
-#include <stdio.h>
-
 #include "common_private.h"
-
-static inline real calc_K(const real n, const real m) {
-    if (n <= 1U) {
-        return 0;
-    }
-    return (sq(n - 1) - sq(m)) / (((2 * n) - 1) * ((2 * n) - 3));
-}
+#include "model_private.h"
+#include "trace_private.h"
 
 static void rotate_vector_spherical_to_ned(
-    const Coords pos,
-    const SphericalCoords pos_sph,
+    const GeocentricFrame *const frame,
     const SphericalCoords B_spherical,
     real *const B_ned
 ) {
     const real B_r = B_spherical.radius;
     const real B_theta = B_spherical.azimuth;
     const real B_phi = B_spherical.polar;
-    const real eps = deg_to_rad(pos_sph.polar - pos.latitude);
-    const real sin_eps = SIN(eps);
-    const real cos_eps = COS(eps);
+    const real sin_eps = frame->sin_eps;
+    const real cos_eps = frame->cos_eps;
     B_ned[0] = (-B_theta * cos_eps) - (B_r * sin_eps);
     B_ned[1] = B_phi;
     B_ned[2] = (B_theta * sin_eps) - (B_r * cos_eps);
 }
 
+/// Sine & cosine of the co-latitude theta, which the expansion is in terms of
+typedef struct {
+    real sin_theta;
+    real cos_theta;
+} CoLatitude;
+
+/// Theta is the co-latitude, so its sine and cosine are swapped w.r.t. the polar angle
+static inline CoLatitude calc_co_latitude(const GeocentricFrame *const frame) {
+    const CoLatitude theta = { frame->cos_polar, frame->sin_polar };
+    return theta;
+}
+
 static inline void calc_g_and_h(
     const magneto_Model *const model,
+    const magneto_SphericalHarmonicTerm *const terms_m,
     const size_t i_model,
     const magneto_real t,
     const size_t n,
     const size_t m,
     real *const g_n_m,
-    real *const h_n_m
+    real *const h_n_m,
+    real *const g_dot_n_m,
+    real *const h_dot_n_m
 ) {
-    const magneto_SphericalHarmonicCoeff *const coeffs_i = model->models[i_model].coeffs;
-    const bool is_last_submodel = ((i_model + 1U) >= model->num_models);
-    const size_t idx_coeff = MAGNETO_CALC_INDEX(n, m);
+    real g = 0;
+    real h = 0;
+    calc_g_and_h_rates(model, terms_m, i_model, n, m, &g, &h, g_dot_n_m, h_dot_n_m);
+
+    *g_n_m = (g + (t * *g_dot_n_m));
+    *h_n_m = (h + (t * *h_dot_n_m));
+}
 
-    printf("(%d, %d) -> %d\n", (int) n, (int) m, (int) idx_coeff);
+// Scale applied to every Legendre function in the Schmidt recursion, which leaves room for
+// their growth towards the poles at high degree without overflowing
+#ifdef MAGNETO_SINGLE_PRECISION
+#define SCHMIDT_SCALE       REAL(1e-30)
+#define SCHMIDT_INV_SCALE   REAL(1e30)
+#else
+#define SCHMIDT_SCALE       REAL(1e-280)
+#define SCHMIDT_INV_SCALE   REAL(1e280)
+#endif
 
-    real g_dot = 0;
-    real h_dot = 0;
-    if (is_last_submodel) {
-        g_dot = model->last_secular.coeffs[idx_coeff].g;
-        h_dot = model->last_secular.coeffs[idx_coeff].h;
+// Number of degrees ahead to prefetch coefficients in the Schmidt recursion
+#define SCHMIDT_PREFETCH_DISTANCE   (8U)
+
+/// Ratio sqrt((2k - 1) / 2k) of consecutive scaled sectoral functions P_{k,k} / sin(theta)^k,
+/// from the model's table of roots if it has one
+static inline real calc_sectoral_ratio(const magneto_SquareRoot *const roots, const size_t k) {
+    if (roots != NULL) {
+        return roots[(2U * k) - 1U].root * roots[2U * k].inv_root;
+    }
+    return SQRT((real) ((2U * k) - 1U) / (real) (2U * k));
+}
+
+/// Factor sqrt((n - m)(n + m)) of the Schmidt recursion & its reciprocal, from the model's
+/// table of roots if it has one, which saves a square root & division per term
+static inline void calc_schmidt_root(
+    const magneto_SquareRoot *const roots,
+    const size_t n,
+    const size_t m,
+    real *const root,
+    real *const inv_root
+) {
+    if (roots != NULL) {
+        *root = roots[n - m].root * roots[n + m].root;
+        *inv_root = roots[n - m].inv_root * roots[n + m].inv_root;
     } else {
-        const magneto_SphericalHarmonicCoeff *const coeffs_next = model->models[i_model + 1U].coeffs;
-        g_dot = (coeffs_next[idx_coeff].g - coeffs_i[idx_coeff].g) / model->model_interval.year;
-        h_dot = (coeffs_next[idx_coeff].h - coeffs_i[idx_coeff].h) / model->model_interval.year;
+        *root = SQRT((real) (n - m) * (real) (n + m));
+        *inv_root = 1 / *root;
+    }
+}
+
+/// Same as `eval_spherical_expansion`, but stable for high-degree Schmidt normalized models
+///
+/// Uses the modified forward column method (Holmes & Featherstone, 2002). The recursion
+/// runs on P_{n,m} / sin(theta)^m & dP_{n,m}/dtheta / sin(theta)^(m-1), which neither
+/// underflow near the poles nor at high order, and are scaled by `SCHMIDT_SCALE` so they
+/// can't overflow either. The powers of sin(theta) are put back by summing over orders
+/// in Horner's scheme from the highest order down, so the sectoral terms, trig & radial
+/// terms are all stepped downwards. This also removes the division by sin(theta) of B_phi.
+static void eval_spherical_expansion_schmidt(
+    const magneto_Model *const model,
+    const size_t nm_max,
+    const size_t i_model,
+    const real t,
+    const real *const snapshot,
+    const GeocentricFrame *const pos,
+    SphericalCoords *const B_spherical,
+    SphericalCoords *const B_spherical_dot
+) {
+    const CoLatitude theta = calc_co_latitude(pos);
+    const real phi = deg_to_rad(pos->spherical.azimuth);
+    const real sin_theta = theta.sin_theta;
+    const real cos_theta = theta.cos_theta;
+    const real sin_phi = SIN(phi);
+    const real cos_phi = COS(phi);
+    const real normed_r = (magneto_GEOMAG_REF_RADIUS / pos->spherical.radius);
+    const real inv_normed_r = (pos->spherical.radius / magneto_GEOMAG_REF_RADIUS);
+
+    const magneto_SquareRoot *const roots = model->roots;
+
+    // Scaled sectoral P_{m,m} / sin(theta)^m, trig & (a/r)^(m+2) at the highest order
+    real P_m_m = SCHMIDT_SCALE;
+    real r_m = normed_r * normed_r;
+    for (size_t k = 1U; k <= nm_max; ++k) {
+        if (k > 1U) {
+            P_m_m *= calc_sectoral_ratio(roots, k);
+        }
+        r_m *= normed_r;
+    }
+    real cos_mphi = COS((real) nm_max * phi);
+    real sin_mphi = SIN((real) nm_max * phi);
+
+    // Horner accumulators in sin(theta), B_r carries sin(theta)^m & the others sin(theta)^(m-1)
+    real B_r = 0;
+    real B_theta = 0;
+    real B_phi = 0;
+    real B_r_dot = 0;
+    real B_theta_dot = 0;
+    real B_phi_dot = 0;
+
+    for (size_t i_order = 0U; i_order <= nm_max; ++i_order) {
+        const size_t m = nm_max - i_order;
+        const real m_real = (real) m;
+        const magneto_SphericalHarmonicTerm *const terms_m = find_order_terms(model, i_model, m);
+        // Derivative of order 0 isn't scaled by 1 / sin(theta), so it only needs one power
+        const real sin_theta_pow = (m > 0U) ? (sin_theta * sin_theta) : sin_theta;
+
+        real P_nprev_m = P_m_m;
+        real P_nprevprev_m = 0;
+        real dP_nprev_m = m_real * cos_theta * P_m_m;
+        real dP_nprevprev_m = 0;
+        real root_nprev = 0;    // sqrt((n - 1)^2 - m^2)
+        real r_scalar = r_m;
+
+        real sum_r = 0;
+        real sum_theta = 0;
+        real sum_phi = 0;
+        real sum_r_dot = 0;
+        real sum_theta_dot = 0;
+        real sum_phi_dot = 0;
+        for (size_t n = m; n <= nm_max; ++n) {
+            if (n > m) {
+                const real n_real = (real) n;
+                real root_n = 0;
+                real inv_root_n = 0;
+                calc_schmidt_root(roots, n, m, &root_n, &inv_root_n);
+                const real a = ((2 * n_real) - 1) * inv_root_n;
+                const real b = root_nprev * inv_root_n;
+                // Multiply the constants first, which keeps them off the recursion's critical path
+                const real a_cos = a * cos_theta;
+                const real a_sin = a * sin_theta_pow;
+                const real P_n_m = (a_cos * P_nprev_m) - (b * P_nprevprev_m);
+                const real dP_n_m = (a_cos * dP_nprev_m) - (a_sin * P_nprev_m) - (b * dP_nprevprev_m);
+                P_nprevprev_m = P_nprev_m;
+                P_nprev_m = P_n_m;
+                dP_nprevprev_m = dP_nprev_m;
+                dP_nprev_m = dP_n_m;
+                root_nprev = root_n;
+                r_scalar *= normed_r;
+            }
+            if (n == 0U) {
+                continue;
+            }
+
+            real g_n_m = 0;
+            real h_n_m = 0;
+            real g_dot_n_m = 0;
+            real h_dot_n_m = 0;
+            if (snapshot != NULL) {
+                const size_t idx_coeff = MAGNETO_CALC_INDEX(n, m);
+                g_n_m = snapshot[2U * idx_coeff];
+                h_n_m = snapshot[(2U * idx_coeff) + 1U];
+            } else {
+                // Terms of an order are strided in the degree-major tables, so fetch them well ahead
+                if ((terms_m == NULL) && ((n + SCHMIDT_PREFETCH_DISTANCE) <= nm_max)) {
+                    const size_t idx_ahead = MAGNETO_CALC_INDEX(n + SCHMIDT_PREFETCH_DISTANCE, m);
+                    PREFETCH(&model->models[i_model].coeffs[idx_ahead]);
+                    PREFETCH(&model->last_secular.coeffs[idx_ahead]);
+                }
+                calc_g_and_h(model, terms_m, i_model, t, n, m, &g_n_m, &h_n_m, &g_dot_n_m, &h_dot_n_m);
+            }
+            const real gc_hs = (g_n_m * cos_mphi) + (h_n_m * sin_mphi);
+            const real gs_hc = (-g_n_m * sin_mphi) + (h_n_m * cos_mphi);
+            sum_r += ((real) (n + 1U) * r_scalar * gc_hs * P_nprev_m);
+            sum_theta += (r_scalar * gc_hs * dP_nprev_m);
+            sum_phi += (r_scalar * gs_hc * P_nprev_m);
+            if (B_spherical_dot != NULL) {
+                const real gc_hs_dot = (g_dot_n_m * cos_mphi) + (h_dot_n_m * sin_mphi);
+                const real gs_hc_dot = (-g_dot_n_m * sin_mphi) + (h_dot_n_m * cos_mphi);
+                sum_r_dot += ((real) (n + 1U) * r_scalar * gc_hs_dot * P_nprev_m);
+                sum_theta_dot += (r_scalar * gc_hs_dot * dP_nprev_m);
+                sum_phi_dot += (r_scalar * gs_hc_dot * P_nprev_m);
+            }
+        }
+
+        B_r = (B_r * sin_theta) + sum_r;
+        B_r_dot = (B_r_dot * sin_theta) + sum_r_dot;
+        if (m > 0U) {
+            B_theta = (B_theta * sin_theta) + sum_theta;
+            B_phi = (B_phi * sin_theta) + (m_real * sum_phi);
+            B_theta_dot = (B_theta_dot * sin_theta) + sum_theta_dot;
+            B_phi_dot = (B_phi_dot * sin_theta) + (m_real * sum_phi_dot);
+
+            // Step down to the next order
+            if (m > 1U) {
+                P_m_m /= calc_sectoral_ratio(roots, m);
+            }
+            const real sin_mnext_phi = sin_mphi;
+            sin_mphi = (sin_mnext_phi * cos_phi) - (cos_mphi * sin_phi);
+            cos_mphi = (cos_mphi * cos_phi) + (sin_mnext_phi * sin_phi);
+            r_m *= inv_normed_r;
+        } else {
+            B_theta += sum_theta;
+            B_theta_dot += sum_theta_dot;
+        }
     }
 
-    *g_n_m = (coeffs_i->g + (t * g_dot));
-    *h_n_m = (coeffs_i->h + (t * h_dot));
+    B_spherical->radius = B_r * SCHMIDT_INV_SCALE;
+    B_spherical->azimuth = -B_theta * SCHMIDT_INV_SCALE;
+    B_spherical->polar = -B_phi * SCHMIDT_INV_SCALE;
+    if (B_spherical_dot != NULL) {
+        B_spherical_dot->radius = B_r_dot * SCHMIDT_INV_SCALE;
+        B_spherical_dot->azimuth = -B_theta_dot * SCHMIDT_INV_SCALE;
+        B_spherical_dot->polar = -B_phi_dot * SCHMIDT_INV_SCALE;
+    }
 }
 
 /// Compute vector as gradient of spherical harmonic potential expansion
 ///
 /// @todo There is definitely some additional optimization to be had here.
-///       Need to get some basic benchmarking set up and test out some stuff.
+///       Measure any changes with the `magneto_bench` target.
 ///
 /// @param[in]  model           Spherical harmonic model and coefficients
+/// @param[in]  nm_max          Highest degree to sum, at most the model's
 /// @param[in]  i_model         Index of which sub-model to use
 /// @param[in]  t               Time delta into i-th sub-model in years
+/// @param[in]  snapshot        Interleaved {g, h} already interpolated to `t`, or `NULL`
 /// @param[in]  pos             Geocentric spherical coordinates
 /// @param[out] B_spherical     Output vector in spherical reference frame
+/// @param[out] B_spherical_dot Rate of change of the output vector per year, or `NULL` to skip.
+///                             Must be `NULL` with a snapshot, which has no rates.
 static void eval_spherical_expansion(
     const magneto_Model *const model,
+    const size_t nm_max,
     const size_t i_model,
     const real t,
-    const SphericalCoords pos,
-    SphericalCoords *const B_spherical
+    const real *const snapshot,
+    const GeocentricFrame *const pos,
+    SphericalCoords *const B_spherical,
+    SphericalCoords *const B_spherical_dot
 ) {
-    const real theta = deg_to_rad(pos.azimuth);
-    const real phi = deg_to_rad(pos.polar);
-    const real sin_theta = SIN(theta);
-    const real cos_theta = COS(theta);
-    const real normed_r = (magneto_WGS84_A / pos.radius);
+    if (model->normalization == magneto_NORMALIZATION_SCHMIDT) {
+        eval_spherical_expansion_schmidt(model, nm_max, i_model, t, snapshot, pos, B_spherical, B_spherical_dot);
+        return;
+    }
+
+    const CoLatitude theta = calc_co_latitude(pos);
+    const real phi = deg_to_rad(pos->spherical.azimuth);
+    const real sin_theta = theta.sin_theta;
+    const real cos_theta = theta.cos_theta;
+    const real sin_phi = SIN(phi);
+    const real cos_phi = COS(phi);
+    const real normed_r = (magneto_GEOMAG_REF_RADIUS / pos->spherical.radius);
 
     // Output vector
     real B_r = 0;       ///< Bz
     real B_theta = 0;   ///< Bx
     real B_phi = 0;     ///< By
 
+    // Rate of change of the output vector, summed from the same terms
+    real B_r_dot = 0;
+    real B_theta_dot = 0;
+    real B_phi_dot = 0;
+
     // Recursive values for P_{n,m} and dP_{n,m}/dtheta
     real P_n_n = 1;
     real dP_n_n = 0;
 
+    // Recursive values for sin(m*phi) and cos(m*phi) by angle addition
+    real sin_mphi = 0;
+    real cos_mphi = 1;
+
+    // Recursive value for (a/r)^(n+2) at the first degree of each order
+    real r_m = normed_r * normed_r * normed_r;
+
     // Compute Gaussian normalized associated Legendre polynomials recursively
-    for (size_t m = 0U; m <= model->nm_max; ++m) {
+    for (size_t m = 0U; m <= nm_max; ++m) {
+        const magneto_SphericalHarmonicTerm *const terms_m = find_order_terms(model, i_model, m);
         const real P_nprev_nprev = P_n_n;
         const real dP_nprev_nprev = dP_n_n;
 
@@ -109,11 +326,27 @@ static void eval_spherical_expansion(
         real dP_nprev_m = 0;
         real dP_nprevprev_m = 0;
 
-        const real sin_mphi = SIN((real) m * phi);
-        const real cos_mphi = COS((real) m * phi);
+        // Compute sin(m*phi) and cos(m*phi), but skip first iter
+        if (m > 0U) {
+            const real sin_mprev_phi = sin_mphi;
+            sin_mphi = (sin_mprev_phi * cos_phi) + (cos_mphi * sin_phi);
+            cos_mphi = (cos_mphi * cos_phi) - (sin_mprev_phi * sin_phi);
+        }
+
+        // Order 0 & 1 both start at degree 1
+        if (m > 1U) {
+            r_m *= normed_r;
+        }
+        real r_nnext = r_m;
 
         // Condition is enforced by loop bounds: (m <= n)
-        for (size_t n = MAX_OF(m, 1U); n <= model->nm_max; ++n) {
+        for (size_t n = MAX_OF(m, 1U); n <= nm_max; ++n) {
+            TRACE_STAGE_BEGIN(legendre);
+
+            real K_n_m = 0;
+            real n_plus_1 = 0;
+            real m_real = 0;
+            calc_recursion_consts(model, n, m, &K_n_m, &n_plus_1, &m_real);
 
             // Default values for first iter, computed pre-loop
             real P_n_m = P_n_n;     // From  P_{n,n}
@@ -121,8 +354,6 @@ static void eval_spherical_expansion(
 
             // Skipping first iteration, otherwise compute P_{n,m} and dP_{n,m}
             if (n != m) {
-                const real K_n_m = calc_K((real) n, (real) m);
-
                 P_n_m = (cos_theta * P_nprev_m) - (K_n_m * P_nprevprev_m);
                 dP_n_m = (cos_theta * dP_nprev_m) - (sin_theta * P_nprev_m) - (K_n_m * dP_nprevprev_m);
             }
@@ -133,45 +364,975 @@ static void eval_spherical_expansion(
             dP_nprevprev_m = dP_nprev_m;
             dP_nprev_m = dP_n_m;
 
-            printf("P_{n=%zu}{m=%zu} = %.10f, dP = %f\n", n, m, P_n_m, dP_n_m);
+            TRACE_STAGE_END(legendre, magneto_TRACE_STAGE_LEGENDRE);
+
+            // Compute (a/r)^(n+2) for this degree and save recursive value for next iter
+            const real r_scalar = r_nnext;
+            r_nnext *= normed_r;
 
+            TRACE_STAGE_BEGIN(coeffs);
             real g_n_m = 0;
             real h_n_m = 0;
-            calc_g_and_h(model, i_model, t, n, m, &g_n_m, &h_n_m);
-
-            const real r_scalar = REAL(pow)(normed_r, (real) (n + 2U));
+            real g_dot_n_m = 0;
+            real h_dot_n_m = 0;
+            if (snapshot != NULL) {
+                const size_t idx_coeff = MAGNETO_CALC_INDEX(n, m);
+                g_n_m = snapshot[2U * idx_coeff];
+                h_n_m = snapshot[(2U * idx_coeff) + 1U];
+            } else {
+                calc_g_and_h(model, terms_m, i_model, t, n, m, &g_n_m, &h_n_m, &g_dot_n_m, &h_dot_n_m);
+            }
+            TRACE_STAGE_END(coeffs, magneto_TRACE_STAGE_COEFFS);
+            // Skip snapshot terms that don't contribute, recursion is already updated
+            if ((snapshot != NULL) && (g_n_m == 0) && (h_n_m == 0)) {
+                continue;
+            }
+            TRACE_TERM(n, m, P_n_m, dP_n_m, g_n_m, h_n_m);
 
-            B_r += (r_scalar * ((g_n_m * cos_mphi) + (h_n_m * sin_mphi)) * ((real) (n + 1U)) * P_n_m);
+            TRACE_STAGE_BEGIN(summation);
+            B_r += (r_scalar * ((g_n_m * cos_mphi) + (h_n_m * sin_mphi)) * n_plus_1 * P_n_m);
             B_theta -= (r_scalar * ((g_n_m * cos_mphi) + (h_n_m * sin_mphi)) * dP_n_m);
-            B_phi -= (r_scalar * ((real) m) * ((-g_n_m * sin_mphi) + (h_n_m + cos_mphi)) * P_n_m);
+            B_phi -= (r_scalar * m_real * ((-g_n_m * sin_mphi) + (h_n_m * cos_mphi)) * P_n_m);
+            if (B_spherical_dot != NULL) {
+                B_r_dot += (r_scalar * ((g_dot_n_m * cos_mphi) + (h_dot_n_m * sin_mphi)) * n_plus_1 * P_n_m);
+                B_theta_dot -= (r_scalar * ((g_dot_n_m * cos_mphi) + (h_dot_n_m * sin_mphi)) * dP_n_m);
+                B_phi_dot -= (r_scalar * m_real * ((-g_dot_n_m * sin_mphi) + (h_dot_n_m * cos_mphi)) * P_n_m);
+            }
+            TRACE_STAGE_END(summation, magneto_TRACE_STAGE_SUMMATION);
         }
     }
 
     if (sin_theta != 0) {
         B_phi /= sin_theta;
+        B_phi_dot /= sin_theta;
     }
     B_spherical->radius = B_r;
     B_spherical->azimuth = B_theta;
     B_spherical->polar = B_phi;
+    if (B_spherical_dot != NULL) {
+        B_spherical_dot->radius = B_r_dot;
+        B_spherical_dot->azimuth = B_theta_dot;
+        B_spherical_dot->polar = B_phi_dot;
+    }
 }
 
-magneto_FieldState eval_field(
+/// Evaluate field vector in the geodetic NED frame
+static void eval_field_ned(
     const magneto_Model *const model,
-    const magneto_DecYear t,
-    const magneto_Coords coords
+    const size_t i_model,
+    const real delta_t,
+    const real *const snapshot,
+    const Coords coords,
+    real *const B_ned,
+    real *const B_ned_dot
 ) {
-    const SphericalCoords sph = magneto_SphericalCoords_from_coords(coords);
-    const real delta_t = (t.year - model->epoch.year);
+    TRACE_STAGE_BEGIN(coords);
+    const GeocentricFrame frame = magneto_GeocentricFrame_from_coords(coords);
+    TRACE_STAGE_END(coords, magneto_TRACE_STAGE_COORDS);
 
     // Evaluate magnetic field model in spherical coordinates
     SphericalCoords B_spherical = { 0 };
-    eval_spherical_expansion(model, 0, delta_t, sph, &B_spherical);
+    SphericalCoords B_spherical_dot = { 0 };
+    eval_spherical_expansion(
+        model, model->nm_max, i_model, delta_t, snapshot, &frame, &B_spherical,
+        (B_ned_dot != NULL) ? &B_spherical_dot : NULL
+    );
 
     // Rotate magnetic field vector from geocentric to geodetic NED frame
+    TRACE_STAGE_BEGIN(rotation);
+    rotate_vector_spherical_to_ned(&frame, B_spherical, B_ned);
+    TRACE_STAGE_END(rotation, magneto_TRACE_STAGE_ROTATION);
+
+    // Position is fixed, so the rate of change rotates the same way
+    if (B_ned_dot != NULL) {
+        rotate_vector_spherical_to_ned(&frame, B_spherical_dot, B_ned_dot);
+    }
+}
+
+magneto_FieldState eval_field(
+    const magneto_Model *const model,
+    const magneto_DecYear t,
+    const magneto_Coords coords
+) {
+    const size_t i_model = find_sub_model(model, t.year).i_model;
+    const real delta_t = calc_sub_model_delta_t(model, i_model, t.year);
+
     real B_ned[3];
-    rotate_vector_spherical_to_ned(coords, sph, B_spherical, B_ned);
+    eval_field_ned(model, i_model, delta_t, NULL, coords, B_ned, NULL);
 
     // Compute other field quantities
     const FieldState B = magneto_FieldState_from_ned(B_ned);
     return B;
 }
+
+magneto_FieldState eval_field_with_rates(
+    const magneto_Model *const model,
+    const magneto_DecYear t,
+    const magneto_Coords coords,
+    magneto_FieldRates *const rates
+) {
+    const size_t i_model = find_sub_model(model, t.year).i_model;
+    const real delta_t = calc_sub_model_delta_t(model, i_model, t.year);
+
+    real B_ned[3];
+    real B_ned_dot[3];
+    eval_field_ned(model, i_model, delta_t, NULL, coords, B_ned, B_ned_dot);
+
+    if (rates != NULL) {
+        *rates = magneto_FieldRates_from_ned(B_ned, B_ned_dot);
+    }
+    const FieldState B = magneto_FieldState_from_ned(B_ned);
+    return B;
+}
+
+/// Lowest degree of `model` within the `options` at a radius ratio of `normed_r` = a/r
+static magneto_TruncationInfo calc_truncation(
+    const magneto_Model *const model,
+    const real normed_r,
+    const magneto_TruncationOptions *const options
+) {
+    const size_t nm_max = model->nm_max;
+    size_t max_degree = nm_max;
+    real tolerance = 0;
+    if (options != NULL) {
+        if ((options->max_degree > 0U) && (options->max_degree < nm_max)) {
+            max_degree = options->max_degree;
+        }
+        tolerance = options->tolerance;
+    }
+
+    magneto_TruncationInfo info = { max_degree, 0 };
+    if (model->degree_bounds == NULL) {
+        info.error_bound = (max_degree < nm_max) ? (real) HUGE_VAL : 0;
+        return info;
+    }
+
+    // Far from the Earth (a/r)^(n+2) of high-degree models underflows, so build it up from the
+    // dipole to the highest degree where it's still a normal number. Degrees above contribute
+    // nothing representable, and dividing back down from there keeps full precision.
+    size_t top_degree = 1U;
+    real r_pow = normed_r * normed_r * normed_r;
+    while ((top_degree < nm_max) && ((r_pow * normed_r) >= REAL_MIN)) {
+        r_pow *= normed_r;
+        ++top_degree;
+    }
+
+    // Drop degrees from the top while the bound on all dropped degrees is within tolerance,
+    // but always keep the dipole
+    const real inv_normed_r = 1 / normed_r;
+    real error_bound = 0;
+    size_t degree = nm_max;
+    for (; degree > 1U; --degree) {
+        real term = 0;
+        if (degree <= top_degree) {
+            term = model->degree_bounds[degree] * r_pow;
+            r_pow *= inv_normed_r;
+        }
+        if ((degree <= max_degree) && ((error_bound + term) > tolerance)) {
+            break;
+        }
+        error_bound += term;
+    }
+    info.degree = degree;
+    info.error_bound = error_bound;
+    return info;
+}
+
+magneto_FieldState eval_field_truncated(
+    const magneto_Model *const model,
+    const magneto_DecYear t,
+    const magneto_Coords coords,
+    const magneto_TruncationOptions *const options,
+    magneto_TruncationInfo *const info
+) {
+    if (model == NULL) {
+        const FieldState invalid = { 0 };
+        return invalid;
+    }
+    const GeocentricFrame frame = magneto_GeocentricFrame_from_coords(coords);
+    const magneto_TruncationInfo truncation = calc_truncation(
+        model, magneto_GEOMAG_REF_RADIUS / frame.spherical.radius, options
+    );
+    if (info != NULL) {
+        *info = truncation;
+    }
+
+    const size_t i_model = find_sub_model(model, t.year).i_model;
+    const real delta_t = calc_sub_model_delta_t(model, i_model, t.year);
+    SphericalCoords B_spherical = { 0 };
+    eval_spherical_expansion(model, truncation.degree, i_model, delta_t, NULL, &frame, &B_spherical, NULL);
+
+    real B_ned[3];
+    rotate_vector_spherical_to_ned(&frame, B_spherical, B_ned);
+    const FieldState B = magneto_FieldState_from_ned(B_ned);
+    return B;
+}
+
+/// Partial derivatives of the spherical field components w.r.t. each spherical coordinate
+typedef struct {
+    SphericalCoords d_radius;   ///< [nT/m]     d/dr
+    SphericalCoords d_theta;    ///< [nT/rad]   d/dtheta of co-latitude
+    SphericalCoords d_phi;      ///< [nT/rad]   d/dphi of longitude
+} SphericalGradient;
+
+/// Same as `eval_spherical_expansion` for Gauss normalized models, but also differentiates
+/// every component w.r.t. each spherical coordinate in the same pass
+///
+/// Second derivatives of the Legendre functions follow from differentiating the recursion
+/// for dP_{n,m}/dtheta once more, so no extra terms are evaluated. The radial derivative
+/// just scales each term by -(n + 2) / r & the longitudinal one swaps the trig terms.
+static void eval_spherical_expansion_gradient(
+    const magneto_Model *const model,
+    const size_t i_model,
+    const real t,
+    const GeocentricFrame *const pos,
+    SphericalCoords *const B_spherical,
+    SphericalGradient *const gradient
+) {
+    const CoLatitude theta = calc_co_latitude(pos);
+    const real phi = deg_to_rad(pos->spherical.azimuth);
+    const real sin_theta = theta.sin_theta;
+    const real cos_theta = theta.cos_theta;
+    const real sin_phi = SIN(phi);
+    const real cos_phi = COS(phi);
+    const real normed_r = (magneto_GEOMAG_REF_RADIUS / pos->spherical.radius);
+
+    // Sums of the output vector, the same as `eval_spherical_expansion`
+    real B_r = 0;
+    real B_theta = 0;
+    real B_phi = 0;
+
+    // Sums of the derivatives, w/o the factors of 1/r & 1/sin(theta) common to every term
+    real sum_r_r = 0;           // (n + 1)(n + 2) G P
+    real sum_theta_r = 0;       // (n + 2) G dP
+    real sum_phi_r = 0;         // (n + 2) m H P
+    real sum_r_theta = 0;       // (n + 1) G dP
+    real sum_theta_theta = 0;   // G ddP
+    real sum_phi_theta = 0;     // m H dP
+    real sum_r_phi = 0;         // (n + 1) m H P
+    real sum_phi_phi = 0;       // m^2 G P
+
+    // Recursive values for P_{n,m}, dP_{n,m}/dtheta and d^2P_{n,m}/dtheta^2
+    real P_n_n = 1;
+    real dP_n_n = 0;
+    real ddP_n_n = 0;
+
+    real sin_mphi = 0;
+    real cos_mphi = 1;
+    real r_m = normed_r * normed_r * normed_r;
+
+    for (size_t m = 0U; m <= model->nm_max; ++m) {
+        const magneto_SphericalHarmonicTerm *const terms_m = find_order_terms(model, i_model, m);
+        if (m > 0U) {
+            const real P_nprev_nprev = P_n_n;
+            const real dP_nprev_nprev = dP_n_n;
+            P_n_n = sin_theta * P_nprev_nprev;
+            dP_n_n = (sin_theta * dP_nprev_nprev) + (cos_theta * P_nprev_nprev);
+            ddP_n_n = (sin_theta * ddP_n_n) + (2 * cos_theta * dP_nprev_nprev) - (sin_theta * P_nprev_nprev);
+
+            const real sin_mprev_phi = sin_mphi;
+            sin_mphi = (sin_mprev_phi * cos_phi) + (cos_mphi * sin_phi);
+            cos_mphi = (cos_mphi * cos_phi) - (sin_mprev_phi * sin_phi);
+        }
+        if (m > 1U) {
+            r_m *= normed_r;
+        }
+        real r_nnext = r_m;
+
+        real P_nprev_m = 1;
+        real P_nprevprev_m = 0;
+        real dP_nprev_m = 0;
+        real dP_nprevprev_m = 0;
+        real ddP_nprev_m = 0;
+        real ddP_nprevprev_m = 0;
+
+        for (size_t n = MAX_OF(m, 1U); n <= model->nm_max; ++n) {
+            real K_n_m = 0;
+            real n_plus_1 = 0;
+            real m_real = 0;
+            calc_recursion_consts(model, n, m, &K_n_m, &n_plus_1, &m_real);
+
+            real P_n_m = P_n_n;
+            real dP_n_m = dP_n_n;
+            real ddP_n_m = ddP_n_n;
+            if (n != m) {
+                P_n_m = (cos_theta * P_nprev_m) - (K_n_m * P_nprevprev_m);
+                dP_n_m = (cos_theta * dP_nprev_m) - (sin_theta * P_nprev_m) - (K_n_m * dP_nprevprev_m);
+                ddP_n_m = (cos_theta * ddP_nprev_m) - (2 * sin_theta * dP_nprev_m) - (cos_theta * P_nprev_m)
+                    - (K_n_m * ddP_nprevprev_m);
+            }
+            P_nprevprev_m = P_nprev_m;
+            P_nprev_m = P_n_m;
+            dP_nprevprev_m = dP_nprev_m;
+            dP_nprev_m = dP_n_m;
+            ddP_nprevprev_m = ddP_nprev_m;
+            ddP_nprev_m = ddP_n_m;
+
+            const real r_scalar = r_nnext;
+            r_nnext *= normed_r;
+
+            real g_n_m = 0;
+            real h_n_m = 0;
+            real g_dot_n_m = 0;
+            real h_dot_n_m = 0;
+            calc_g_and_h(model, terms_m, i_model, t, n, m, &g_n_m, &h_n_m, &g_dot_n_m, &h_dot_n_m);
+
+            const real n_plus_2 = n_plus_1 + 1;
+            const real G = r_scalar * ((g_n_m * cos_mphi) + (h_n_m * sin_mphi));
+            const real mH = r_scalar * m_real * ((-g_n_m * sin_mphi) + (h_n_m * cos_mphi));
+            B_r += (G * n_plus_1 * P_n_m);
+            B_theta -= (G * dP_n_m);
+            B_phi -= (mH * P_n_m);
+
+            sum_r_r += (G * n_plus_1 * n_plus_2 * P_n_m);
+            sum_theta_r += (G * n_plus_2 * dP_n_m);
+            sum_phi_r += (mH * n_plus_2 * P_n_m);
+            sum_r_theta += (G * n_plus_1 * dP_n_m);
+            sum_theta_theta += (G * ddP_n_m);
+            sum_phi_theta += (mH * dP_n_m);
+            sum_r_phi += (mH * n_plus_1 * P_n_m);
+            sum_phi_phi += (G * m_real * m_real * P_n_m);
+        }
+    }
+
+    const real inv_r = 1 / pos->spherical.radius;
+    const real inv_sin_theta = (sin_theta != 0) ? (1 / sin_theta) : 0;
+    B_phi *= (sin_theta != 0) ? inv_sin_theta : 1;
+
+    B_spherical->radius = B_r;
+    B_spherical->azimuth = B_theta;
+    B_spherical->polar = B_phi;
+
+    gradient->d_radius.radius = -sum_r_r * inv_r;
+    gradient->d_radius.azimuth = sum_theta_r * inv_r;
+    gradient->d_radius.polar = sum_phi_r * inv_r * inv_sin_theta;
+    gradient->d_theta.radius = sum_r_theta;
+    gradient->d_theta.azimuth = -sum_theta_theta;
+    gradient->d_theta.polar = -(sum_phi_theta + (cos_theta * B_phi)) * inv_sin_theta;
+    gradient->d_phi.radius = sum_r_phi;
+    gradient->d_phi.azimuth = -sum_phi_theta;
+    gradient->d_phi.polar = sum_phi_phi * inv_sin_theta;
+}
+
+magneto_FieldState eval_field_with_gradient(
+    const magneto_Model *const model,
+    const magneto_DecYear t,
+    const magneto_Coords coords,
+    magneto_FieldGradient *const gradient
+) {
+    if ((model == NULL) || (model->normalization != magneto_NORMALIZATION_GAUSS)) {
+        const FieldState B = { 0 };
+        return B;
+    }
+    const size_t i_model = find_sub_model(model, t.year).i_model;
+    const real delta_t = calc_sub_model_delta_t(model, i_model, t.year);
+    const GeocentricFrame frame = magneto_GeocentricFrame_from_coords(coords);
+
+    SphericalCoords B_spherical = { 0 };
+    SphericalGradient sph_gradient;
+    eval_spherical_expansion_gradient(model, i_model, delta_t, &frame, &B_spherical, &sph_gradient);
+
+    real B_ned[3];
+    rotate_vector_spherical_to_ned(&frame, B_spherical, B_ned);
+
+    if (gradient != NULL) {
+        // Derivatives of the geocentric radius r & latitude psi w.r.t. geodetic latitude & height,
+        // from the cylindrical coordinates (p, z) of the point & the meridian radius of curvature
+        const real lat = deg_to_rad(coords.latitude);
+        const real sin_lat = SIN(lat);
+        const real cos_lat = COS(lat);
+        const real w_sq = 1 - (magneto_WGS84_E_SQ * sq(sin_lat));
+        const real R_n = magneto_WGS84_A / SQRT(w_sq);
+        const real R_m = (R_n * (1 - magneto_WGS84_E_SQ)) / w_sq;
+        const real p = (R_n + coords.height) * cos_lat;
+        const real z = ((R_n * (1 - magneto_WGS84_E_SQ)) + coords.height) * sin_lat;
+        const real dp_dlat = -(R_m + coords.height) * sin_lat;
+        const real dz_dlat = (R_m + coords.height) * cos_lat;
+        const real r_sq = sq(p) + sq(z);
+        const real dr_dlat = ((p * dp_dlat) + (z * dz_dlat)) / frame.spherical.radius;
+        const real dr_dh = ((p * cos_lat) + (z * sin_lat)) / frame.spherical.radius;
+        const real dpsi_dlat = ((p * dz_dlat) - (z * dp_dlat)) / r_sq;
+        const real dpsi_dh = ((p * sin_lat) - (z * cos_lat)) / r_sq;
+
+        // Co-latitude decreases as the geocentric latitude increases
+        const real per_deg = deg_to_rad(1);
+        const real dx[3][3] = {
+            { dr_dlat * per_deg, -dpsi_dlat * per_deg, 0 },
+            { 0, 0, per_deg },
+            { dr_dh, -dpsi_dh, 0 },
+        };
+        // Rotation angle eps = lat - psi also changes with latitude & height
+        const real deps[3] = { (1 - dpsi_dlat) * per_deg, 0, -dpsi_dh };
+
+        for (size_t j = 0U; j < 3U; ++j) {
+            const SphericalGradient *const g = &sph_gradient;
+            const SphericalCoords dB_spherical = {
+                .radius = (g->d_radius.radius * dx[j][0]) + (g->d_theta.radius * dx[j][1]) + (g->d_phi.radius * dx[j][2]),
+                .azimuth = (g->d_radius.azimuth * dx[j][0]) + (g->d_theta.azimuth * dx[j][1])
+                    + (g->d_phi.azimuth * dx[j][2]),
+                .polar = (g->d_radius.polar * dx[j][0]) + (g->d_theta.polar * dx[j][1]) + (g->d_phi.polar * dx[j][2]),
+            };
+            real dB_ned[3];
+            rotate_vector_spherical_to_ned(&frame, dB_spherical, dB_ned);
+            // Derivative of the rotation itself is (B_d, 0, -B_n) per radian of eps
+            gradient->dB_ned[0][j] = dB_ned[0] + (B_ned[2] * deps[j]);
+            gradient->dB_ned[1][j] = dB_ned[1];
+            gradient->dB_ned[2][j] = dB_ned[2] - (B_ned[0] * deps[j]);
+        }
+    }
+
+    const FieldState B = magneto_FieldState_from_ned(B_ned);
+    return B;
+}
+
+magneto_ModelSnapshot magneto_ModelSnapshot_from_model(
+    const magneto_Model *const model,
+    const magneto_DecYear t,
+    magneto_real *const buffer,
+    const size_t buffer_len
+) {
+    magneto_ModelSnapshot snapshot = { 0 };
+    if ((model == NULL) || (buffer == NULL)) {
+        return snapshot;
+    }
+    if (buffer_len < MAGNETO_SNAPSHOT_LEN(model->num_model_coeffs)) {
+        return snapshot;
+    }
+
+    const size_t i_model = find_sub_model(model, t.year).i_model;
+    const real delta_t = calc_sub_model_delta_t(model, i_model, t.year);
+    for (size_t n = 1U; n <= model->nm_max; ++n) {
+        for (size_t m = 0U; m <= n; ++m) {
+            real g = 0;
+            real h = 0;
+            real g_dot = 0;
+            real h_dot = 0;
+            calc_g_and_h_rates(model, NULL, i_model, n, m, &g, &h, &g_dot, &h_dot);
+
+            const size_t idx_coeff = MAGNETO_CALC_INDEX(n, m);
+            buffer[2U * idx_coeff] = (g + (delta_t * g_dot));
+            buffer[(2U * idx_coeff) + 1U] = (h + (delta_t * h_dot));
+        }
+    }
+
+    snapshot.model = model;
+    snapshot.t = t;
+    snapshot.coeffs = buffer;
+    return snapshot;
+}
+
+magneto_FieldState eval_field_snapshot(
+    const magneto_ModelSnapshot *const snapshot,
+    const magneto_Coords coords
+) {
+    if ((snapshot == NULL) || (snapshot->model == NULL) || (snapshot->coeffs == NULL)) {
+        const FieldState B = { 0 };
+        return B;
+    }
+
+    real B_ned[3];
+    eval_field_ned(snapshot->model, 0U, 0, snapshot->coeffs, coords, B_ned, NULL);
+
+    const FieldState B = magneto_FieldState_from_ned(B_ned);
+    return B;
+}
+
+/// Store only the requested outputs, same as `magneto_FieldState_from_ned`
+static void store_field_batch_outputs(
+    const magneto_FieldStateBatch *const out,
+    const size_t i,
+    const real *const B_ned
+) {
+    for (size_t k = 0U; k < 3U; ++k) {
+        if (out->B_ned[k] != NULL) {
+            out->B_ned[k][i] = B_ned[k];
+        }
+    }
+    // Horizontal intensity is an intermediate for total intensity & inclination
+    const bool need_H = (out->H != NULL) || (out->F != NULL) || (out->I != NULL);
+    const real H = need_H ? HYPOT(B_ned[0], B_ned[1]) : 0;
+    if (out->H != NULL) {
+        out->H[i] = H;
+    }
+    if (out->F != NULL) {
+        out->F[i] = HYPOT(H, B_ned[2]);
+    }
+    if (out->D != NULL) {
+        out->D[i] = rad_to_deg(REAL(atan2)(B_ned[1], B_ned[0]));
+    }
+    if (out->I != NULL) {
+        out->I[i] = rad_to_deg(REAL(atan2)(B_ned[2], H));
+    }
+}
+
+void eval_field_batch(
+    const magneto_Model *const model,
+    const size_t count,
+    const magneto_CoordsBatch *const in,
+    const magneto_FieldStateBatch *const out
+) {
+    if ((model == NULL) || (in == NULL) || (out == NULL)) {
+        return;
+    }
+    if ((in->latitude == NULL) || (in->longitude == NULL) || (in->height == NULL) || (in->time == NULL)) {
+        return;
+    }
+
+    // Sub-model of the last point, usually the same for streams of times, initially empty
+    SubModelInterval sub_model = { 0U, 0, 0 };
+
+    // The lane-wise kernel only implements the Gauss normalized recursion
+    if (model->normalization != magneto_NORMALIZATION_GAUSS) {
+        for (size_t i = 0U; i < count; ++i) {
+            const Coords coords = { .latitude = in->latitude[i], .longitude = in->longitude[i], .height = in->height[i] };
+            const real delta_t = find_sub_model_cached(model, &sub_model, in->time[i].year);
+            real B_ned[3];
+            eval_field_ned(model, sub_model.i_model, delta_t, NULL, coords, B_ned, NULL);
+            store_field_batch_outputs(out, i, B_ned);
+        }
+        return;
+    }
+
+    // Points are evaluated in chunks by the lane-wise expansion kernel
+    for (size_t i_chunk = 0U; i_chunk < count; i_chunk += KERNEL_LANES) {
+        const size_t num_lanes = ((count - i_chunk) < KERNEL_LANES) ? (count - i_chunk) : KERNEL_LANES;
+
+        TRACE_STAGE_BEGIN(coords);
+        GeocentricFrame frames[KERNEL_LANES];
+        size_t lane_models[KERNEL_LANES];
+        ExpansionLanesInput lanes_in;
+        bool is_single_model = true;
+        for (size_t l = 0U; l < KERNEL_LANES; ++l) {
+            // Pad a partial chunk by repeating its first point, outputs are discarded
+            const size_t i = i_chunk + ((l < num_lanes) ? l : 0U);
+            const Coords coords = { .latitude = in->latitude[i], .longitude = in->longitude[i], .height = in->height[i] };
+            frames[l] = magneto_GeocentricFrame_from_coords(coords);
+
+            const CoLatitude theta = calc_co_latitude(&frames[l]);
+            const real phi = deg_to_rad(coords.longitude);
+            lanes_in.t[l] = find_sub_model_cached(model, &sub_model, in->time[i].year);
+            lane_models[l] = sub_model.i_model;
+            is_single_model &= (lane_models[l] == lane_models[0]);
+            lanes_in.sin_theta[l] = theta.sin_theta;
+            lanes_in.cos_theta[l] = theta.cos_theta;
+            lanes_in.sin_phi[l] = SIN(phi);
+            lanes_in.cos_phi[l] = COS(phi);
+            lanes_in.normed_r[l] = (magneto_GEOMAG_REF_RADIUS / frames[l].spherical.radius);
+        }
+        TRACE_STAGE_END(coords, magneto_TRACE_STAGE_COORDS);
+
+        // Kernel shares coefficients across lanes, so a chunk spanning several sub-models
+        // takes one pass per sub-model, only keeping the lanes of that sub-model each time
+        bool is_done[KERNEL_LANES] = { false };
+        for (size_t l_first = 0U; l_first < num_lanes; ++l_first) {
+            if (is_done[l_first]) {
+                continue;
+            }
+            const size_t i_model = lane_models[l_first];
+
+            TRACE_STAGE_BEGIN(summation);
+            ExpansionLanesOutput lanes_out;
+            magneto_eval_spherical_expansion_lanes(model, i_model, &lanes_in, &lanes_out);
+            TRACE_STAGE_END(summation, magneto_TRACE_STAGE_SUMMATION);
+
+            for (size_t l = l_first; l < num_lanes; ++l) {
+                if (!is_single_model && (is_done[l] || (lane_models[l] != i_model))) {
+                    continue;
+                }
+                is_done[l] = true;
+                const SphericalCoords B_spherical = {
+                    .polar = lanes_out.B_phi[l],
+                    .azimuth = lanes_out.B_theta[l],
+                    .radius = lanes_out.B_r[l]
+                };
+                real B_ned[3];
+                TRACE_STAGE_BEGIN(rotation);
+                rotate_vector_spherical_to_ned(&frames[l], B_spherical, B_ned);
+                TRACE_STAGE_END(rotation, magneto_TRACE_STAGE_ROTATION);
+                store_field_batch_outputs(out, i_chunk + l, B_ned);
+            }
+        }
+    }
+}
+
+/// Sums over degree of every expansion term for a single row, so only the order is left
+///
+/// The spherical components become `sum_m (cos[m] * cos(m*phi)) + (sin[m] * sin(m*phi))`.
+typedef struct {
+    real *B_r_cos;
+    real *B_r_sin;
+    real *B_theta_cos;
+    real *B_theta_sin;
+    real *B_phi_cos;
+    real *B_phi_sin;
+} GridRowSums;
+
+/// Run the Legendre recursion & radial terms once for a grid row, summing over degree
+static void eval_grid_row_sums(
+    const magneto_Model *const model,
+    const size_t i_model,
+    const real t,
+    const GeocentricFrame *const pos,
+    const GridRowSums *const sums
+) {
+    const CoLatitude theta = calc_co_latitude(pos);
+    const real sin_theta = theta.sin_theta;
+    const real cos_theta = theta.cos_theta;
+    const real normed_r = (magneto_GEOMAG_REF_RADIUS / pos->spherical.radius);
+
+    real P_n_n = 1;
+    real dP_n_n = 0;
+    real r_m = normed_r * normed_r * normed_r;
+
+    for (size_t m = 0U; m <= model->nm_max; ++m) {
+        const magneto_SphericalHarmonicTerm *const terms_m = find_order_terms(model, i_model, m);
+        if (m > 0U) {
+            const real P_nprev_nprev = P_n_n;
+            P_n_n = sin_theta * P_nprev_nprev;
+            dP_n_n = (sin_theta * dP_n_n) + (cos_theta * P_nprev_nprev);
+        }
+        if (m > 1U) {
+            r_m *= normed_r;
+        }
+        real P_nprev_m = 1;
+        real P_nprevprev_m = 0;
+        real dP_nprev_m = 0;
+        real dP_nprevprev_m = 0;
+        real r_scalar = r_m;
+
+        real B_r_cos = 0;
+        real B_r_sin = 0;
+        real B_theta_cos = 0;
+        real B_theta_sin = 0;
+        real B_phi_cos = 0;
+        real B_phi_sin = 0;
+        for (size_t n = MAX_OF(m, 1U); n <= model->nm_max; ++n) {
+            real K_n_m = 0;
+            real n_plus_1 = 0;
+            real m_real = 0;
+            calc_recursion_consts(model, n, m, &K_n_m, &n_plus_1, &m_real);
+
+            real P_n_m = P_n_n;
+            real dP_n_m = dP_n_n;
+            if (n != m) {
+                P_n_m = (cos_theta * P_nprev_m) - (K_n_m * P_nprevprev_m);
+                dP_n_m = (cos_theta * dP_nprev_m) - (sin_theta * P_nprev_m) - (K_n_m * dP_nprevprev_m);
+            }
+            P_nprevprev_m = P_nprev_m;
+            P_nprev_m = P_n_m;
+            dP_nprevprev_m = dP_nprev_m;
+            dP_nprev_m = dP_n_m;
+
+            real g_n_m = 0;
+            real h_n_m = 0;
+            real g_dot_n_m = 0;
+            real h_dot_n_m = 0;
+            calc_g_and_h(model, terms_m, i_model, t, n, m, &g_n_m, &h_n_m, &g_dot_n_m, &h_dot_n_m);
+
+            const real r_P = r_scalar * P_n_m;
+            const real r_dP = r_scalar * dP_n_m;
+            B_r_cos += (n_plus_1 * r_P * g_n_m);
+            B_r_sin += (n_plus_1 * r_P * h_n_m);
+            B_theta_cos -= (r_dP * g_n_m);
+            B_theta_sin -= (r_dP * h_n_m);
+            B_phi_cos -= (m_real * r_P * h_n_m);
+            B_phi_sin += (m_real * r_P * g_n_m);
+            r_scalar *= normed_r;
+        }
+
+        sums->B_r_cos[m] = B_r_cos;
+        sums->B_r_sin[m] = B_r_sin;
+        sums->B_theta_cos[m] = B_theta_cos;
+        sums->B_theta_sin[m] = B_theta_sin;
+        // Divide by sin(theta) here instead of for every point
+        sums->B_phi_cos[m] = (sin_theta != 0) ? (B_phi_cos / sin_theta) : B_phi_cos;
+        sums->B_phi_sin[m] = (sin_theta != 0) ? (B_phi_sin / sin_theta) : B_phi_sin;
+    }
+}
+
+void eval_field_grid(
+    const magneto_Model *const model,
+    const magneto_DecYear t,
+    const magneto_CoordsGrid *const grid,
+    const magneto_FieldStateBatch *const out,
+    magneto_real *const workspace,
+    const size_t workspace_len
+) {
+    if ((model == NULL) || (grid == NULL) || (out == NULL) || (workspace == NULL)) {
+        return;
+    }
+    if ((grid->latitude == NULL) || (grid->longitude == NULL) || (grid->height == NULL)) {
+        return;
+    }
+    const size_t num_orders = model->nm_max + 1U;
+    if (workspace_len < MAGNETO_GRID_WORKSPACE_LEN(model->nm_max, grid->num_longitude)) {
+        return;
+    }
+
+    // Row sums only implement the Gauss normalized recursion
+    const size_t i_model = find_sub_model(model, t.year).i_model;
+    const real delta_t = calc_sub_model_delta_t(model, i_model, t.year);
+    if (model->normalization != magneto_NORMALIZATION_GAUSS) {
+        size_t i = 0U;
+        for (size_t i_h = 0U; i_h < grid->num_height; ++i_h) {
+            for (size_t i_lat = 0U; i_lat < grid->num_latitude; ++i_lat) {
+                for (size_t i_lon = 0U; i_lon < grid->num_longitude; ++i_lon, ++i) {
+                    const Coords coords = {
+                        .latitude = grid->latitude[i_lat],
+                        .longitude = grid->longitude[i_lon],
+                        .height = grid->height[i_h]
+                    };
+                    real B_ned[3];
+                    eval_field_ned(model, i_model, delta_t, NULL, coords, B_ned, NULL);
+                    store_field_batch_outputs(out, i, B_ned);
+                }
+            }
+        }
+        return;
+    }
+
+    // Partition the workspace into per-row sums and the per-column trig table
+    const GridRowSums sums = {
+        .B_r_cos = &workspace[0U * num_orders],
+        .B_r_sin = &workspace[1U * num_orders],
+        .B_theta_cos = &workspace[2U * num_orders],
+        .B_theta_sin = &workspace[3U * num_orders],
+        .B_phi_cos = &workspace[4U * num_orders],
+        .B_phi_sin = &workspace[5U * num_orders]
+    };
+    real *const trig = &workspace[6U * num_orders];
+
+    // Interleaved {cos(m*phi), sin(m*phi)} for each column, by angle addition
+    for (size_t j = 0U; j < grid->num_longitude; ++j) {
+        const real phi = deg_to_rad(grid->longitude[j]);
+        const real sin_phi = SIN(phi);
+        const real cos_phi = COS(phi);
+        real *const trig_j = &trig[2U * j * num_orders];
+        real sin_mphi = 0;
+        real cos_mphi = 1;
+        for (size_t m = 0U; m < num_orders; ++m) {
+            trig_j[2U * m] = cos_mphi;
+            trig_j[(2U * m) + 1U] = sin_mphi;
+            const real sin_mprev_phi = sin_mphi;
+            sin_mphi = (sin_mprev_phi * cos_phi) + (cos_mphi * sin_phi);
+            cos_mphi = (cos_mphi * cos_phi) - (sin_mprev_phi * sin_phi);
+        }
+    }
+
+    for (size_t i_h = 0U; i_h < grid->num_height; ++i_h) {
+        for (size_t i_lat = 0U; i_lat < grid->num_latitude; ++i_lat) {
+            // Geocentric latitude & radius depend on both geodetic latitude and height
+            const Coords row_coords = {
+                .latitude = grid->latitude[i_lat],
+                .longitude = 0,
+                .height = grid->height[i_h]
+            };
+            const GeocentricFrame frame = magneto_GeocentricFrame_from_coords(row_coords);
+            eval_grid_row_sums(model, i_model, delta_t, &frame, &sums);
+
+            const size_t i_row = ((i_h * grid->num_latitude) + i_lat) * grid->num_longitude;
+            for (size_t j = 0U; j < grid->num_longitude; ++j) {
+                const real *const trig_j = &trig[2U * j * num_orders];
+                real B_r = 0;
+                real B_theta = 0;
+                real B_phi = 0;
+                for (size_t m = 0U; m < num_orders; ++m) {
+                    const real cos_mphi = trig_j[2U * m];
+                    const real sin_mphi = trig_j[(2U * m) + 1U];
+                    B_r += (sums.B_r_cos[m] * cos_mphi) + (sums.B_r_sin[m] * sin_mphi);
+                    B_theta += (sums.B_theta_cos[m] * cos_mphi) + (sums.B_theta_sin[m] * sin_mphi);
+                    B_phi += (sums.B_phi_cos[m] * cos_mphi) + (sums.B_phi_sin[m] * sin_mphi);
+                }
+
+                const SphericalCoords B_spherical = {
+                    .polar = B_phi,
+                    .azimuth = B_theta,
+                    .radius = B_r
+                };
+                real B_ned[3];
+                rotate_vector_spherical_to_ned(&frame, B_spherical, B_ned);
+                store_field_batch_outputs(out, i_row + j, B_ned);
+            }
+        }
+    }
+}
+
+magneto_Evaluator magneto_Evaluator_from_model(
+    const magneto_Model *const model,
+    magneto_real *const workspace,
+    const size_t workspace_len
+) {
+    magneto_Evaluator evaluator = { 0 };
+    if ((model == NULL) || (workspace == NULL)) {
+        return evaluator;
+    }
+    // Cached Legendre functions are Gauss normalized & unscaled
+    if (model->normalization != magneto_NORMALIZATION_GAUSS) {
+        return evaluator;
+    }
+    if (workspace_len < MAGNETO_EVALUATOR_WORKSPACE_LEN(model->nm_max, model->num_model_coeffs)) {
+        return evaluator;
+    }
+
+    // Partition the workspace into each cached array
+    const size_t num_coeffs = model->num_model_coeffs;
+    const size_t num_degrees = model->nm_max + 1U;
+    evaluator.model = model;
+    evaluator.P = &workspace[0U];
+    evaluator.dP = &workspace[num_coeffs];
+    evaluator.coeffs = &workspace[2U * num_coeffs];
+    evaluator.cos_mphi = &workspace[4U * num_coeffs];
+    evaluator.sin_mphi = &workspace[(4U * num_coeffs) + num_degrees];
+    evaluator.r_pow = &workspace[(4U * num_coeffs) + (2U * num_degrees)];
+    return evaluator;
+}
+
+/// Fill the Legendre & radial caches of an evaluator for a new latitude and height
+static void update_evaluator_position(magneto_Evaluator *const evaluator, const GeocentricFrame *const pos) {
+    const magneto_Model *const model = evaluator->model;
+
+    const CoLatitude theta = calc_co_latitude(pos);
+    const real sin_theta = theta.sin_theta;
+    const real cos_theta = theta.cos_theta;
+
+    real P_n_n = 1;
+    real dP_n_n = 0;
+    for (size_t m = 0U; m <= model->nm_max; ++m) {
+        if (m > 0U) {
+            const real P_nprev_nprev = P_n_n;
+            P_n_n = sin_theta * P_nprev_nprev;
+            dP_n_n = (sin_theta * dP_n_n) + (cos_theta * P_nprev_nprev);
+        }
+        real P_nprev_m = 1;
+        real P_nprevprev_m = 0;
+        real dP_nprev_m = 0;
+        real dP_nprevprev_m = 0;
+        for (size_t n = MAX_OF(m, 1U); n <= model->nm_max; ++n) {
+            real K_n_m = 0;
+            real n_plus_1 = 0;
+            real m_real = 0;
+            calc_recursion_consts(model, n, m, &K_n_m, &n_plus_1, &m_real);
+
+            real P_n_m = P_n_n;
+            real dP_n_m = dP_n_n;
+            if (n != m) {
+                P_n_m = (cos_theta * P_nprev_m) - (K_n_m * P_nprevprev_m);
+                dP_n_m = (cos_theta * dP_nprev_m) - (sin_theta * P_nprev_m) - (K_n_m * dP_nprevprev_m);
+            }
+            P_nprevprev_m = P_nprev_m;
+            P_nprev_m = P_n_m;
+            dP_nprevprev_m = dP_nprev_m;
+            dP_nprev_m = dP_n_m;
+
+            evaluator->P[MAGNETO_CALC_INDEX(n, m)] = P_n_m;
+            evaluator->dP[MAGNETO_CALC_INDEX(n, m)] = dP_n_m;
+        }
+    }
+
+    // Degree 0 is unused, but keeps the indexing simple
+    const real normed_r = (magneto_GEOMAG_REF_RADIUS / pos->spherical.radius);
+    real r_scalar = normed_r * normed_r;
+    for (size_t n = 0U; n <= model->nm_max; ++n) {
+        evaluator->r_pow[n] = r_scalar;
+        r_scalar *= normed_r;
+    }
+}
+
+/// Fill the longitude caches of an evaluator for a new longitude
+static void update_evaluator_longitude(magneto_Evaluator *const evaluator, const real longitude) {
+    const real phi = deg_to_rad(longitude);
+    const real sin_phi = SIN(phi);
+    const real cos_phi = COS(phi);
+    real sin_mphi = 0;
+    real cos_mphi = 1;
+    for (size_t m = 0U; m <= evaluator->model->nm_max; ++m) {
+        evaluator->cos_mphi[m] = cos_mphi;
+        evaluator->sin_mphi[m] = sin_mphi;
+        const real sin_mprev_phi = sin_mphi;
+        sin_mphi = (sin_mprev_phi * cos_phi) + (cos_mphi * sin_phi);
+        cos_mphi = (cos_mphi * cos_phi) - (sin_mprev_phi * sin_phi);
+    }
+}
+
+magneto_FieldState eval_field_incremental(
+    magneto_Evaluator *const evaluator,
+    const magneto_DecYear t,
+    const magneto_Coords coords
+) {
+    if ((evaluator == NULL) || (evaluator->model == NULL)) {
+        const FieldState B = { 0 };
+        return B;
+    }
+    const magneto_Model *const model = evaluator->model;
+
+    // Geocentric latitude & radius only depend on geodetic latitude & height
+    const bool same_position = evaluator->has_position
+        && (coords.latitude == evaluator->coords.latitude)
+        && (coords.height == evaluator->coords.height);
+    if (!same_position) {
+        TRACE_STAGE_BEGIN(coords);
+        evaluator->frame = magneto_GeocentricFrame_from_coords(coords);
+        TRACE_STAGE_END(coords, magneto_TRACE_STAGE_COORDS);
+
+        TRACE_STAGE_BEGIN(legendre);
+        update_evaluator_position(evaluator, &evaluator->frame);
+        TRACE_STAGE_END(legendre, magneto_TRACE_STAGE_LEGENDRE);
+        evaluator->has_position = true;
+    }
+    if (!evaluator->has_longitude || (coords.longitude != evaluator->coords.longitude)) {
+        update_evaluator_longitude(evaluator, coords.longitude);
+        evaluator->frame.spherical.azimuth = coords.longitude;
+        evaluator->has_longitude = true;
+    }
+    evaluator->coords = coords;
+
+    // Re-interpolate coefficients only if the time changed
+    if ((evaluator->snapshot.model == NULL) || (t.year != evaluator->snapshot.t.year)) {
+        TRACE_STAGE_BEGIN(coeffs);
+        evaluator->snapshot = magneto_ModelSnapshot_from_model(
+            model, t, evaluator->coeffs, MAGNETO_SNAPSHOT_LEN(model->num_model_coeffs)
+        );
+        TRACE_STAGE_END(coeffs, magneto_TRACE_STAGE_COEFFS);
+    }
+
+    TRACE_STAGE_BEGIN(summation);
+    real B_r = 0;
+    real B_theta = 0;
+    real B_phi = 0;
+    for (size_t m = 0U; m <= model->nm_max; ++m) {
+        const real cos_mphi = evaluator->cos_mphi[m];
+        const real sin_mphi = evaluator->sin_mphi[m];
+        for (size_t n = MAX_OF(m, 1U); n <= model->nm_max; ++n) {
+            const size_t idx_coeff = MAGNETO_CALC_INDEX(n, m);
+            const real g_n_m = evaluator->coeffs[2U * idx_coeff];
+            const real h_n_m = evaluator->coeffs[(2U * idx_coeff) + 1U];
+            if ((g_n_m == 0) && (h_n_m == 0)) {
+                continue;
+            }
+            const real r_scalar = evaluator->r_pow[n];
+            const real P_n_m = evaluator->P[idx_coeff];
+            const real gc_hs = (g_n_m * cos_mphi) + (h_n_m * sin_mphi);
+            B_r += (r_scalar * gc_hs * (real) (n + 1U) * P_n_m);
+            B_theta -= (r_scalar * gc_hs * evaluator->dP[idx_coeff]);
+            B_phi -= (r_scalar * (real) m * ((-g_n_m * sin_mphi) + (h_n_m * cos_mphi)) * P_n_m);
+        }
+    }
+    const real sin_theta = calc_co_latitude(&evaluator->frame).sin_theta;
+    if (sin_theta != 0) {
+        B_phi /= sin_theta;
+    }
+    TRACE_STAGE_END(summation, magneto_TRACE_STAGE_SUMMATION);
+
+    const SphericalCoords B_spherical = {
+        .polar = B_phi,
+        .azimuth = B_theta,
+        .radius = B_r
+    };
+    real B_ned[3];
+    TRACE_STAGE_BEGIN(rotation);
+    rotate_vector_spherical_to_ned(&evaluator->frame, B_spherical, B_ned);
+    TRACE_STAGE_END(rotation, magneto_TRACE_STAGE_ROTATION);
+
+    const FieldState B = magneto_FieldState_from_ned(B_ned);
+    return B;
+}
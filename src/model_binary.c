@@ -0,0 +1,209 @@
+// Needed for `mmap`
+#define _POSIX_C_SOURCE 200112L
+
+#include "magneto/model_binary.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "magneto/model.h"
+#include "common_private.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#define HAVE_WIN32_MAPPING
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define HAVE_POSIX_MAPPING
+#endif
+
+typedef magneto_ModelBinaryHeader ModelBinaryHeader;
+typedef magneto_SphericalHarmonicCoeff SphericalHarmonicCoeff;
+typedef magneto_RecursionConsts RecursionConsts;
+typedef magneto_SphericalHarmonicTerm SphericalHarmonicTerm;
+typedef magneto_SquareRoot SquareRoot;
+
+// Sections are read as-is, so the structs must be exactly packed arrays of reals
+STATIC_ASSERT(sizeof(SphericalHarmonicCoeff) == (2U * sizeof(real)), coeff_must_be_packed);
+STATIC_ASSERT(sizeof(RecursionConsts) == (3U * sizeof(real)), recursion_consts_must_be_packed);
+STATIC_ASSERT(sizeof(SphericalHarmonicTerm) == (4U * sizeof(real)), term_must_be_packed);
+STATIC_ASSERT(sizeof(SquareRoot) == (2U * sizeof(real)), square_root_must_be_packed);
+// Must match the layout written by `tools/gen_coeffs.py`
+STATIC_ASSERT(sizeof(ModelBinaryHeader) == 128U, header_must_match_generator);
+
+/// Check a section of `count` elements of `elem_size` bytes at `offset` lies within `size` bytes
+static bool is_valid_section(const uint64_t offset, const uint64_t count, const size_t elem_size, const uint64_t size) {
+    if ((offset < sizeof(ModelBinaryHeader)) || ((offset % MAGNETO_MODEL_BINARY_ALIGNMENT) != 0U)) {
+        return false;
+    }
+    if ((offset > size) || (count > ((size - offset) / elem_size))) {
+        return false;
+    }
+    return true;
+}
+
+magneto_Model magneto_Model_from_binary(
+    const void *const data,
+    const size_t size,
+    magneto_ModelCoeffs *const models,
+    const size_t models_len
+) {
+    const magneto_Model invalid = { 0 };
+    if ((data == NULL) || (models == NULL) || (size < sizeof(ModelBinaryHeader))) {
+        return invalid;
+    }
+    if (((uintptr_t) data % MAGNETO_MODEL_BINARY_ALIGNMENT) != 0U) {
+        return invalid;
+    }
+
+    // Fields are checked in native byte order, so a swapped file fails the magic check
+    const ModelBinaryHeader *const header = (const ModelBinaryHeader *) data;
+    bool valid = true;
+    valid &= (header->magic == MAGNETO_MODEL_BINARY_MAGIC);
+    valid &= (header->version == MAGNETO_MODEL_BINARY_VERSION);
+    valid &= (header->real_size == sizeof(real));
+    valid &= (header->file_size <= size);
+    valid &= (header->nm_max > 0U);
+    valid &= (header->num_models > 0U) && (header->num_models <= models_len);
+    valid &= (header->num_models == 1U) || (header->model_interval > 0.0);
+    if (!valid) {
+        return invalid;
+    }
+    const uint64_t nm_max = header->nm_max;
+    const uint64_t num_coeffs = header->num_model_coeffs;
+    if (num_coeffs != (uint64_t) (MAGNETO_CALC_INDEX(nm_max, nm_max) + 1U)) {
+        return invalid;
+    }
+
+    const uint64_t file_size = header->file_size;
+    const bool has_recursion = ((header->flags & MAGNETO_MODEL_BINARY_HAS_RECURSION) != 0U);
+    const bool is_schmidt = ((header->flags & MAGNETO_MODEL_BINARY_SCHMIDT) != 0U);
+    const bool has_bounds = ((header->flags & MAGNETO_MODEL_BINARY_HAS_BOUNDS) != 0U);
+    const bool has_terms = ((header->flags & MAGNETO_MODEL_BINARY_HAS_TERMS) != 0U);
+    const bool has_roots = ((header->flags & MAGNETO_MODEL_BINARY_HAS_ROOTS) != 0U);
+    valid &= is_valid_section(header->coeffs_offset, header->num_models * num_coeffs, sizeof(SphericalHarmonicCoeff), file_size);
+    valid &= is_valid_section(header->secular_offset, num_coeffs, sizeof(SphericalHarmonicCoeff), file_size);
+    if (has_recursion) {
+        valid &= is_valid_section(header->recursion_offset, num_coeffs, sizeof(RecursionConsts), file_size);
+    }
+    if (has_bounds) {
+        valid &= is_valid_section(header->bounds_offset, nm_max + 1U, sizeof(real), file_size);
+    }
+    if (has_terms) {
+        valid &= is_valid_section(header->terms_offset, header->num_models * num_coeffs, sizeof(SphericalHarmonicTerm), file_size);
+    }
+    if (has_roots) {
+        valid &= is_valid_section(header->roots_offset, (2U * nm_max) + 1U, sizeof(SquareRoot), file_size);
+    }
+    if (!valid) {
+        return invalid;
+    }
+
+    const unsigned char *const bytes = (const unsigned char *) data;
+    // Sections are aligned well beyond any `real`, so casting through `uintptr_t` is fine
+    const SphericalHarmonicCoeff *const coeffs = (const SphericalHarmonicCoeff *) (uintptr_t) (bytes + header->coeffs_offset);
+    const SphericalHarmonicCoeff *const secular = (const SphericalHarmonicCoeff *) (uintptr_t) (bytes + header->secular_offset);
+    const RecursionConsts *const recursion = has_recursion
+        ? (const RecursionConsts *) (uintptr_t) (bytes + header->recursion_offset)
+        : NULL;
+    const real *const degree_bounds = has_bounds
+        ? (const real *) (uintptr_t) (bytes + header->bounds_offset)
+        : NULL;
+    const SphericalHarmonicTerm *const terms = has_terms
+        ? (const SphericalHarmonicTerm *) (uintptr_t) (bytes + header->terms_offset)
+        : NULL;
+    const SquareRoot *const roots = has_roots
+        ? (const SquareRoot *) (uintptr_t) (bytes + header->roots_offset)
+        : NULL;
+
+    for (size_t i = 0U; i < header->num_models; ++i) {
+        models[i].coeffs = &coeffs[i * num_coeffs];
+    }
+    const magneto_Model model = {
+        .epoch = {
+            .year = (real) header->epoch
+        },
+        .nm_max = (size_t) nm_max,
+        .num_model_coeffs = (size_t) num_coeffs,
+        .num_models = header->num_models,
+        .model_interval = {
+            .year = (real) header->model_interval
+        },
+        .models = models,
+        .last_secular = {
+            .coeffs = secular
+        },
+        .recursion = recursion,
+        .normalization = is_schmidt ? magneto_NORMALIZATION_SCHMIDT : magneto_NORMALIZATION_GAUSS,
+        .degree_bounds = degree_bounds,
+        .terms = terms,
+        .roots = roots
+    };
+    return model;
+}
+
+magneto_ModelFile magneto_ModelFile_open(const char *const path) {
+    magneto_ModelFile file = { NULL, 0U };
+    if (path == NULL) {
+        return file;
+    }
+
+#if defined(HAVE_POSIX_MAPPING)
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return file;
+    }
+    struct stat info;
+    if ((fstat(fd, &info) == 0) && (info.st_size > 0)) {
+        void *const data = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (data != MAP_FAILED) {
+            file.data = data;
+            file.size = (size_t) info.st_size;
+        }
+    }
+    // Mapping stays valid after closing
+    close(fd);
+
+#elif defined(HAVE_WIN32_MAPPING)
+    const HANDLE handle = CreateFileA(
+        path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL
+    );
+    if (handle == INVALID_HANDLE_VALUE) {
+        return file;
+    }
+    LARGE_INTEGER file_size;
+    if (GetFileSizeEx(handle, &file_size) && (file_size.QuadPart > 0)) {
+        const HANDLE mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping != NULL) {
+            const void *const data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (data != NULL) {
+                file.data = data;
+                file.size = (size_t) file_size.QuadPart;
+            }
+            // View keeps the mapping alive
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(handle);
+#endif
+
+    return file;
+}
+
+void magneto_ModelFile_close(magneto_ModelFile *const file) {
+    if ((file == NULL) || (file->data == NULL)) {
+        return;
+    }
+#if defined(HAVE_POSIX_MAPPING)
+    munmap((void *) (uintptr_t) file->data, file->size);
+#elif defined(HAVE_WIN32_MAPPING)
+    UnmapViewOfFile(file->data);
+#endif
+    file->data = NULL;
+    file->size = 0U;
+}
@@ -0,0 +1,184 @@
+#ifndef MAGNETO_MODEL_PRIVATE_H
+#define MAGNETO_MODEL_PRIVATE_H
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "magneto/model.h"
+#include "common_private.h"
+
+/// Recursion constant for the Gaussian normalized associated Legendre polynomials
+static inline real calc_K(const real n, const real m) {
+    if (n <= 1U) {
+        return 0;
+    }
+    return (sq(n - 1) - sq(m)) / (((2 * n) - 1) * ((2 * n) - 3));
+}
+
+/// Look up recursion constants of term (n, m), computing them if the model has no table
+static inline void calc_recursion_consts(
+    const magneto_Model *const model,
+    const size_t n,
+    const size_t m,
+    real *const K,
+    real *const n_plus_1,
+    real *const m_real
+) {
+    if (model->recursion != NULL) {
+        const magneto_RecursionConsts *const consts = &model->recursion[MAGNETO_CALC_INDEX(n, m)];
+        *K = consts->K;
+        *n_plus_1 = consts->n_plus_1;
+        *m_real = consts->m;
+    } else {
+        *K = calc_K((real) n, (real) m);
+        *n_plus_1 = (real) (n + 1U);
+        *m_real = (real) m;
+    }
+}
+
+/// Order-major terms of order `m` in the i-th sub-model, starting from degree max(m, 1),
+/// or `NULL` if the model only has the degree-major tables
+static inline const magneto_SphericalHarmonicTerm *find_order_terms(
+    const magneto_Model *const model,
+    const size_t i_model,
+    const size_t m
+) {
+    if (model->terms == NULL) {
+        return NULL;
+    }
+    const size_t idx_first = MAGNETO_CALC_ORDER_INDEX(MAX_OF(m, 1U), m, model->nm_max);
+    return &model->terms[(i_model * model->num_model_coeffs) + idx_first];
+}
+
+/// Look up coefficients of term (n, m) and their rate of change in the i-th sub-model,
+/// from the order's `terms_m` of `find_order_terms` if not `NULL`
+static inline void calc_g_and_h_rates(
+    const magneto_Model *const model,
+    const magneto_SphericalHarmonicTerm *const terms_m,
+    const size_t i_model,
+    const size_t n,
+    const size_t m,
+    real *const g,
+    real *const h,
+    real *const g_dot,
+    real *const h_dot
+) {
+    if (terms_m != NULL) {
+        const magneto_SphericalHarmonicTerm *const term = &terms_m[n - MAX_OF(m, 1U)];
+        *g = term->g;
+        *h = term->h;
+        *g_dot = term->g_dot;
+        *h_dot = term->h_dot;
+        return;
+    }
+
+    const magneto_SphericalHarmonicCoeff *const coeffs_i = model->models[i_model].coeffs;
+    const bool is_last_submodel = ((i_model + 1U) >= model->num_models);
+    const size_t idx_coeff = MAGNETO_CALC_INDEX(n, m);
+
+    *g = coeffs_i[idx_coeff].g;
+    *h = coeffs_i[idx_coeff].h;
+    if (is_last_submodel) {
+        *g_dot = model->last_secular.coeffs[idx_coeff].g;
+        *h_dot = model->last_secular.coeffs[idx_coeff].h;
+    } else {
+        const magneto_SphericalHarmonicCoeff *const coeffs_next = model->models[i_model + 1U].coeffs;
+        *g_dot = (coeffs_next[idx_coeff].g - *g) / model->model_interval.year;
+        *h_dot = (coeffs_next[idx_coeff].h - *h) / model->model_interval.year;
+    }
+}
+
+/// Sub-model whose interval contains a time, cached for streams of nearby times
+typedef struct {
+    size_t i_model;
+    real start;     ///< [year] Start of the interval, the sub-model's epoch
+    real end;       ///< [year] End of the interval, exclusive
+} SubModelInterval;
+
+/// Find the sub-model to evaluate at `year`, in O(1) since sub-models are evenly spaced
+///
+/// Each sub-model is linearly interpolated towards the next over its interval, the first
+/// is extrapolated backwards before the epoch & the last forwards with its secular variation.
+static inline SubModelInterval find_sub_model(const magneto_Model *const model, const real year) {
+    const real epoch = model->epoch.year;
+    const real interval = model->model_interval.year;
+    size_t i_model = 0U;
+    if ((model->num_models > 1U) && (interval > 0) && (year > epoch)) {
+        const real i_real = (year - epoch) / interval;
+        const size_t i_last = model->num_models - 1U;
+        i_model = (i_real < (real) i_last) ? (size_t) i_real : i_last;
+    }
+
+    // Unbounded at either end, so the cached interval also covers extrapolation
+    SubModelInterval found = { i_model, (real) -HUGE_VAL, (real) HUGE_VAL };
+    if (i_model > 0U) {
+        found.start = epoch + ((real) i_model * interval);
+    }
+    if ((i_model + 1U) < model->num_models) {
+        found.end = epoch + ((real) (i_model + 1U) * interval);
+    }
+    return found;
+}
+
+/// Time delta from the epoch of the i-th sub-model to `year`
+static inline real calc_sub_model_delta_t(const magneto_Model *const model, const size_t i_model, const real year) {
+    return year - (model->epoch.year + ((real) i_model * model->model_interval.year));
+}
+
+/// Same as `find_sub_model`, but first checks the `cached` interval of the last lookup,
+/// which is almost always a hit for monotonic streams of times. Returns the time delta
+/// into the sub-model.
+static inline real find_sub_model_cached(
+    const magneto_Model *const model,
+    SubModelInterval *const cached,
+    const real year
+) {
+    if (!((year >= cached->start) && (year < cached->end))) {
+        *cached = find_sub_model(model, year);
+    }
+    return calc_sub_model_delta_t(model, cached->i_model, year);
+}
+
+// Number of points evaluated together by the lane-wise expansion kernel, twice as many with
+// a single-precision basis so it still fills whole vectors
+#if defined(MAGNETO_MIXED_PRECISION) && !defined(MAGNETO_SINGLE_PRECISION)
+#define KERNEL_LANES    (16U)
+#else
+#define KERNEL_LANES    (8U)
+#endif
+
+/// Per-lane inputs to the spherical harmonic expansion, lanes are independent points
+typedef struct {
+    real t[KERNEL_LANES];           ///< [year] Time delta into the sub-model
+    real sin_theta[KERNEL_LANES];   ///< Sine of co-latitude
+    real cos_theta[KERNEL_LANES];   ///< Cosine of co-latitude
+    real sin_phi[KERNEL_LANES];     ///< Sine of longitude
+    real cos_phi[KERNEL_LANES];     ///< Cosine of longitude
+    real normed_r[KERNEL_LANES];    ///< Reference radius over geocentric radius
+} ExpansionLanesInput;
+
+/// Per-lane outputs of the spherical harmonic expansion, in the spherical frame
+typedef struct {
+    real B_r[KERNEL_LANES];
+    real B_theta[KERNEL_LANES];
+    real B_phi[KERNEL_LANES];
+} ExpansionLanesOutput;
+
+// Internal symbols are suffixed like public ones in the single-precision half of a dual build
+#if defined(MAGNETO_DUAL_PRECISION) && defined(MAGNETO_SINGLE_PRECISION)
+#define magneto_eval_spherical_expansion_lanes  magneto_eval_spherical_expansion_lanes_f
+#endif
+
+/// Evaluate the spherical harmonic expansion for `KERNEL_LANES` points at once
+///
+/// Dispatches at runtime to the widest vector instruction set supported by
+/// the CPU, falling back to the portable kernel.
+void magneto_eval_spherical_expansion_lanes(
+    const magneto_Model *model,
+    size_t i_model,
+    const ExpansionLanesInput *in,
+    ExpansionLanesOutput *out
+);
+
+#endif  // MAGNETO_MODEL_PRIVATE_H
@@ -0,0 +1,263 @@
+#include "magneto/model.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "common_private.h"
+#include "model_private.h"
+
+// Runtime dispatch to wider instruction sets is only supported on x86 with GCC & Clang
+#if !defined(MAGNETO_NO_SIMD_DISPATCH) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_X86_DISPATCH
+#endif
+
+#ifdef __GNUC__
+#define ALWAYS_INLINE   __attribute__((always_inline)) inline
+#else
+#define ALWAYS_INLINE   inline
+#endif
+
+#define FOR_EACH_LANE(l) for (size_t l = 0U; l < KERNEL_LANES; ++l)
+
+// Mixed precision keeps the recurrence basis in single-precision, so twice as many lanes fit
+// in a vector, but still accumulates the field in double-precision
+#if defined(MAGNETO_MIXED_PRECISION) && !defined(MAGNETO_SINGLE_PRECISION)
+typedef float basis_real;
+#else
+typedef real basis_real;
+#endif
+
+/// Lane-wise version of `eval_spherical_expansion`
+///
+/// Every lane runs the exact same recurrence, so all the innermost loops are
+/// over lanes and get vectorized for whichever instruction set this is
+/// inlined into. The per-order trig and per-degree radial terms are built
+/// with recurrences instead of libm calls, which would block vectorization.
+/// All recurrences are in `basis_real`, only the sums are in `real`. Specialized
+/// on whether to read the model's order-major `terms`, so there's no branch on
+/// it per degree.
+static ALWAYS_INLINE void eval_expansion_lanes_impl(
+    const magneto_Model *const model,
+    const bool use_terms,
+    const size_t i_model,
+    const ExpansionLanesInput *const in,
+    ExpansionLanesOutput *const out
+) {
+    real B_r[KERNEL_LANES];
+    real B_theta[KERNEL_LANES];
+    real B_phi[KERNEL_LANES];
+
+    // Inputs to the recurrences
+    basis_real sin_theta[KERNEL_LANES];
+    basis_real cos_theta[KERNEL_LANES];
+    basis_real sin_phi[KERNEL_LANES];
+    basis_real cos_phi[KERNEL_LANES];
+    basis_real normed_r[KERNEL_LANES];
+    // Recursive values for P_{n,n}, dP_{n,n}/dtheta, sin(m*phi), cos(m*phi)
+    basis_real P_n_n[KERNEL_LANES];
+    basis_real dP_n_n[KERNEL_LANES];
+    basis_real sin_mphi[KERNEL_LANES];
+    basis_real cos_mphi[KERNEL_LANES];
+    // Radial scaling (a/r)^(n+2) for the first degree of each order
+    basis_real r_m[KERNEL_LANES];
+
+    FOR_EACH_LANE(l) {
+        B_r[l] = 0;
+        B_theta[l] = 0;
+        B_phi[l] = 0;
+        sin_theta[l] = (basis_real) in->sin_theta[l];
+        cos_theta[l] = (basis_real) in->cos_theta[l];
+        sin_phi[l] = (basis_real) in->sin_phi[l];
+        cos_phi[l] = (basis_real) in->cos_phi[l];
+        normed_r[l] = (basis_real) in->normed_r[l];
+        P_n_n[l] = 1;
+        dP_n_n[l] = 0;
+        sin_mphi[l] = 0;
+        cos_mphi[l] = 1;
+        r_m[l] = normed_r[l] * normed_r[l] * normed_r[l];
+    }
+
+    for (size_t m = 0U; m <= model->nm_max; ++m) {
+        // Compute values for this order from the previous one, but skip first iter
+        if (m > 0U) {
+            FOR_EACH_LANE(l) {
+                const basis_real P_nprev_nprev = P_n_n[l];
+                P_n_n[l] = sin_theta[l] * P_nprev_nprev;
+                dP_n_n[l] = (sin_theta[l] * dP_n_n[l]) + (cos_theta[l] * P_nprev_nprev);
+
+                const basis_real sin_mprev_phi = sin_mphi[l];
+                sin_mphi[l] = (sin_mprev_phi * cos_phi[l]) + (cos_mphi[l] * sin_phi[l]);
+                cos_mphi[l] = (cos_mphi[l] * cos_phi[l]) - (sin_mprev_phi * sin_phi[l]);
+            }
+        }
+        // Order 0 & 1 both start at degree 1
+        if (m > 1U) {
+            FOR_EACH_LANE(l) {
+                r_m[l] *= normed_r[l];
+            }
+        }
+
+        basis_real P_nprev_m[KERNEL_LANES];
+        basis_real P_nprevprev_m[KERNEL_LANES];
+        basis_real dP_nprev_m[KERNEL_LANES];
+        basis_real dP_nprevprev_m[KERNEL_LANES];
+        basis_real r_scalar[KERNEL_LANES];
+        // Order's trig in the accumulation precision, converted once rather than per degree
+        real sin_mphi_acc[KERNEL_LANES];
+        real cos_mphi_acc[KERNEL_LANES];
+        FOR_EACH_LANE(l) {
+            P_nprev_m[l] = 1;
+            P_nprevprev_m[l] = 0;
+            dP_nprev_m[l] = 0;
+            dP_nprevprev_m[l] = 0;
+            r_scalar[l] = r_m[l];
+            sin_mphi_acc[l] = (real) sin_mphi[l];
+            cos_mphi_acc[l] = (real) cos_mphi[l];
+        }
+
+        // Degrees of an order are consecutive in the order-major terms
+        const magneto_SphericalHarmonicTerm *term = use_terms ? find_order_terms(model, i_model, m) : NULL;
+
+        // Condition is enforced by loop bounds: (m <= n)
+        for (size_t n = MAX_OF(m, 1U); n <= model->nm_max; ++n) {
+            real g = 0;
+            real h = 0;
+            real g_dot = 0;
+            real h_dot = 0;
+            if (use_terms) {
+                g = term->g;
+                h = term->h;
+                g_dot = term->g_dot;
+                h_dot = term->h_dot;
+                ++term;
+            } else {
+                calc_g_and_h_rates(model, NULL, i_model, n, m, &g, &h, &g_dot, &h_dot);
+            }
+
+            real K_n_m = 0;
+            real n_plus_1 = 0;
+            real m_real = 0;
+            calc_recursion_consts(model, n, m, &K_n_m, &n_plus_1, &m_real);
+            const basis_real K = (basis_real) K_n_m;
+            const bool is_first = (n == m);
+
+            FOR_EACH_LANE(l) {
+                // Selected rather than branched on, so the loop is if-converted with any basis type
+                const basis_real P_next = (cos_theta[l] * P_nprev_m[l]) - (K * P_nprevprev_m[l]);
+                const basis_real dP_next = (cos_theta[l] * dP_nprev_m[l]) - (sin_theta[l] * P_nprev_m[l])
+                    - (K * dP_nprevprev_m[l]);
+                const basis_real P_n_m = is_first ? P_n_n[l] : P_next;
+                const basis_real dP_n_m = is_first ? dP_n_n[l] : dP_next;
+                P_nprevprev_m[l] = P_nprev_m[l];
+                P_nprev_m[l] = P_n_m;
+                dP_nprevprev_m[l] = dP_nprev_m[l];
+                dP_nprev_m[l] = dP_n_m;
+
+                // Radial scaling is folded into the basis, leaving two conversions per term
+                const real r_P = (real) (r_scalar[l] * P_n_m);
+                const real r_dP = (real) (r_scalar[l] * dP_n_m);
+                r_scalar[l] *= normed_r[l];
+
+                const real g_n_m = g + (in->t[l] * g_dot);
+                const real h_n_m = h + (in->t[l] * h_dot);
+                const real gc_hs = (g_n_m * cos_mphi_acc[l]) + (h_n_m * sin_mphi_acc[l]);
+                const real gs_hc = (-g_n_m * sin_mphi_acc[l]) + (h_n_m * cos_mphi_acc[l]);
+
+                B_r[l] += (r_P * gc_hs * n_plus_1);
+                B_theta[l] -= (r_dP * gc_hs);
+                B_phi[l] -= (r_P * m_real * gs_hc);
+            }
+        }
+    }
+
+    FOR_EACH_LANE(l) {
+        out->B_r[l] = B_r[l];
+        out->B_theta[l] = B_theta[l];
+        out->B_phi[l] = (in->sin_theta[l] != 0) ? (B_phi[l] / in->sin_theta[l]) : B_phi[l];
+    }
+}
+
+static ALWAYS_INLINE void eval_expansion_lanes_specialized(
+    const magneto_Model *const model,
+    const size_t i_model,
+    const ExpansionLanesInput *const in,
+    ExpansionLanesOutput *const out
+) {
+    if (model->terms != NULL) {
+        eval_expansion_lanes_impl(model, true, i_model, in, out);
+    } else {
+        eval_expansion_lanes_impl(model, false, i_model, in, out);
+    }
+}
+
+typedef void (*ExpansionLanesKernel)(
+    const magneto_Model *model,
+    size_t i_model,
+    const ExpansionLanesInput *in,
+    ExpansionLanesOutput *out
+);
+
+/// Portable kernel, which is the SSE2 one on x86-64
+static void eval_expansion_lanes_portable(
+    const magneto_Model *const model,
+    const size_t i_model,
+    const ExpansionLanesInput *const in,
+    ExpansionLanesOutput *const out
+) {
+    eval_expansion_lanes_specialized(model, i_model, in, out);
+}
+
+#ifdef HAVE_X86_DISPATCH
+
+__attribute__((target("avx2,fma")))
+static void eval_expansion_lanes_avx2(
+    const magneto_Model *const model,
+    const size_t i_model,
+    const ExpansionLanesInput *const in,
+    ExpansionLanesOutput *const out
+) {
+    eval_expansion_lanes_specialized(model, i_model, in, out);
+}
+
+__attribute__((target("avx512f")))
+static void eval_expansion_lanes_avx512(
+    const magneto_Model *const model,
+    const size_t i_model,
+    const ExpansionLanesInput *const in,
+    ExpansionLanesOutput *const out
+) {
+    eval_expansion_lanes_specialized(model, i_model, in, out);
+}
+
+static ExpansionLanesKernel select_expansion_lanes_kernel(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return eval_expansion_lanes_avx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return eval_expansion_lanes_avx2;
+    }
+    return eval_expansion_lanes_portable;
+}
+
+#endif  // HAVE_X86_DISPATCH
+
+void magneto_eval_spherical_expansion_lanes(
+    const magneto_Model *const model,
+    const size_t i_model,
+    const ExpansionLanesInput *const in,
+    ExpansionLanesOutput *const out
+) {
+#ifdef HAVE_X86_DISPATCH
+    // Selected on first use by any thread, racing threads at worst both store the same kernel
+    static ExpansionLanesKernel kernel = NULL;
+    ExpansionLanesKernel selected = ATOMIC_LOAD_ACQUIRE(&kernel);
+    if (selected == NULL) {
+        selected = select_expansion_lanes_kernel();
+        ATOMIC_STORE_RELEASE(&kernel, selected);
+    }
+    selected(model, i_model, in, out);
+#else
+    eval_expansion_lanes_portable(model, i_model, in, out);
+#endif
+}
@@ -0,0 +1,143 @@
+#include "magneto/parallel.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "magneto/model.h"
+#include "common_private.h"
+#include "model_private.h"
+
+#ifdef MAGNETO_THREADS
+#include <pthread.h>
+#endif
+
+// Bounds the per-call arrays of thread handles, more threads than this are clamped
+#define MAX_SPAWNED_THREADS (64U)
+
+/// Shared by every task of a parallel batch evaluation
+typedef struct {
+    const magneto_Model *model;
+    size_t count;
+    size_t chunk_size;
+    const magneto_CoordsBatch *in;
+    const magneto_FieldStateBatch *out;
+} BatchJob;
+
+static real *offset_output(real *const output, const size_t offset) {
+    return (output != NULL) ? &output[offset] : NULL;
+}
+
+/// Evaluate the `i_task`-th chunk of a batch job, a `magneto_TaskFn`
+static void eval_batch_chunk(void *const context, const size_t i_task) {
+    const BatchJob *const job = (const BatchJob *) context;
+    const size_t begin = i_task * job->chunk_size;
+    if (begin >= job->count) {
+        return;
+    }
+    const size_t remaining = job->count - begin;
+    const size_t len = (remaining < job->chunk_size) ? remaining : job->chunk_size;
+
+    const magneto_CoordsBatch in = {
+        &job->in->latitude[begin],
+        &job->in->longitude[begin],
+        &job->in->height[begin],
+        &job->in->time[begin]
+    };
+    const magneto_FieldStateBatch out = {
+        {
+            offset_output(job->out->B_ned[0], begin),
+            offset_output(job->out->B_ned[1], begin),
+            offset_output(job->out->B_ned[2], begin)
+        },
+        offset_output(job->out->F, begin),
+        offset_output(job->out->H, begin),
+        offset_output(job->out->D, begin),
+        offset_output(job->out->I, begin)
+    };
+    eval_field_batch(job->model, len, &in, &out);
+}
+
+#ifdef MAGNETO_THREADS
+
+/// Takes every `stride`-th task starting from `first_task`
+typedef struct {
+    BatchJob *job;
+    size_t num_tasks;
+    size_t first_task;
+    size_t stride;
+} BatchWorker;
+
+static void run_batch_worker(const BatchWorker *const worker) {
+    for (size_t i_task = worker->first_task; i_task < worker->num_tasks; i_task += worker->stride) {
+        eval_batch_chunk(worker->job, i_task);
+    }
+}
+
+static void *batch_worker_main(void *const arg) {
+    run_batch_worker((const BatchWorker *) arg);
+    return NULL;
+}
+
+#endif  // MAGNETO_THREADS
+
+void eval_field_batch_parallel(
+    const magneto_Model *const model,
+    const size_t count,
+    const magneto_CoordsBatch *const in,
+    const magneto_FieldStateBatch *const out,
+    const magneto_ParallelOptions *const options
+) {
+    if ((model == NULL) || (in == NULL) || (out == NULL) || (options == NULL)) {
+        return;
+    }
+    if ((in->latitude == NULL) || (in->longitude == NULL) || (in->height == NULL) || (in->time == NULL)) {
+        return;
+    }
+
+    // Whole kernel widths, so each chunk is split into lanes just like the serial path. Chunks
+    // beyond every point are clamped first, so rounding up can't wrap around for huge sizes.
+    const size_t max_chunk = (count > 0U) ? count : 1U;
+    size_t chunk_size = (options->chunk_size > 0U) ? options->chunk_size : MAGNETO_PARALLEL_DEFAULT_CHUNK;
+    chunk_size = (chunk_size < max_chunk) ? chunk_size : max_chunk;
+    chunk_size = ((chunk_size + KERNEL_LANES - 1U) / KERNEL_LANES) * KERNEL_LANES;
+    const size_t num_tasks = (count / chunk_size) + (((count % chunk_size) != 0U) ? 1U : 0U);
+    BatchJob job = { model, count, chunk_size, in, out };
+
+    if ((options->pool != NULL) && (options->pool->parallel_for != NULL)) {
+        options->pool->parallel_for(options->pool->pool, eval_batch_chunk, &job, num_tasks);
+        return;
+    }
+
+#ifdef MAGNETO_THREADS
+    size_t num_threads = (options->num_threads < num_tasks) ? options->num_threads : num_tasks;
+    num_threads = (num_threads < MAX_SPAWNED_THREADS) ? num_threads : MAX_SPAWNED_THREADS;
+    if (num_threads > 1U) {
+        pthread_t threads[MAX_SPAWNED_THREADS];
+        BatchWorker workers[MAX_SPAWNED_THREADS];
+        bool is_spawned[MAX_SPAWNED_THREADS];
+        for (size_t k = 0U; k < num_threads; ++k) {
+            workers[k].job = &job;
+            workers[k].num_tasks = num_tasks;
+            workers[k].first_task = k;
+            workers[k].stride = num_threads;
+        }
+        // Calling thread takes the first share
+        for (size_t k = 1U; k < num_threads; ++k) {
+            is_spawned[k] = (pthread_create(&threads[k], NULL, batch_worker_main, &workers[k]) == 0);
+        }
+        run_batch_worker(&workers[0]);
+        for (size_t k = 1U; k < num_threads; ++k) {
+            if (is_spawned[k]) {
+                pthread_join(threads[k], NULL);
+            } else {
+                run_batch_worker(&workers[k]);
+            }
+        }
+        return;
+    }
+#endif
+
+    for (size_t i_task = 0U; i_task < num_tasks; ++i_task) {
+        eval_batch_chunk(&job, i_task);
+    }
+}
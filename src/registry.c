@@ -0,0 +1,87 @@
+#include "magneto/registry.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "magneto/model.h"
+#include "common_private.h"
+
+typedef magneto_ModelRegistry ModelRegistry;
+typedef magneto_RegistryReader RegistryReader;
+
+STATIC_ASSERT(sizeof(RegistryReader) == 64U, reader_must_fill_a_cache_line);
+
+bool magneto_ModelRegistry_init(
+    ModelRegistry *const registry,
+    const magneto_Model *const model,
+    RegistryReader *const readers,
+    const size_t num_readers
+) {
+    if ((registry == NULL) || (model == NULL) || (readers == NULL) || (num_readers == 0U)) {
+        return false;
+    }
+    for (size_t i = 0U; i < num_readers; ++i) {
+        readers[i].epoch = 0U;
+    }
+    registry->readers = readers;
+    registry->num_readers = num_readers;
+    registry->epoch = 1U;
+    // Publishes everything above to threads that later load the model
+    ATOMIC_STORE_RELEASE_PTR(&registry->model, model);
+    return true;
+}
+
+const magneto_Model *magneto_ModelRegistry_acquire(ModelRegistry *const registry, const size_t i_reader) {
+    if ((registry == NULL) || (i_reader >= registry->num_readers)) {
+        return NULL;
+    }
+    // Seeing a publish's new epoch means also seeing its new model
+    const size_t epoch = ATOMIC_LOAD_ACQUIRE(&registry->epoch);
+    ATOMIC_STORE_RELEASE(&registry->readers[i_reader].epoch, epoch);
+    // Either a publisher sees this reader's epoch, or this reader sees its new model
+    ATOMIC_FENCE();
+    return (const magneto_Model *) ATOMIC_LOAD_ACQUIRE_PTR(&registry->model);
+}
+
+void magneto_ModelRegistry_release(ModelRegistry *const registry, const size_t i_reader) {
+    if ((registry == NULL) || (i_reader >= registry->num_readers)) {
+        return;
+    }
+    // Every read of the model happens before this
+    ATOMIC_STORE_RELEASE(&registry->readers[i_reader].epoch, 0U);
+}
+
+const magneto_Model *magneto_ModelRegistry_publish(ModelRegistry *const registry, const magneto_Model *const model) {
+    if ((registry == NULL) || (model == NULL)) {
+        return NULL;
+    }
+    const magneto_Model *const prev = (const magneto_Model *) ATOMIC_EXCHANGE_PTR(&registry->model, model);
+    ATOMIC_FENCE();
+    const size_t epoch = ATOMIC_FETCH_ADD(&registry->epoch, 1U) + 1U;
+    ATOMIC_FENCE();
+
+    // Any reader still holding `prev` loaded it before the swap, so announced an older epoch
+    for (size_t i = 0U; i < registry->num_readers; ++i) {
+        size_t reader_epoch = ATOMIC_LOAD_ACQUIRE(&registry->readers[i].epoch);
+        while ((reader_epoch != 0U) && (reader_epoch < epoch)) {
+            reader_epoch = ATOMIC_LOAD_ACQUIRE(&registry->readers[i].epoch);
+        }
+    }
+    return prev;
+}
+
+FieldState eval_field_registry(
+    ModelRegistry *const registry,
+    const size_t i_reader,
+    const DecYear t,
+    const Coords coords
+) {
+    const magneto_Model *const model = magneto_ModelRegistry_acquire(registry, i_reader);
+    if (model == NULL) {
+        const FieldState invalid = { 0 };
+        return invalid;
+    }
+    const FieldState state = eval_field(model, t, coords);
+    magneto_ModelRegistry_release(registry, i_reader);
+    return state;
+}
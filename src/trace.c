@@ -0,0 +1,85 @@
+#include "magneto/trace.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+#include "common_private.h"
+#include "trace_private.h"
+
+#ifdef MAGNETO_TRACE
+
+static magneto_TraceStats stats;
+static magneto_TraceHook term_hook = NULL;
+static void *term_hook_context = NULL;
+
+uint64_t magneto_trace_cycles(void) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    return __builtin_ia32_rdtsc();
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+#elif defined(__GNUC__) && defined(__aarch64__)
+    uint64_t ticks;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return (uint64_t) clock();
+#endif
+}
+
+void magneto_trace_stage_add(const magneto_TraceStage stage, const uint64_t cycles) {
+    if (stage < magneto_TRACE_NUM_STAGES) {
+        stats.stages[stage].calls += 1U;
+        stats.stages[stage].cycles += cycles;
+    }
+}
+
+void magneto_trace_term(
+    const size_t n,
+    const size_t m,
+    const real P,
+    const real dP,
+    const real g,
+    const real h
+) {
+    stats.terms += 1U;
+    if (term_hook != NULL) {
+        const magneto_TraceTerm term = { n, m, P, dP, g, h };
+        term_hook(&term, term_hook_context);
+    }
+}
+
+void magneto_trace_set_hook(const magneto_TraceHook hook, void *const context) {
+    term_hook = hook;
+    term_hook_context = context;
+}
+
+magneto_TraceStats magneto_trace_stats(void) {
+    return stats;
+}
+
+void magneto_trace_reset(void) {
+    const magneto_TraceStats zero = { 0 };
+    stats = zero;
+}
+
+#else
+
+void magneto_trace_set_hook(const magneto_TraceHook hook, void *const context) {
+    (void) hook;
+    (void) context;
+}
+
+magneto_TraceStats magneto_trace_stats(void) {
+    const magneto_TraceStats zero = { 0 };
+    return zero;
+}
+
+void magneto_trace_reset(void) {
+}
+
+#endif  // MAGNETO_TRACE
@@ -0,0 +1,33 @@
+#ifndef MAGNETO_TRACE_PRIVATE_H
+#define MAGNETO_TRACE_PRIVATE_H
+
+#include <stdint.h>
+
+#include "magneto/trace.h"
+
+#ifdef MAGNETO_TRACE
+
+// Internal symbols are suffixed like public ones in the single-precision half of a dual build
+#if defined(MAGNETO_DUAL_PRECISION) && defined(MAGNETO_SINGLE_PRECISION)
+#define magneto_trace_cycles                    magneto_trace_cycles_f
+#define magneto_trace_stage_add                 magneto_trace_stage_add_f
+#define magneto_trace_term                      magneto_trace_term_f
+#endif
+
+uint64_t magneto_trace_cycles(void);
+void magneto_trace_stage_add(magneto_TraceStage stage, uint64_t cycles);
+void magneto_trace_term(size_t n, size_t m, magneto_real P, magneto_real dP, magneto_real g, magneto_real h);
+
+#define TRACE_STAGE_BEGIN(name)         const uint64_t trace_begin_##name = magneto_trace_cycles()
+#define TRACE_STAGE_END(name, stage)    magneto_trace_stage_add((stage), magneto_trace_cycles() - trace_begin_##name)
+#define TRACE_TERM(n, m, P, dP, g, h)   magneto_trace_term((n), (m), (P), (dP), (g), (h))
+
+#else
+
+#define TRACE_STAGE_BEGIN(name)         ((void) 0)
+#define TRACE_STAGE_END(name, stage)    ((void) 0)
+#define TRACE_TERM(n, m, P, dP, g, h)   ((void) 0)
+
+#endif  // MAGNETO_TRACE
+
+#endif  // MAGNETO_TRACE_PRIVATE_H
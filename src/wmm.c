@@ -16,99 +16,100 @@
 STATIC_ASSERT(N_MAX == M_MAX, n_and_m_max_must_be_same);
 STATIC_ASSERT(MAGNETO_CALC_INDEX(1, 0) == 0, first_index_must_be_0);
 STATIC_ASSERT(MAGNETO_CALC_INDEX(N_MAX, M_MAX) == (TOTAL_COEFFS - 1), last_index_must_match_total);
+STATIC_ASSERT(MAGNETO_CALC_ORDER_INDEX(N_MAX, M_MAX, N_MAX) == (TOTAL_COEFFS - 1), last_order_index_must_match_total);
 
 static const magneto_SphericalHarmonicCoeff COEFFS_WMM2020[TOTAL_COEFFS] = {
     // Auto-generated table by `tools/gen_coeffs.py`
     { .g = REAL(-2.9404500000000000e+04), .h = REAL( 0.0000000000000000e+00) },  // (n =   1, m =   0)
     { .g = REAL(-1.4507000000000000e+03), .h = REAL( 4.6528999999999996e+03) },  // (n =   1, m =   1)
-    { .g = REAL(-1.2500000000000000e+03), .h = REAL( 0.0000000000000000e+00) },  // (n =   2, m =   0)
-    { .g = REAL( 1.7216585027234639e+03), .h = REAL(-1.7272010653076843e+03) },  // (n =   2, m =   1)
-    { .g = REAL( 4.8405046568858222e+02), .h = REAL(-2.1211848890026849e+02) },  // (n =   2, m =   2)
-    { .g = REAL( 6.8195000000000005e+02), .h = REAL( 0.0000000000000000e+00) },  // (n =   3, m =   0)
-    { .g = REAL(-1.4580587693916866e+03), .h = REAL(-5.0337014214194305e+01) },  // (n =   3, m =   1)
-    { .g = REAL( 4.7877820125816083e+02), .h = REAL( 9.3648737311295335e+01) },  // (n =   3, m =   2)
-    { .g = REAL( 8.3120468297525861e+01), .h = REAL(-8.5840027085270663e+01) },  // (n =   3, m =   3)
-    { .g = REAL( 1.1288750000000000e+02), .h = REAL( 0.0000000000000000e+00) },  // (n =   4, m =   0)
-    { .g = REAL( 1.2797737690701432e+02), .h = REAL( 4.4588115008374153e+01) },  // (n =   4, m =   1)
-    { .g = REAL( 9.6374529830240956e+00), .h = REAL(-1.7709658381798338e+01) },  // (n =   4, m =   2)
-    { .g = REAL(-1.8490186586403070e+01), .h = REAL( 1.1940333807250592e+01) },  // (n =   4, m =   3)
-    { .g = REAL( 1.0120722200373986e+00), .h = REAL(-7.3972126145113428e+00) },  // (n =   4, m =   4)
-    { .g = REAL(-2.9300000000000001e+01), .h = REAL( 0.0000000000000000e+00) },  // (n =   5, m =   0)
-    { .g = REAL( 5.8595010541996380e+01), .h = REAL( 7.6975544005872409e+00) },  // (n =   5, m =   1)
-    { .g = REAL( 2.2909254212466820e+01), .h = REAL( 2.5422196900309295e+01) },  // (n =   5, m =   2)
-    { .g = REAL(-1.0510541583334323e+01), .h = REAL(-9.0613268945163714e+00) },  // (n =   5, m =   3)
-    { .g = REAL(-5.3244718047896544e+00), .h = REAL( 1.1339152917607600e+00) },  // (n =   5, m =   4)
-    { .g = REAL( 1.5256162559167558e-01), .h = REAL( 1.1035662113967188e+00) },  // (n =   5, m =   5)
-    { .g = REAL( 1.3729166666666668e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =   6, m =   0)
-    { .g = REAL( 1.7893866999351369e+00), .h = REAL(-5.2099521293843176e-01) },  // (n =   6, m =   1)
-    { .g = REAL( 1.5742120572497456e+00), .h = REAL( 5.3911371823621423e-01) },  // (n =   6, m =   2)
-    { .g = REAL(-1.7467284470853341e+00), .h = REAL( 7.5763447869462641e-01) },  // (n =   6, m =   3)
-    { .g = REAL(-2.8504820672779224e-01), .h = REAL(-5.0710233462071330e-01) },  // (n =   6, m =   4)
-    { .g = REAL( 4.5327541726427639e-02), .h = REAL( 3.0218361150951761e-02) },  // (n =   6, m =   5)
-    { .g = REAL(-6.2710758763313612e-02), .h = REAL( 6.6006223675141515e-02) },  // (n =   6, m =   6)
-    { .g = REAL( 1.6791666666666665e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =   7, m =   0)
-    { .g = REAL(-2.1166010488516722e+00), .h = REAL(-1.4165793477991662e+00) },  // (n =   7, m =   1)
-    { .g = REAL(-1.8677134651661542e-01), .h = REAL(-3.7804320740712521e-01) },  // (n =   7, m =   2)
-    { .g = REAL( 8.9901224571182281e-01), .h = REAL( 3.6596958674994552e-02) },  // (n =   7, m =   3)
-    { .g = REAL( 1.5160303638031344e-01), .h = REAL( 2.2548552879350417e-01) },  // (n =   7, m =   4)
-    { .g = REAL( 3.0704412431455885e-02), .h = REAL(-1.0554641773312961e-02) },  // (n =   7, m =   5)
-    { .g = REAL(-1.3548669069928364e-02), .h = REAL(-5.1183860930840486e-02) },  // (n =   7, m =   6)
-    { .g = REAL( 4.9286297770162728e-03), .h = REAL(-9.5555067105417522e-04) },  // (n =   7, m =   7)
-    { .g = REAL( 6.1458333333333337e-02), .h = REAL( 0.0000000000000000e+00) },  // (n =   8, m =   0)
-    { .g = REAL( 3.4027777777777782e-02), .h = REAL( 2.9166666666666667e-02) },  // (n =   8, m =   1)
-    { .g = REAL(-5.0838716890091395e-02), .h = REAL(-4.4447563909622768e-02) },  // (n =   8, m =   2)
-    { .g = REAL(-8.5821441757406218e-04), .h = REAL( 2.7462861362369990e-02) },  // (n =   8, m =   3)
-    { .g = REAL(-2.9222182540084251e-02), .h = REAL(-1.6342263221468919e-02) },  // (n =   8, m =   4)
-    { .g = REAL( 1.1753844594950104e-02), .h = REAL( 1.1446554540180167e-02) },  // (n =   8, m =   5)
-    { .g = REAL( 4.8719821694714520e-03), .h = REAL( 1.2802288912479728e-03) },  // (n =   8, m =   6)
-    { .g = REAL(-2.1425868521027145e-03), .h = REAL(-8.9599086542477150e-04) },  // (n =   8, m =   7)
-    { .g = REAL(-9.7390311459214279e-06), .h = REAL( 9.0897624028600001e-05) },  // (n =   8, m =   8)
-    { .g = REAL( 1.3020833333333332e-02), .h = REAL( 0.0000000000000000e+00) },  // (n =   9, m =   0)
-    { .g = REAL( 2.8649620961716051e-02), .h = REAL(-8.1406849805851722e-02) },  // (n =   9, m =   1)
-    { .g = REAL( 8.6407547150381802e-03), .h = REAL( 3.3073233564456482e-02) },  // (n =   9, m =   2)
-    { .g = REAL(-3.1859584804880834e-03), .h = REAL( 2.2301709363416588e-02) },  // (n =   9, m =   3)
-    { .g = REAL(-1.7006255919061533e-03), .h = REAL(-7.8847186533830740e-03) },  // (n =   9, m =   4)
-    { .g = REAL(-1.2288210729148123e-02), .h = REAL(-5.7283388361442375e-03) },  // (n =   9, m =   5)
-    { .g = REAL( 5.2482445172476969e-04), .h = REAL( 3.7214824758665483e-03) },  // (n =   9, m =   6)
-    { .g = REAL( 1.8387048357799655e-03), .h = REAL( 8.2638419585616418e-05) },  // (n =   9, m =   7)
-    { .g = REAL(-6.5901529973659871e-04), .h = REAL(-1.0629279028009655e-04) },  // (n =   9, m =   8)
-    { .g = REAL(-1.9875737739993781e-04), .h = REAL( 1.6201231603188207e-04) },  // (n =   9, m =   9)
-    { .g = REAL(-4.9479166666666660e-04), .h = REAL( 0.0000000000000000e+00) },  // (n =  10, m =   0)
-    { .g = REAL(-2.1771037225375529e-03), .h = REAL( 1.1938955897786579e-03) },  // (n =  10, m =   1)
-    { .g = REAL(-3.0410115006309491e-05), .h = REAL(-6.0820230012618981e-05) },  // (n =  10, m =   2)
-    { .g = REAL( 4.0554616724186750e-04), .h = REAL( 8.3494799138031546e-04) },  // (n =  10, m =   3)
-    { .g = REAL(-1.5181647085108494e-04), .h = REAL( 8.0968784453911964e-04) },  // (n =  10, m =   4)
-    { .g = REAL( 6.4011444562398634e-05), .h = REAL(-9.1749737206104709e-04) },  // (n =  10, m =   5)
-    { .g = REAL(-5.3675228017305988e-05), .h = REAL(-5.9639142241451100e-06) },  // (n =  10, m =   6)
-    { .g = REAL( 5.4965543232612220e-05), .h = REAL(-1.2150277977735333e-04) },  // (n =  10, m =   7)
-    { .g = REAL( 1.6534434043570574e-05), .h = REAL(-4.0155054105814248e-05) },  // (n =  10, m =   8)
-    { .g = REAL(-9.1962493307687283e-06), .h = REAL(-3.8317705544869705e-07) },  // (n =  10, m =   9)
-    { .g = REAL(-3.3415587792658218e-06), .h = REAL(-7.5399275019331374e-06) },  // (n =  10, m =  10)
-    { .g = REAL( 7.8125000000000004e-04), .h = REAL( 0.0000000000000000e+00) },  // (n =  11, m =   0)
-    { .g = REAL(-4.9364816694836568e-04), .h = REAL( 0.0000000000000000e+00) },  // (n =  11, m =   1)
-    { .g = REAL(-7.7313943488978439e-04), .h = REAL( 8.0406501228537581e-04) },  // (n =  11, m =   2)
-    { .g = REAL( 5.9509499195552760e-04), .h = REAL(-1.2397812332406825e-04) },  // (n =  11, m =   3)
-    { .g = REAL(-1.6297347547619890e-04), .h = REAL(-7.2432655767199522e-05) },  // (n =  11, m =   4)
-    { .g = REAL( 3.5932273867492175e-05), .h = REAL( 7.1864547734984351e-05) },  // (n =  11, m =   5)
-    { .g = REAL(-4.9809553756847286e-05), .h = REAL(-1.4231301073384939e-05) },  // (n =  11, m =   6)
-    { .g = REAL(-3.7502771216246222e-06), .h = REAL(-6.3754711067618577e-05) },  // (n =  11, m =   7)
-    { .g = REAL( 2.4090432186113738e-05), .h = REAL(-2.7531922498415701e-05) },  // (n =  11, m =   8)
-    { .g = REAL(-3.9986503997038993e-06), .h = REAL(-1.9993251998519501e-05) },  // (n =  11, m =   9)
-    { .g = REAL( 4.1133676800104636e-07), .h = REAL(-4.1133676800104633e-06) },  // (n =  11, m =  10)
-    { .g = REAL( 1.3593080508189816e-06), .h = REAL(-1.1400648168159201e-06) },  // (n =  11, m =  11)
-    { .g = REAL(-4.3402777777777779e-05), .h = REAL( 0.0000000000000000e+00) },  // (n =  12, m =   0)
-    { .g = REAL(-2.9486381097515517e-06), .h = REAL(-3.5383657317018615e-05) },  // (n =  12, m =   1)
-    { .g = REAL( 1.3068441657910044e-05), .h = REAL( 1.3068441657910044e-05) },  // (n =  12, m =   2)
-    { .g = REAL( 2.7742878622516237e-05), .h = REAL( 2.7742878622516237e-05) },  // (n =  12, m =   3)
-    { .g = REAL(-1.9206608277126624e-05), .h = REAL(-2.8809912415689940e-05) },  // (n =  12, m =   4)
-    { .g = REAL( 7.6857810047984364e-06), .h = REAL( 1.0979687149712054e-06) },  // (n =  12, m =   5)
-    { .g = REAL( 2.0541113764093508e-06), .h = REAL( 4.7929265449551517e-06) },  // (n =  12, m =   6)
-    { .g = REAL( 1.9238515705535426e-06), .h = REAL(-3.8477031411070853e-07) },  // (n =  12, m =   7)
-    { .g = REAL(-3.8477031411070847e-07), .h = REAL( 1.1543109423321252e-06) },  // (n =  12, m =   8)
-    { .g = REAL(-4.1981883085339448e-07), .h = REAL( 1.6792753234135781e-07) },  // (n =  12, m =   9)
-    { .g = REAL( 3.1005675498566781e-08), .h = REAL(-2.7905107948710101e-07) },  // (n =  12, m =  10)
-    { .g = REAL(-1.0057382384307833e-07), .h = REAL( 0.0000000000000000e+00) },  // (n =  12, m =  11)
-    { .g = REAL(-5.5989670430932392e-09), .h = REAL( 9.3316117384887328e-09) },  // (n =  12, m =  12)
+    { .g = REAL(-3.7500000000000000e+03), .h = REAL( 0.0000000000000000e+00) },  // (n =   2, m =   0)
+    { .g = REAL( 5.1649755081703915e+03), .h = REAL(-5.1816031959230531e+03) },  // (n =   2, m =   1)
+    { .g = REAL( 1.4521513970657466e+03), .h = REAL(-6.3635546670080544e+02) },  // (n =   2, m =   2)
+    { .g = REAL( 3.4097500000000000e+03), .h = REAL( 0.0000000000000000e+00) },  // (n =   3, m =   0)
+    { .g = REAL(-7.2902938469584333e+03), .h = REAL(-2.5168507107097156e+02) },  // (n =   3, m =   1)
+    { .g = REAL( 2.3938910062908044e+03), .h = REAL( 4.6824368655647669e+02) },  // (n =   3, m =   2)
+    { .g = REAL( 4.1560234148762925e+02), .h = REAL(-4.2920013542635326e+02) },  // (n =   3, m =   3)
+    { .g = REAL( 3.9510625000000000e+03), .h = REAL( 0.0000000000000000e+00) },  // (n =   4, m =   0)
+    { .g = REAL( 4.4792081917455007e+03), .h = REAL( 1.5605840252930952e+03) },  // (n =   4, m =   1)
+    { .g = REAL( 3.3731085440584332e+02), .h = REAL(-6.1983804336294179e+02) },  // (n =   4, m =   2)
+    { .g = REAL(-6.4715653052410744e+02), .h = REAL( 4.1791168325377078e+02) },  // (n =   4, m =   3)
+    { .g = REAL( 3.5422527701308951e+01), .h = REAL(-2.5890244150789698e+02) },  // (n =   4, m =   4)
+    { .g = REAL(-1.8459000000000001e+03), .h = REAL( 0.0000000000000000e+00) },  // (n =   5, m =   0)
+    { .g = REAL( 3.6914856641457714e+03), .h = REAL( 4.8494592723699617e+02) },  // (n =   5, m =   1)
+    { .g = REAL( 1.4432830153854097e+03), .h = REAL( 1.6015984047194854e+03) },  // (n =   5, m =   2)
+    { .g = REAL(-6.6216411975006235e+02), .h = REAL(-5.7086359435453141e+02) },  // (n =   5, m =   3)
+    { .g = REAL(-3.3544172370174823e+02), .h = REAL( 7.1436663380927868e+01) },  // (n =   5, m =   4)
+    { .g = REAL( 9.6113824122755620e+00), .h = REAL( 6.9524671317993295e+01) },  // (n =   5, m =   5)
+    { .g = REAL( 9.5143125000000009e+02), .h = REAL( 0.0000000000000000e+00) },  // (n =   6, m =   0)
+    { .g = REAL( 1.2400449830550501e+03), .h = REAL(-3.6104968256633327e+02) },  // (n =   6, m =   1)
+    { .g = REAL( 1.0909289556740737e+03), .h = REAL( 3.7360580673769647e+02) },  // (n =   6, m =   2)
+    { .g = REAL(-1.2104828138301366e+03), .h = REAL( 5.2504069373537618e+02) },  // (n =   6, m =   3)
+    { .g = REAL(-1.9753840726236001e+02), .h = REAL(-3.5142191789215428e+02) },  // (n =   6, m =   4)
+    { .g = REAL( 3.1411986416414358e+01), .h = REAL( 2.0941324277609571e+01) },  // (n =   6, m =   5)
+    { .g = REAL(-4.3458555822976336e+01), .h = REAL( 4.5742313006873076e+01) },  // (n =   6, m =   6)
+    { .g = REAL( 2.1610874999999996e+03), .h = REAL( 0.0000000000000000e+00) },  // (n =   7, m =   0)
+    { .g = REAL(-2.7240655498721026e+03), .h = REAL(-1.8231376206175269e+03) },  // (n =   7, m =   1)
+    { .g = REAL(-2.4037472296688406e+02), .h = REAL(-4.8654160793297018e+02) },  // (n =   7, m =   2)
+    { .g = REAL( 1.1570287602311159e+03), .h = REAL( 4.7100285814717992e+01) },  // (n =   7, m =   3)
+    { .g = REAL( 1.9511310782146342e+02), .h = REAL( 2.9019987555723986e+02) },  // (n =   7, m =   4)
+    { .g = REAL( 3.9516578799283728e+01), .h = REAL(-1.3583823962253781e+01) },  // (n =   7, m =   5)
+    { .g = REAL(-1.7437137092997805e+01), .h = REAL(-6.5873629017991703e+01) },  // (n =   7, m =   6)
+    { .g = REAL( 6.3431465230199446e+00), .h = REAL(-1.2297937136467239e+00) },  // (n =   7, m =   7)
+    { .g = REAL( 1.1864531250000000e+03), .h = REAL( 0.0000000000000000e+00) },  // (n =   8, m =   0)
+    { .g = REAL( 6.5690625000000000e+02), .h = REAL( 5.6306250000000000e+02) },  // (n =   8, m =   1)
+    { .g = REAL(-9.8144142956321446e+02), .h = REAL(-8.5806022127526751e+02) },  // (n =   8, m =   2)
+    { .g = REAL(-1.6567829331267273e+01), .h = REAL( 5.3017053860055273e+02) },  // (n =   8, m =   3)
+    { .g = REAL(-5.6413423393632638e+02), .h = REAL(-3.1548739149045741e+02) },  // (n =   8, m =   4)
+    { .g = REAL( 2.2690796990551178e+02), .h = REAL( 2.2097573539817813e+02) },  // (n =   8, m =   5)
+    { .g = REAL( 9.4053615781646386e+01), .h = REAL( 2.4714818745542118e+01) },  // (n =   8, m =   6)
+    { .g = REAL(-4.1362639179842901e+01), .h = REAL(-1.7297103657025211e+01) },  // (n =   8, m =   7)
+    { .g = REAL(-1.8801199627201318e-01), .h = REAL( 1.7547786318721228e+00) },  // (n =   8, m =   8)
+    { .g = REAL( 4.7480468750000000e+02), .h = REAL( 0.0000000000000000e+00) },  // (n =   9, m =   0)
+    { .g = REAL( 1.0447084283689758e+03), .h = REAL(-2.9685007781703830e+03) },  // (n =   9, m =   1)
+    { .g = REAL( 3.1508512068386722e+02), .h = REAL( 1.2060154619279056e+03) },  // (n =   9, m =   2)
+    { .g = REAL(-1.1617597599099797e+02), .h = REAL( 8.1323183193698583e+02) },  // (n =   9, m =   3)
+    { .g = REAL(-6.2013312208857876e+01), .h = REAL(-2.8751626569561375e+02) },  // (n =   9, m =   4)
+    { .g = REAL(-4.4808960423838636e+02), .h = REAL(-2.0888387565999966e+02) },  // (n =   9, m =   5)
+    { .g = REAL( 1.9137723632143725e+01), .h = REAL( 1.3570385848247369e+02) },  // (n =   9, m =   6)
+    { .g = REAL( 6.7048371836716441e+01), .h = REAL( 3.0134099701895032e+00) },  // (n =   9, m =   7)
+    { .g = REAL(-2.4030992904895072e+01), .h = REAL(-3.8759665975637212e+00) },  // (n =   9, m =   8)
+    { .g = REAL(-7.2476877668887321e+00), .h = REAL( 5.9077791041025796e+00) },  // (n =   9, m =   9)
+    { .g = REAL(-3.4280898437499997e+02), .h = REAL( 0.0000000000000000e+00) },  // (n =  10, m =   0)
+    { .g = REAL(-1.5083736576043054e+03), .h = REAL( 8.2717265094429649e+02) },  // (n =  10, m =   1)
+    { .g = REAL(-2.1069192030396437e+01), .h = REAL(-4.2138384060792873e+01) },  // (n =  10, m =   2)
+    { .g = REAL( 2.8097657878101927e+02), .h = REAL( 5.7848119160798092e+02) },  // (n =  10, m =   3)
+    { .g = REAL(-1.0518376458211144e+02), .h = REAL( 5.6098007777126099e+02) },  // (n =  10, m =   4)
+    { .g = REAL( 4.4349369193389464e+01), .h = REAL(-6.3567429177191559e+02) },  // (n =  10, m =   5)
+    { .g = REAL(-3.7188076603370199e+01), .h = REAL(-4.1320085114855774e+00) },  // (n =  10, m =   6)
+    { .g = REAL( 3.8082052145566891e+01), .h = REAL(-8.4181378427042603e+01) },  // (n =  10, m =   7)
+    { .g = REAL( 1.1455634610577219e+01), .h = REAL(-2.7820826911401817e+01) },  // (n =  10, m =   8)
+    { .g = REAL(-6.3714834050831515e+00), .h = REAL(-2.6547847521179796e-01) },  // (n =  10, m =   9)
+    { .g = REAL(-2.3151488768326356e+00), .h = REAL(-5.2239256708018447e+00) },  // (n =  10, m =  10)
+    { .g = REAL( 1.0333476562500000e+03), .h = REAL( 0.0000000000000000e+00) },  // (n =  11, m =   0)
+    { .g = REAL(-6.5294102570009898e+02), .h = REAL( 0.0000000000000000e+00) },  // (n =  11, m =   1)
+    { .g = REAL(-1.0226199334371945e+03), .h = REAL( 1.0635247307746824e+03) },  // (n =  11, m =   2)
+    { .g = REAL( 7.8712321943469692e+02), .h = REAL(-1.6398400404889520e+02) },  // (n =  11, m =   3)
+    { .g = REAL(-2.1556257141023616e+02), .h = REAL(-9.5805587293438293e+01) },  // (n =  11, m =   4)
+    { .g = REAL( 4.7527079660423887e+01), .h = REAL( 9.5054159320847774e+01) },  // (n =  11, m =   5)
+    { .g = REAL(-6.5882349610875551e+01), .h = REAL(-1.8823528460250156e+01) },  // (n =  11, m =   6)
+    { .g = REAL(-4.9604352946160644e+00), .h = REAL(-8.4327400008473077e+01) },  // (n =  11, m =   7)
+    { .g = REAL( 3.1864053296089850e+01), .h = REAL(-3.6416060909816977e+01) },  // (n =  11, m =   8)
+    { .g = REAL(-5.2889549039323525e+00), .h = REAL(-2.6444774519661763e+01) },  // (n =  11, m =   9)
+    { .g = REAL( 5.4406897298346402e-01), .h = REAL(-5.4406897298346397e+00) },  // (n =  11, m =  10)
+    { .g = REAL( 1.7979363691975048e+00), .h = REAL(-1.5079466322301653e+00) },  // (n =  11, m =  11)
+    { .g = REAL(-1.3203886718750000e+03), .h = REAL( 0.0000000000000000e+00) },  // (n =  12, m =   0)
+    { .g = REAL(-8.9702746158524818e+01), .h = REAL(-1.0764329539022976e+03) },  // (n =  12, m =   1)
+    { .g = REAL( 3.9756493034873313e+02), .h = REAL( 3.9756493034873313e+02) },  // (n =  12, m =   2)
+    { .g = REAL( 8.4398705644892641e+02), .h = REAL( 8.4398705644892641e+02) },  // (n =  12, m =   3)
+    { .g = REAL(-5.8429873138771836e+02), .h = REAL(-8.7644809708157754e+02) },  // (n =  12, m =   4)
+    { .g = REAL( 2.3381494671163188e+02), .h = REAL( 3.3402135244518846e+01) },  // (n =  12, m =   5)
+    { .g = REAL( 6.2489673035838059e+01), .h = REAL( 1.4580923708362212e+02) },  // (n =  12, m =   6)
+    { .g = REAL( 5.8526941135745083e+01), .h = REAL(-1.1705388227149017e+01) },  // (n =  12, m =   7)
+    { .g = REAL(-1.1705388227149017e+01), .h = REAL( 3.5116164681447046e+01) },  // (n =  12, m =   8)
+    { .g = REAL(-1.2771625616608405e+01), .h = REAL( 5.1086502466433625e+00) },  // (n =  12, m =   9)
+    { .g = REAL( 9.4324706362690136e-01), .h = REAL(-8.4892235726421124e+00) },  // (n =  12, m =  10)
+    { .g = REAL(-3.0596322283672874e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =  12, m =  11)
+    { .g = REAL(-1.7033040363805696e-01), .h = REAL( 2.8388400606342828e-01) },  // (n =  12, m =  12)
 };
 
 static const magneto_ModelCoeffs SUBMODELS_WMM2020[NUM_MODELS] = {
@@ -119,99 +120,307 @@ static const magneto_SphericalHarmonicCoeff SECULAR_WMM2020[TOTAL_COEFFS] = {
     // Auto-generated table by `tools/gen_coeffs.py`
     { .g = REAL( 6.7000000000000002e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =   1, m =   0)
     { .g = REAL( 7.7000000000000002e+00), .h = REAL(-2.5100000000000001e+01) },  // (n =   1, m =   1)
-    { .g = REAL(-5.7500000000000000e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =   2, m =   0)
-    { .g = REAL(-4.0991869112463428e+00), .h = REAL(-1.7435978129526696e+01) },  // (n =   2, m =   1)
-    { .g = REAL(-6.3508529610858833e-01), .h = REAL(-6.8993357168160268e+00) },  // (n =   2, m =   2)
-    { .g = REAL( 1.3999999999999999e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =   3, m =   0)
-    { .g = REAL(-3.7967091013139260e+00), .h = REAL( 3.4905228834660287e+00) },  // (n =   3, m =   1)
-    { .g = REAL( 1.3168143377105215e+00), .h = REAL(-3.8729833462074165e-01) },  // (n =   3, m =   2)
-    { .g = REAL(-1.9289893727027114e+00), .h = REAL( 1.7392527130926089e-01) },  // (n =   3, m =   3)
-    { .g = REAL(-1.3750000000000001e-01), .h = REAL( 0.0000000000000000e+00) },  // (n =   4, m =   0)
-    { .g = REAL(-2.5298221281347039e-01), .h = REAL( 3.1622776601683798e-02) },  // (n =   4, m =   1)
-    { .g = REAL(-6.7082039324993703e-01), .h = REAL( 7.7144345223742761e-01) },  // (n =   4, m =   2)
-    { .g = REAL( 3.2271172452028629e-01), .h = REAL( 2.2111729272686284e-01) },  // (n =   4, m =   3)
-    { .g = REAL(-1.1620871002517104e-01), .h = REAL(-1.1832159566199232e-01) },  // (n =   4, m =   4)
-    { .g = REAL(-3.7499999999999999e-02), .h = REAL( 0.0000000000000000e+00) },  // (n =   5, m =   0)
-    { .g = REAL( 9.6824583655185412e-02), .h = REAL( 1.6137430609197572e-02) },  // (n =   5, m =   1)
-    { .g = REAL(-8.5391256382996661e-02), .h = REAL( 3.0496877279641665e-01) },  // (n =   5, m =   2)
-    { .g = REAL( 7.4701788083399601e-03), .h = REAL(-6.7231609275059639e-02) },  // (n =   5, m =   3)
-    { .g = REAL( 4.2257712736425833e-02), .h = REAL( 1.0564428184106459e-01) },  // (n =   5, m =   4)
-    { .g = REAL( 1.1135885079684349e-02), .h = REAL( 5.5679425398421746e-03) },  // (n =   5, m =   5)
-    { .g = REAL(-1.2499999999999999e-02), .h = REAL( 0.0000000000000000e+00) },  // (n =   6, m =   0)
-    { .g = REAL(-1.0910894511799617e-02), .h = REAL( 2.7277236279499044e-03) },  // (n =   6, m =   1)
-    { .g = REAL( 1.0782274364724285e-02), .h = REAL(-3.8816187713007426e-02) },  // (n =   6, m =   2)
-    { .g = REAL( 2.0126912147485330e-02), .h = REAL(-2.0126912147485330e-02) },  // (n =   6, m =   3)
-    { .g = REAL(-1.1023963796102461e-02), .h = REAL( 7.0868338689230115e-03) },  // (n =   6, m =   4)
-    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 3.3575956834390848e-04) },  // (n =   6, m =   5)
-    { .g = REAL( 7.7540350866539239e-04), .h = REAL( 9.6925438583174038e-04) },  // (n =   6, m =   6)
-    { .g = REAL(-2.0833333333333333e-03), .h = REAL( 0.0000000000000000e+00) },  // (n =   7, m =   0)
-    { .g = REAL(-8.2679728470768446e-03), .h = REAL( 1.3779954745128076e-02) },  // (n =   7, m =   1)
-    { .g = REAL(-2.2502571869471738e-03), .h = REAL( 1.3501543121683042e-02) },  // (n =   7, m =   2)
-    { .g = REAL( 1.1138204814128777e-02), .h = REAL(-1.1138204814128777e-02) },  // (n =   7, m =   3)
-    { .g = REAL( 1.9190257769659928e-03), .h = REAL(-1.9190257769659928e-03) },  // (n =   7, m =   4)
-    { .g = REAL(-2.3987822212074910e-03), .h = REAL(-5.7570773308979785e-03) },  // (n =   7, m =   5)
-    { .g = REAL(-1.5054076744364850e-03), .h = REAL( 3.7635191860912125e-04) },  // (n =   7, m =   6)
-    { .g = REAL( 5.0292140581798699e-04), .h = REAL( 1.5087642174539610e-04) },  // (n =   7, m =   7)
-    { .g = REAL(-2.6041666666666666e-04), .h = REAL( 0.0000000000000000e+00) },  // (n =   8, m =   0)
-    { .g = REAL( 3.4722222222222224e-04), .h = REAL(-1.0416666666666667e-03) },  // (n =   8, m =   1)
-    { .g = REAL(-2.9050695365766515e-04), .h = REAL( 2.0335486756036560e-03) },  // (n =   8, m =   2)
-    { .g = REAL( 1.0727680219675777e-03), .h = REAL(-4.2910720878703109e-04) },  // (n =   8, m =   3)
-    { .g = REAL(-1.3849375611414336e-04), .h = REAL( 6.9246878057071680e-04) },  // (n =   8, m =   4)
-    { .g = REAL( 3.0729005476993739e-04), .h = REAL(-2.3046754107745301e-04) },  // (n =   8, m =   5)
-    { .g = REAL( 1.7780956822888511e-04), .h = REAL(-1.7780956822888511e-04) },  // (n =   8, m =   6)
-    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 5.1941499444914289e-05) },  // (n =   8, m =   7)
-    { .g = REAL( 1.2985374861228572e-05), .h = REAL( 3.2463437153071431e-06) },  // (n =   8, m =   8)
-    { .g = REAL(-2.6041666666666666e-04), .h = REAL( 0.0000000000000000e+00) },  // (n =   9, m =   0)
-    { .g = REAL(-6.9877124296868428e-04), .h = REAL(-1.0481568644530263e-03) },  // (n =   9, m =   1)
-    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 5.9591411827849519e-04) },  // (n =   9, m =   2)
-    { .g = REAL( 9.1027385156802396e-04), .h = REAL(-9.1027385156802396e-04) },  // (n =   9, m =   3)
-    { .g = REAL(-4.6380697961076901e-04), .h = REAL( 6.1840930614769215e-04) },  // (n =   9, m =   4)
-    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 9.2392561873294154e-05) },  // (n =   9, m =   5)
-    { .g = REAL( 1.4313394137948263e-04), .h = REAL( 0.0000000000000000e+00) },  // (n =   9, m =   6)
-    { .g = REAL( 0.0000000000000000e+00), .h = REAL(-4.1319209792808209e-05) },  // (n =   9, m =   7)
-    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 3.5430930093365516e-05) },  // (n =   9, m =   8)
-    { .g = REAL(-6.6809202487374053e-06), .h = REAL( 3.3404601243687027e-06) },  // (n =   9, m =   9)
+    { .g = REAL(-1.7250000000000000e+01), .h = REAL( 0.0000000000000000e+00) },  // (n =   2, m =   0)
+    { .g = REAL(-1.2297560733739028e+01), .h = REAL(-5.2307934388580087e+01) },  // (n =   2, m =   1)
+    { .g = REAL(-1.9052558883257651e+00), .h = REAL(-2.0698007150448081e+01) },  // (n =   2, m =   2)
+    { .g = REAL( 7.0000000000000000e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =   3, m =   0)
+    { .g = REAL(-1.8983545506569630e+01), .h = REAL( 1.7452614417330143e+01) },  // (n =   3, m =   1)
+    { .g = REAL( 6.5840716885526076e+00), .h = REAL(-1.9364916731037083e+00) },  // (n =   3, m =   2)
+    { .g = REAL(-9.6449468635135549e+00), .h = REAL( 8.6962635654630427e-01) },  // (n =   3, m =   3)
+    { .g = REAL(-4.8125000000000000e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =   4, m =   0)
+    { .g = REAL(-8.8543774484714621e+00), .h = REAL( 1.1067971810589328e+00) },  // (n =   4, m =   1)
+    { .g = REAL(-2.3478713763747791e+01), .h = REAL( 2.7000520828309963e+01) },  // (n =   4, m =   2)
+    { .g = REAL( 1.1294910358210021e+01), .h = REAL( 7.7391052454401992e+00) },  // (n =   4, m =   3)
+    { .g = REAL(-4.0673048508809861e+00), .h = REAL(-4.1412558481697310e+00) },  // (n =   4, m =   4)
+    { .g = REAL(-2.3624999999999998e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =   5, m =   0)
+    { .g = REAL( 6.0999487702766801e+00), .h = REAL( 1.0166581283794469e+00) },  // (n =   5, m =   1)
+    { .g = REAL(-5.3796491521287892e+00), .h = REAL( 1.9213032686174248e+01) },  // (n =   5, m =   2)
+    { .g = REAL( 4.7062126492541750e-01), .h = REAL(-4.2355913843287576e+00) },  // (n =   5, m =   3)
+    { .g = REAL( 2.6622359023948272e+00), .h = REAL( 6.6555897559870685e+00) },  // (n =   5, m =   4)
+    { .g = REAL( 7.0156076002011403e-01), .h = REAL( 3.5078038001005701e-01) },  // (n =   5, m =   5)
+    { .g = REAL(-8.6624999999999996e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =   6, m =   0)
+    { .g = REAL(-7.5612498966771362e+00), .h = REAL( 1.8903124741692841e+00) },  // (n =   6, m =   1)
+    { .g = REAL( 7.4721161347539296e+00), .h = REAL(-2.6899618085114145e+01) },  // (n =   6, m =   2)
+    { .g = REAL( 1.3947950118207336e+01), .h = REAL(-1.3947950118207336e+01) },  // (n =   6, m =   3)
+    { .g = REAL(-7.6396069106990048e+00), .h = REAL( 4.9111758711636462e+00) },  // (n =   6, m =   4)
+    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 2.3268138086232859e-01) },  // (n =   6, m =   5)
+    { .g = REAL( 5.3735463150511698e-01), .h = REAL( 6.7169328938139616e-01) },  // (n =   6, m =   6)
+    { .g = REAL(-2.6812500000000004e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =   7, m =   0)
+    { .g = REAL(-1.0640881054187901e+01), .h = REAL( 1.7734801756979834e+01) },  // (n =   7, m =   1)
+    { .g = REAL(-2.8960809996010131e+00), .h = REAL( 1.7376485997606075e+01) },  // (n =   7, m =   2)
+    { .g = REAL( 1.4334869595783736e+01), .h = REAL(-1.4334869595783736e+01) },  // (n =   7, m =   3)
+    { .g = REAL( 2.4697861749552334e+00), .h = REAL(-2.4697861749552334e+00) },  // (n =   7, m =   4)
+    { .g = REAL(-3.0872327186940409e+00), .h = REAL(-7.4093585248656977e+00) },  // (n =   7, m =   5)
+    { .g = REAL(-1.9374596769997561e+00), .h = REAL( 4.8436491924993902e-01) },  // (n =   7, m =   6)
+    { .g = REAL( 6.4725984928774938e-01), .h = REAL( 1.9417795478632480e-01) },  // (n =   7, m =   7)
+    { .g = REAL(-5.0273437500000000e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =   8, m =   0)
+    { .g = REAL( 6.7031250000000000e+00), .h = REAL(-2.0109375000000000e+01) },  // (n =   8, m =   1)
+    { .g = REAL(-5.6082367403612254e+00), .h = REAL( 3.9257657182528575e+01) },  // (n =   8, m =   2)
+    { .g = REAL( 2.0709786664084088e+01), .h = REAL(-8.2839146656336364e+00) },  // (n =   8, m =   3)
+    { .g = REAL(-2.6736219617835375e+00), .h = REAL( 1.3368109808917687e+01) },  // (n =   8, m =   4)
+    { .g = REAL( 5.9322345073336411e+00), .h = REAL(-4.4491758805002304e+00) },  // (n =   8, m =   5)
+    { .g = REAL( 3.4326137146586273e+00), .h = REAL(-3.4326137146586273e+00) },  // (n =   8, m =   6)
+    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 1.0027306467840702e+00) },  // (n =   8, m =   7)
+    { .g = REAL( 2.5068266169601755e-01), .h = REAL( 6.2670665424004388e-02) },  // (n =   8, m =   8)
+    { .g = REAL(-9.4960937500000000e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =   9, m =   0)
+    { .g = REAL(-2.5480693374853075e+01), .h = REAL(-3.8221040062279606e+01) },  // (n =   9, m =   1)
+    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 2.1730008323025331e+01) },  // (n =   9, m =   2)
+    { .g = REAL( 3.3193135997427994e+01), .h = REAL(-3.3193135997427994e+01) },  // (n =   9, m =   3)
+    { .g = REAL(-1.6912721511506692e+01), .h = REAL( 2.2550295348675590e+01) },  // (n =   9, m =   4)
+    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 3.3690947687096719e+00) },  // (n =   9, m =   5)
+    { .g = REAL( 5.2193791724028342e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =   9, m =   6)
+    { .g = REAL( 0.0000000000000000e+00), .h = REAL(-1.5067049850947516e+00) },  // (n =   9, m =   7)
+    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 1.2919888658545737e+00) },  // (n =   9, m =   8)
+    { .g = REAL(-2.4361975687020948e-01), .h = REAL( 1.2180987843510474e-01) },  // (n =   9, m =   9)
     { .g = REAL( 0.0000000000000000e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =  10, m =   0)
     { .g = REAL( 0.0000000000000000e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =  10, m =   1)
-    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 3.0410115006309491e-05) },  // (n =  10, m =   2)
-    { .g = REAL( 4.7711313793160887e-05), .h = REAL(-7.1566970689741327e-05) },  // (n =  10, m =   3)
-    { .g = REAL(-1.6868496761231663e-05), .h = REAL( 1.6868496761231663e-05) },  // (n =  10, m =   4)
-    { .g = REAL(-2.1337148187466214e-05), .h = REAL(-2.1337148187466214e-05) },  // (n =  10, m =   5)
-    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 5.9639142241451100e-06) },  // (n =  10, m =   6)
-    { .g = REAL(-2.8929233280322222e-06), .h = REAL( 0.0000000000000000e+00) },  // (n =  10, m =   7)
-    { .g = REAL(-2.3620620062243678e-06), .h = REAL(-1.1810310031121839e-06) },  // (n =  10, m =   8)
-    { .g = REAL(-3.8317705544869705e-07), .h = REAL( 7.6635411089739410e-07) },  // (n =  10, m =   9)
+    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 2.1069192030396437e+01) },  // (n =  10, m =   2)
+    { .g = REAL( 3.3056068091884626e+01), .h = REAL(-4.9584102137826932e+01) },  // (n =  10, m =   3)
+    { .g = REAL(-1.1687084953567938e+01), .h = REAL( 1.1687084953567938e+01) },  // (n =  10, m =   4)
+    { .g = REAL(-1.4783123064463155e+01), .h = REAL(-1.4783123064463155e+01) },  // (n =  10, m =   5)
+    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 4.1320085114855774e+00) },  // (n =  10, m =   6)
+    { .g = REAL(-2.0043185339772047e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =  10, m =   7)
+    { .g = REAL(-1.6365192300824600e+00), .h = REAL(-8.1825961504123002e-01) },  // (n =  10, m =   8)
+    { .g = REAL(-2.6547847521179796e-01), .h = REAL( 5.3095695042359592e-01) },  // (n =  10, m =   9)
     { .g = REAL( 0.0000000000000000e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =  10, m =  10)
     { .g = REAL( 0.0000000000000000e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =  11, m =   0)
-    { .g = REAL(-3.5260583353454692e-05), .h = REAL( 0.0000000000000000e+00) },  // (n =  11, m =   1)
-    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 3.0925577395591381e-05) },  // (n =  11, m =   2)
+    { .g = REAL(-4.6638644692864219e+01), .h = REAL( 0.0000000000000000e+00) },  // (n =  11, m =   1)
+    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 4.0904797337487786e+01) },  // (n =  11, m =   2)
     { .g = REAL( 0.0000000000000000e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =  11, m =   3)
-    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 3.6216327883599761e-05) },  // (n =  11, m =   4)
-    { .g = REAL(-1.1977424622497393e-05), .h = REAL( 0.0000000000000000e+00) },  // (n =  11, m =   5)
+    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 4.7902793646719147e+01) },  // (n =  11, m =   4)
+    { .g = REAL(-1.5842359886807964e+01), .h = REAL( 0.0000000000000000e+00) },  // (n =  11, m =   5)
     { .g = REAL( 0.0000000000000000e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =  11, m =   6)
-    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 3.7502771216246222e-06) },  // (n =  11, m =   7)
-    { .g = REAL(-1.7207451561509813e-06), .h = REAL( 0.0000000000000000e+00) },  // (n =  11, m =   8)
-    { .g = REAL(-6.6644173328398332e-07), .h = REAL(-6.6644173328398332e-07) },  // (n =  11, m =   9)
-    { .g = REAL(-2.0566838400052318e-07), .h = REAL( 0.0000000000000000e+00) },  // (n =  11, m =  10)
-    { .g = REAL(-4.3848646800612310e-08), .h = REAL( 0.0000000000000000e+00) },  // (n =  11, m =  11)
+    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 4.9604352946160644e+00) },  // (n =  11, m =   7)
+    { .g = REAL(-2.2760038068635611e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =  11, m =   8)
+    { .g = REAL(-8.8149248398872548e-01), .h = REAL(-8.8149248398872548e-01) },  // (n =  11, m =   9)
+    { .g = REAL(-2.7203448649173201e-01), .h = REAL( 0.0000000000000000e+00) },  // (n =  11, m =  10)
+    { .g = REAL(-5.7997947393467898e-02), .h = REAL( 0.0000000000000000e+00) },  // (n =  11, m =  11)
     { .g = REAL( 0.0000000000000000e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =  12, m =   0)
     { .g = REAL( 0.0000000000000000e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =  12, m =   1)
     { .g = REAL( 0.0000000000000000e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =  12, m =   2)
-    { .g = REAL( 0.0000000000000000e+00), .h = REAL(-2.1340675863474029e-06) },  // (n =  12, m =   3)
-    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 1.6005506897605523e-06) },  // (n =  12, m =   4)
+    { .g = REAL( 0.0000000000000000e+00), .h = REAL(-6.4922081265302026e+01) },  // (n =  12, m =   3)
+    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 4.8691560948976530e+01) },  // (n =  12, m =   4)
     { .g = REAL( 0.0000000000000000e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =  12, m =   5)
     { .g = REAL( 0.0000000000000000e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =  12, m =   6)
     { .g = REAL( 0.0000000000000000e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =  12, m =   7)
-    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 1.9238515705535424e-07) },  // (n =  12, m =   8)
+    { .g = REAL( 0.0000000000000000e+00), .h = REAL( 5.8526941135745085e+00) },  // (n =  12, m =   8)
     { .g = REAL( 0.0000000000000000e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =  12, m =   9)
     { .g = REAL( 0.0000000000000000e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =  12, m =  10)
     { .g = REAL( 0.0000000000000000e+00), .h = REAL( 0.0000000000000000e+00) },  // (n =  12, m =  11)
-    { .g = REAL(-1.8663223476977468e-09), .h = REAL(-1.8663223476977468e-09) },  // (n =  12, m =  12)
+    { .g = REAL(-5.6776801212685662e-02), .h = REAL(-5.6776801212685662e-02) },  // (n =  12, m =  12)
+};
+
+static const magneto_RecursionConsts RECURSION_WMM2020[TOTAL_COEFFS] = {
+    // Auto-generated table by `tools/gen_coeffs.py`
+    { .K = REAL( 0.0000000000000000e+00), .n_plus_1 = REAL(  2.0), .m = REAL(  0.0) },  // (n =   1, m =   0)
+    { .K = REAL( 0.0000000000000000e+00), .n_plus_1 = REAL(  2.0), .m = REAL(  1.0) },  // (n =   1, m =   1)
+    { .K = REAL( 3.3333333333333331e-01), .n_plus_1 = REAL(  3.0), .m = REAL(  0.0) },  // (n =   2, m =   0)
+    { .K = REAL( 0.0000000000000000e+00), .n_plus_1 = REAL(  3.0), .m = REAL(  1.0) },  // (n =   2, m =   1)
+    { .K = REAL(-1.0000000000000000e+00), .n_plus_1 = REAL(  3.0), .m = REAL(  2.0) },  // (n =   2, m =   2)
+    { .K = REAL( 2.6666666666666666e-01), .n_plus_1 = REAL(  4.0), .m = REAL(  0.0) },  // (n =   3, m =   0)
+    { .K = REAL( 2.0000000000000001e-01), .n_plus_1 = REAL(  4.0), .m = REAL(  1.0) },  // (n =   3, m =   1)
+    { .K = REAL( 0.0000000000000000e+00), .n_plus_1 = REAL(  4.0), .m = REAL(  2.0) },  // (n =   3, m =   2)
+    { .K = REAL(-3.3333333333333331e-01), .n_plus_1 = REAL(  4.0), .m = REAL(  3.0) },  // (n =   3, m =   3)
+    { .K = REAL( 2.5714285714285712e-01), .n_plus_1 = REAL(  5.0), .m = REAL(  0.0) },  // (n =   4, m =   0)
+    { .K = REAL( 2.2857142857142856e-01), .n_plus_1 = REAL(  5.0), .m = REAL(  1.0) },  // (n =   4, m =   1)
+    { .K = REAL( 1.4285714285714285e-01), .n_plus_1 = REAL(  5.0), .m = REAL(  2.0) },  // (n =   4, m =   2)
+    { .K = REAL( 0.0000000000000000e+00), .n_plus_1 = REAL(  5.0), .m = REAL(  3.0) },  // (n =   4, m =   3)
+    { .K = REAL(-2.0000000000000001e-01), .n_plus_1 = REAL(  5.0), .m = REAL(  4.0) },  // (n =   4, m =   4)
+    { .K = REAL( 2.5396825396825395e-01), .n_plus_1 = REAL(  6.0), .m = REAL(  0.0) },  // (n =   5, m =   0)
+    { .K = REAL( 2.3809523809523808e-01), .n_plus_1 = REAL(  6.0), .m = REAL(  1.0) },  // (n =   5, m =   1)
+    { .K = REAL( 1.9047619047619047e-01), .n_plus_1 = REAL(  6.0), .m = REAL(  2.0) },  // (n =   5, m =   2)
+    { .K = REAL( 1.1111111111111110e-01), .n_plus_1 = REAL(  6.0), .m = REAL(  3.0) },  // (n =   5, m =   3)
+    { .K = REAL( 0.0000000000000000e+00), .n_plus_1 = REAL(  6.0), .m = REAL(  4.0) },  // (n =   5, m =   4)
+    { .K = REAL(-1.4285714285714285e-01), .n_plus_1 = REAL(  6.0), .m = REAL(  5.0) },  // (n =   5, m =   5)
+    { .K = REAL( 2.5252525252525254e-01), .n_plus_1 = REAL(  7.0), .m = REAL(  0.0) },  // (n =   6, m =   0)
+    { .K = REAL( 2.4242424242424243e-01), .n_plus_1 = REAL(  7.0), .m = REAL(  1.0) },  // (n =   6, m =   1)
+    { .K = REAL( 2.1212121212121213e-01), .n_plus_1 = REAL(  7.0), .m = REAL(  2.0) },  // (n =   6, m =   2)
+    { .K = REAL( 1.6161616161616163e-01), .n_plus_1 = REAL(  7.0), .m = REAL(  3.0) },  // (n =   6, m =   3)
+    { .K = REAL( 9.0909090909090912e-02), .n_plus_1 = REAL(  7.0), .m = REAL(  4.0) },  // (n =   6, m =   4)
+    { .K = REAL( 0.0000000000000000e+00), .n_plus_1 = REAL(  7.0), .m = REAL(  5.0) },  // (n =   6, m =   5)
+    { .K = REAL(-1.1111111111111110e-01), .n_plus_1 = REAL(  7.0), .m = REAL(  6.0) },  // (n =   6, m =   6)
+    { .K = REAL( 2.5174825174825177e-01), .n_plus_1 = REAL(  8.0), .m = REAL(  0.0) },  // (n =   7, m =   0)
+    { .K = REAL( 2.4475524475524477e-01), .n_plus_1 = REAL(  8.0), .m = REAL(  1.0) },  // (n =   7, m =   1)
+    { .K = REAL( 2.2377622377622378e-01), .n_plus_1 = REAL(  8.0), .m = REAL(  2.0) },  // (n =   7, m =   2)
+    { .K = REAL( 1.8881118881118880e-01), .n_plus_1 = REAL(  8.0), .m = REAL(  3.0) },  // (n =   7, m =   3)
+    { .K = REAL( 1.3986013986013987e-01), .n_plus_1 = REAL(  8.0), .m = REAL(  4.0) },  // (n =   7, m =   4)
+    { .K = REAL( 7.6923076923076927e-02), .n_plus_1 = REAL(  8.0), .m = REAL(  5.0) },  // (n =   7, m =   5)
+    { .K = REAL( 0.0000000000000000e+00), .n_plus_1 = REAL(  8.0), .m = REAL(  6.0) },  // (n =   7, m =   6)
+    { .K = REAL(-9.0909090909090912e-02), .n_plus_1 = REAL(  8.0), .m = REAL(  7.0) },  // (n =   7, m =   7)
+    { .K = REAL( 2.5128205128205128e-01), .n_plus_1 = REAL(  9.0), .m = REAL(  0.0) },  // (n =   8, m =   0)
+    { .K = REAL( 2.4615384615384617e-01), .n_plus_1 = REAL(  9.0), .m = REAL(  1.0) },  // (n =   8, m =   1)
+    { .K = REAL( 2.3076923076923078e-01), .n_plus_1 = REAL(  9.0), .m = REAL(  2.0) },  // (n =   8, m =   2)
+    { .K = REAL( 2.0512820512820512e-01), .n_plus_1 = REAL(  9.0), .m = REAL(  3.0) },  // (n =   8, m =   3)
+    { .K = REAL( 1.6923076923076924e-01), .n_plus_1 = REAL(  9.0), .m = REAL(  4.0) },  // (n =   8, m =   4)
+    { .K = REAL( 1.2307692307692308e-01), .n_plus_1 = REAL(  9.0), .m = REAL(  5.0) },  // (n =   8, m =   5)
+    { .K = REAL( 6.6666666666666666e-02), .n_plus_1 = REAL(  9.0), .m = REAL(  6.0) },  // (n =   8, m =   6)
+    { .K = REAL( 0.0000000000000000e+00), .n_plus_1 = REAL(  9.0), .m = REAL(  7.0) },  // (n =   8, m =   7)
+    { .K = REAL(-7.6923076923076927e-02), .n_plus_1 = REAL(  9.0), .m = REAL(  8.0) },  // (n =   8, m =   8)
+    { .K = REAL( 2.5098039215686274e-01), .n_plus_1 = REAL( 10.0), .m = REAL(  0.0) },  // (n =   9, m =   0)
+    { .K = REAL( 2.4705882352941178e-01), .n_plus_1 = REAL( 10.0), .m = REAL(  1.0) },  // (n =   9, m =   1)
+    { .K = REAL( 2.3529411764705882e-01), .n_plus_1 = REAL( 10.0), .m = REAL(  2.0) },  // (n =   9, m =   2)
+    { .K = REAL( 2.1568627450980393e-01), .n_plus_1 = REAL( 10.0), .m = REAL(  3.0) },  // (n =   9, m =   3)
+    { .K = REAL( 1.8823529411764706e-01), .n_plus_1 = REAL( 10.0), .m = REAL(  4.0) },  // (n =   9, m =   4)
+    { .K = REAL( 1.5294117647058825e-01), .n_plus_1 = REAL( 10.0), .m = REAL(  5.0) },  // (n =   9, m =   5)
+    { .K = REAL( 1.0980392156862745e-01), .n_plus_1 = REAL( 10.0), .m = REAL(  6.0) },  // (n =   9, m =   6)
+    { .K = REAL( 5.8823529411764705e-02), .n_plus_1 = REAL( 10.0), .m = REAL(  7.0) },  // (n =   9, m =   7)
+    { .K = REAL( 0.0000000000000000e+00), .n_plus_1 = REAL( 10.0), .m = REAL(  8.0) },  // (n =   9, m =   8)
+    { .K = REAL(-6.6666666666666666e-02), .n_plus_1 = REAL( 10.0), .m = REAL(  9.0) },  // (n =   9, m =   9)
+    { .K = REAL( 2.5077399380804954e-01), .n_plus_1 = REAL( 11.0), .m = REAL(  0.0) },  // (n =  10, m =   0)
+    { .K = REAL( 2.4767801857585139e-01), .n_plus_1 = REAL( 11.0), .m = REAL(  1.0) },  // (n =  10, m =   1)
+    { .K = REAL( 2.3839009287925697e-01), .n_plus_1 = REAL( 11.0), .m = REAL(  2.0) },  // (n =  10, m =   2)
+    { .K = REAL( 2.2291021671826625e-01), .n_plus_1 = REAL( 11.0), .m = REAL(  3.0) },  // (n =  10, m =   3)
+    { .K = REAL( 2.0123839009287925e-01), .n_plus_1 = REAL( 11.0), .m = REAL(  4.0) },  // (n =  10, m =   4)
+    { .K = REAL( 1.7337461300309598e-01), .n_plus_1 = REAL( 11.0), .m = REAL(  5.0) },  // (n =  10, m =   5)
+    { .K = REAL( 1.3931888544891641e-01), .n_plus_1 = REAL( 11.0), .m = REAL(  6.0) },  // (n =  10, m =   6)
+    { .K = REAL( 9.9071207430340563e-02), .n_plus_1 = REAL( 11.0), .m = REAL(  7.0) },  // (n =  10, m =   7)
+    { .K = REAL( 5.2631578947368418e-02), .n_plus_1 = REAL( 11.0), .m = REAL(  8.0) },  // (n =  10, m =   8)
+    { .K = REAL( 0.0000000000000000e+00), .n_plus_1 = REAL( 11.0), .m = REAL(  9.0) },  // (n =  10, m =   9)
+    { .K = REAL(-5.8823529411764705e-02), .n_plus_1 = REAL( 11.0), .m = REAL( 10.0) },  // (n =  10, m =  10)
+    { .K = REAL( 2.5062656641604009e-01), .n_plus_1 = REAL( 12.0), .m = REAL(  0.0) },  // (n =  11, m =   0)
+    { .K = REAL( 2.4812030075187969e-01), .n_plus_1 = REAL( 12.0), .m = REAL(  1.0) },  // (n =  11, m =   1)
+    { .K = REAL( 2.4060150375939848e-01), .n_plus_1 = REAL( 12.0), .m = REAL(  2.0) },  // (n =  11, m =   2)
+    { .K = REAL( 2.2807017543859648e-01), .n_plus_1 = REAL( 12.0), .m = REAL(  3.0) },  // (n =  11, m =   3)
+    { .K = REAL( 2.1052631578947367e-01), .n_plus_1 = REAL( 12.0), .m = REAL(  4.0) },  // (n =  11, m =   4)
+    { .K = REAL( 1.8796992481203006e-01), .n_plus_1 = REAL( 12.0), .m = REAL(  5.0) },  // (n =  11, m =   5)
+    { .K = REAL( 1.6040100250626566e-01), .n_plus_1 = REAL( 12.0), .m = REAL(  6.0) },  // (n =  11, m =   6)
+    { .K = REAL( 1.2781954887218044e-01), .n_plus_1 = REAL( 12.0), .m = REAL(  7.0) },  // (n =  11, m =   7)
+    { .K = REAL( 9.0225563909774431e-02), .n_plus_1 = REAL( 12.0), .m = REAL(  8.0) },  // (n =  11, m =   8)
+    { .K = REAL( 4.7619047619047616e-02), .n_plus_1 = REAL( 12.0), .m = REAL(  9.0) },  // (n =  11, m =   9)
+    { .K = REAL( 0.0000000000000000e+00), .n_plus_1 = REAL( 12.0), .m = REAL( 10.0) },  // (n =  11, m =  10)
+    { .K = REAL(-5.2631578947368418e-02), .n_plus_1 = REAL( 12.0), .m = REAL( 11.0) },  // (n =  11, m =  11)
+    { .K = REAL( 2.5051759834368531e-01), .n_plus_1 = REAL( 13.0), .m = REAL(  0.0) },  // (n =  12, m =   0)
+    { .K = REAL( 2.4844720496894410e-01), .n_plus_1 = REAL( 13.0), .m = REAL(  1.0) },  // (n =  12, m =   1)
+    { .K = REAL( 2.4223602484472051e-01), .n_plus_1 = REAL( 13.0), .m = REAL(  2.0) },  // (n =  12, m =   2)
+    { .K = REAL( 2.3188405797101450e-01), .n_plus_1 = REAL( 13.0), .m = REAL(  3.0) },  // (n =  12, m =   3)
+    { .K = REAL( 2.1739130434782608e-01), .n_plus_1 = REAL( 13.0), .m = REAL(  4.0) },  // (n =  12, m =   4)
+    { .K = REAL( 1.9875776397515527e-01), .n_plus_1 = REAL( 13.0), .m = REAL(  5.0) },  // (n =  12, m =   5)
+    { .K = REAL( 1.7598343685300208e-01), .n_plus_1 = REAL( 13.0), .m = REAL(  6.0) },  // (n =  12, m =   6)
+    { .K = REAL( 1.4906832298136646e-01), .n_plus_1 = REAL( 13.0), .m = REAL(  7.0) },  // (n =  12, m =   7)
+    { .K = REAL( 1.1801242236024845e-01), .n_plus_1 = REAL( 13.0), .m = REAL(  8.0) },  // (n =  12, m =   8)
+    { .K = REAL( 8.2815734989648032e-02), .n_plus_1 = REAL( 13.0), .m = REAL(  9.0) },  // (n =  12, m =   9)
+    { .K = REAL( 4.3478260869565216e-02), .n_plus_1 = REAL( 13.0), .m = REAL( 10.0) },  // (n =  12, m =  10)
+    { .K = REAL( 0.0000000000000000e+00), .n_plus_1 = REAL( 13.0), .m = REAL( 11.0) },  // (n =  12, m =  11)
+    { .K = REAL(-4.7619047619047616e-02), .n_plus_1 = REAL( 13.0), .m = REAL( 12.0) },  // (n =  12, m =  12)
+};
+
+static const magneto_real DEGREE_BOUNDS_WMM2020[N_MAX + 1U] = {
+    // Auto-generated table by `tools/gen_coeffs.py`
+    REAL( 0.0000000000000000e+00),  // (n =   0)
+    REAL( 7.7017070641836210e+04),  // (n =   1)
+    REAL( 3.2043742949011405e+04),  // (n =   2)
+    REAL( 2.9483670716384873e+04),  // (n =   3)
+    REAL( 1.7886988513664743e+04),  // (n =   4)
+    REAL( 1.0663737699901363e+04),  // (n =   5)
+    REAL( 5.2310419376130394e+03),  // (n =   6)
+    REAL( 3.7223269373753537e+03),  // (n =   7)
+    REAL( 2.0941817610296348e+03),  // (n =   8)
+    REAL( 1.7340435098573942e+03),  // (n =   9)
+    REAL( 8.2462440571515299e+02),  // (n =  10)
+    REAL( 5.0453977712589744e+02),  // (n =  11)
+    REAL( 2.8056326190717141e+02),  // (n =  12)
+};
+
+static const magneto_SphericalHarmonicTerm TERMS_WMM2020[NUM_MODELS * TOTAL_COEFFS] = {
+    // Auto-generated table by `tools/gen_coeffs.py`
+    { .g = REAL(-2.9404500000000000e+04), .h = REAL( 0.0000000000000000e+00), .g_dot = REAL( 6.7000000000000002e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =   1, m =   0)
+    { .g = REAL(-3.7500000000000000e+03), .h = REAL( 0.0000000000000000e+00), .g_dot = REAL(-1.7250000000000000e+01), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =   2, m =   0)
+    { .g = REAL( 3.4097500000000000e+03), .h = REAL( 0.0000000000000000e+00), .g_dot = REAL( 7.0000000000000000e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =   3, m =   0)
+    { .g = REAL( 3.9510625000000000e+03), .h = REAL( 0.0000000000000000e+00), .g_dot = REAL(-4.8125000000000000e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =   4, m =   0)
+    { .g = REAL(-1.8459000000000001e+03), .h = REAL( 0.0000000000000000e+00), .g_dot = REAL(-2.3624999999999998e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =   5, m =   0)
+    { .g = REAL( 9.5143125000000009e+02), .h = REAL( 0.0000000000000000e+00), .g_dot = REAL(-8.6624999999999996e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =   6, m =   0)
+    { .g = REAL( 2.1610874999999996e+03), .h = REAL( 0.0000000000000000e+00), .g_dot = REAL(-2.6812500000000004e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =   7, m =   0)
+    { .g = REAL( 1.1864531250000000e+03), .h = REAL( 0.0000000000000000e+00), .g_dot = REAL(-5.0273437500000000e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =   8, m =   0)
+    { .g = REAL( 4.7480468750000000e+02), .h = REAL( 0.0000000000000000e+00), .g_dot = REAL(-9.4960937500000000e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =   9, m =   0)
+    { .g = REAL(-3.4280898437499997e+02), .h = REAL( 0.0000000000000000e+00), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =  10, m =   0)
+    { .g = REAL( 1.0333476562500000e+03), .h = REAL( 0.0000000000000000e+00), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =  11, m =   0)
+    { .g = REAL(-1.3203886718750000e+03), .h = REAL( 0.0000000000000000e+00), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =  12, m =   0)
+    { .g = REAL(-1.4507000000000000e+03), .h = REAL( 4.6528999999999996e+03), .g_dot = REAL( 7.7000000000000002e+00), .h_dot = REAL(-2.5100000000000001e+01) },  // (n =   1, m =   1)
+    { .g = REAL( 5.1649755081703915e+03), .h = REAL(-5.1816031959230531e+03), .g_dot = REAL(-1.2297560733739028e+01), .h_dot = REAL(-5.2307934388580087e+01) },  // (n =   2, m =   1)
+    { .g = REAL(-7.2902938469584333e+03), .h = REAL(-2.5168507107097156e+02), .g_dot = REAL(-1.8983545506569630e+01), .h_dot = REAL( 1.7452614417330143e+01) },  // (n =   3, m =   1)
+    { .g = REAL( 4.4792081917455007e+03), .h = REAL( 1.5605840252930952e+03), .g_dot = REAL(-8.8543774484714621e+00), .h_dot = REAL( 1.1067971810589328e+00) },  // (n =   4, m =   1)
+    { .g = REAL( 3.6914856641457714e+03), .h = REAL( 4.8494592723699617e+02), .g_dot = REAL( 6.0999487702766801e+00), .h_dot = REAL( 1.0166581283794469e+00) },  // (n =   5, m =   1)
+    { .g = REAL( 1.2400449830550501e+03), .h = REAL(-3.6104968256633327e+02), .g_dot = REAL(-7.5612498966771362e+00), .h_dot = REAL( 1.8903124741692841e+00) },  // (n =   6, m =   1)
+    { .g = REAL(-2.7240655498721026e+03), .h = REAL(-1.8231376206175269e+03), .g_dot = REAL(-1.0640881054187901e+01), .h_dot = REAL( 1.7734801756979834e+01) },  // (n =   7, m =   1)
+    { .g = REAL( 6.5690625000000000e+02), .h = REAL( 5.6306250000000000e+02), .g_dot = REAL( 6.7031250000000000e+00), .h_dot = REAL(-2.0109375000000000e+01) },  // (n =   8, m =   1)
+    { .g = REAL( 1.0447084283689758e+03), .h = REAL(-2.9685007781703830e+03), .g_dot = REAL(-2.5480693374853075e+01), .h_dot = REAL(-3.8221040062279606e+01) },  // (n =   9, m =   1)
+    { .g = REAL(-1.5083736576043054e+03), .h = REAL( 8.2717265094429649e+02), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =  10, m =   1)
+    { .g = REAL(-6.5294102570009898e+02), .h = REAL( 0.0000000000000000e+00), .g_dot = REAL(-4.6638644692864219e+01), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =  11, m =   1)
+    { .g = REAL(-8.9702746158524818e+01), .h = REAL(-1.0764329539022976e+03), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =  12, m =   1)
+    { .g = REAL( 1.4521513970657466e+03), .h = REAL(-6.3635546670080544e+02), .g_dot = REAL(-1.9052558883257651e+00), .h_dot = REAL(-2.0698007150448081e+01) },  // (n =   2, m =   2)
+    { .g = REAL( 2.3938910062908044e+03), .h = REAL( 4.6824368655647669e+02), .g_dot = REAL( 6.5840716885526076e+00), .h_dot = REAL(-1.9364916731037083e+00) },  // (n =   3, m =   2)
+    { .g = REAL( 3.3731085440584332e+02), .h = REAL(-6.1983804336294179e+02), .g_dot = REAL(-2.3478713763747791e+01), .h_dot = REAL( 2.7000520828309963e+01) },  // (n =   4, m =   2)
+    { .g = REAL( 1.4432830153854097e+03), .h = REAL( 1.6015984047194854e+03), .g_dot = REAL(-5.3796491521287892e+00), .h_dot = REAL( 1.9213032686174248e+01) },  // (n =   5, m =   2)
+    { .g = REAL( 1.0909289556740737e+03), .h = REAL( 3.7360580673769647e+02), .g_dot = REAL( 7.4721161347539296e+00), .h_dot = REAL(-2.6899618085114145e+01) },  // (n =   6, m =   2)
+    { .g = REAL(-2.4037472296688406e+02), .h = REAL(-4.8654160793297018e+02), .g_dot = REAL(-2.8960809996010131e+00), .h_dot = REAL( 1.7376485997606075e+01) },  // (n =   7, m =   2)
+    { .g = REAL(-9.8144142956321446e+02), .h = REAL(-8.5806022127526751e+02), .g_dot = REAL(-5.6082367403612254e+00), .h_dot = REAL( 3.9257657182528575e+01) },  // (n =   8, m =   2)
+    { .g = REAL( 3.1508512068386722e+02), .h = REAL( 1.2060154619279056e+03), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 2.1730008323025331e+01) },  // (n =   9, m =   2)
+    { .g = REAL(-2.1069192030396437e+01), .h = REAL(-4.2138384060792873e+01), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 2.1069192030396437e+01) },  // (n =  10, m =   2)
+    { .g = REAL(-1.0226199334371945e+03), .h = REAL( 1.0635247307746824e+03), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 4.0904797337487786e+01) },  // (n =  11, m =   2)
+    { .g = REAL( 3.9756493034873313e+02), .h = REAL( 3.9756493034873313e+02), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =  12, m =   2)
+    { .g = REAL( 4.1560234148762925e+02), .h = REAL(-4.2920013542635326e+02), .g_dot = REAL(-9.6449468635135549e+00), .h_dot = REAL( 8.6962635654630427e-01) },  // (n =   3, m =   3)
+    { .g = REAL(-6.4715653052410744e+02), .h = REAL( 4.1791168325377078e+02), .g_dot = REAL( 1.1294910358210021e+01), .h_dot = REAL( 7.7391052454401992e+00) },  // (n =   4, m =   3)
+    { .g = REAL(-6.6216411975006235e+02), .h = REAL(-5.7086359435453141e+02), .g_dot = REAL( 4.7062126492541750e-01), .h_dot = REAL(-4.2355913843287576e+00) },  // (n =   5, m =   3)
+    { .g = REAL(-1.2104828138301366e+03), .h = REAL( 5.2504069373537618e+02), .g_dot = REAL( 1.3947950118207336e+01), .h_dot = REAL(-1.3947950118207336e+01) },  // (n =   6, m =   3)
+    { .g = REAL( 1.1570287602311159e+03), .h = REAL( 4.7100285814717992e+01), .g_dot = REAL( 1.4334869595783736e+01), .h_dot = REAL(-1.4334869595783736e+01) },  // (n =   7, m =   3)
+    { .g = REAL(-1.6567829331267273e+01), .h = REAL( 5.3017053860055273e+02), .g_dot = REAL( 2.0709786664084088e+01), .h_dot = REAL(-8.2839146656336364e+00) },  // (n =   8, m =   3)
+    { .g = REAL(-1.1617597599099797e+02), .h = REAL( 8.1323183193698583e+02), .g_dot = REAL( 3.3193135997427994e+01), .h_dot = REAL(-3.3193135997427994e+01) },  // (n =   9, m =   3)
+    { .g = REAL( 2.8097657878101927e+02), .h = REAL( 5.7848119160798092e+02), .g_dot = REAL( 3.3056068091884626e+01), .h_dot = REAL(-4.9584102137826932e+01) },  // (n =  10, m =   3)
+    { .g = REAL( 7.8712321943469692e+02), .h = REAL(-1.6398400404889520e+02), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =  11, m =   3)
+    { .g = REAL( 8.4398705644892641e+02), .h = REAL( 8.4398705644892641e+02), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL(-6.4922081265302026e+01) },  // (n =  12, m =   3)
+    { .g = REAL( 3.5422527701308951e+01), .h = REAL(-2.5890244150789698e+02), .g_dot = REAL(-4.0673048508809861e+00), .h_dot = REAL(-4.1412558481697310e+00) },  // (n =   4, m =   4)
+    { .g = REAL(-3.3544172370174823e+02), .h = REAL( 7.1436663380927868e+01), .g_dot = REAL( 2.6622359023948272e+00), .h_dot = REAL( 6.6555897559870685e+00) },  // (n =   5, m =   4)
+    { .g = REAL(-1.9753840726236001e+02), .h = REAL(-3.5142191789215428e+02), .g_dot = REAL(-7.6396069106990048e+00), .h_dot = REAL( 4.9111758711636462e+00) },  // (n =   6, m =   4)
+    { .g = REAL( 1.9511310782146342e+02), .h = REAL( 2.9019987555723986e+02), .g_dot = REAL( 2.4697861749552334e+00), .h_dot = REAL(-2.4697861749552334e+00) },  // (n =   7, m =   4)
+    { .g = REAL(-5.6413423393632638e+02), .h = REAL(-3.1548739149045741e+02), .g_dot = REAL(-2.6736219617835375e+00), .h_dot = REAL( 1.3368109808917687e+01) },  // (n =   8, m =   4)
+    { .g = REAL(-6.2013312208857876e+01), .h = REAL(-2.8751626569561375e+02), .g_dot = REAL(-1.6912721511506692e+01), .h_dot = REAL( 2.2550295348675590e+01) },  // (n =   9, m =   4)
+    { .g = REAL(-1.0518376458211144e+02), .h = REAL( 5.6098007777126099e+02), .g_dot = REAL(-1.1687084953567938e+01), .h_dot = REAL( 1.1687084953567938e+01) },  // (n =  10, m =   4)
+    { .g = REAL(-2.1556257141023616e+02), .h = REAL(-9.5805587293438293e+01), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 4.7902793646719147e+01) },  // (n =  11, m =   4)
+    { .g = REAL(-5.8429873138771836e+02), .h = REAL(-8.7644809708157754e+02), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 4.8691560948976530e+01) },  // (n =  12, m =   4)
+    { .g = REAL( 9.6113824122755620e+00), .h = REAL( 6.9524671317993295e+01), .g_dot = REAL( 7.0156076002011403e-01), .h_dot = REAL( 3.5078038001005701e-01) },  // (n =   5, m =   5)
+    { .g = REAL( 3.1411986416414358e+01), .h = REAL( 2.0941324277609571e+01), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 2.3268138086232859e-01) },  // (n =   6, m =   5)
+    { .g = REAL( 3.9516578799283728e+01), .h = REAL(-1.3583823962253781e+01), .g_dot = REAL(-3.0872327186940409e+00), .h_dot = REAL(-7.4093585248656977e+00) },  // (n =   7, m =   5)
+    { .g = REAL( 2.2690796990551178e+02), .h = REAL( 2.2097573539817813e+02), .g_dot = REAL( 5.9322345073336411e+00), .h_dot = REAL(-4.4491758805002304e+00) },  // (n =   8, m =   5)
+    { .g = REAL(-4.4808960423838636e+02), .h = REAL(-2.0888387565999966e+02), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 3.3690947687096719e+00) },  // (n =   9, m =   5)
+    { .g = REAL( 4.4349369193389464e+01), .h = REAL(-6.3567429177191559e+02), .g_dot = REAL(-1.4783123064463155e+01), .h_dot = REAL(-1.4783123064463155e+01) },  // (n =  10, m =   5)
+    { .g = REAL( 4.7527079660423887e+01), .h = REAL( 9.5054159320847774e+01), .g_dot = REAL(-1.5842359886807964e+01), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =  11, m =   5)
+    { .g = REAL( 2.3381494671163188e+02), .h = REAL( 3.3402135244518846e+01), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =  12, m =   5)
+    { .g = REAL(-4.3458555822976336e+01), .h = REAL( 4.5742313006873076e+01), .g_dot = REAL( 5.3735463150511698e-01), .h_dot = REAL( 6.7169328938139616e-01) },  // (n =   6, m =   6)
+    { .g = REAL(-1.7437137092997805e+01), .h = REAL(-6.5873629017991703e+01), .g_dot = REAL(-1.9374596769997561e+00), .h_dot = REAL( 4.8436491924993902e-01) },  // (n =   7, m =   6)
+    { .g = REAL( 9.4053615781646386e+01), .h = REAL( 2.4714818745542118e+01), .g_dot = REAL( 3.4326137146586273e+00), .h_dot = REAL(-3.4326137146586273e+00) },  // (n =   8, m =   6)
+    { .g = REAL( 1.9137723632143725e+01), .h = REAL( 1.3570385848247369e+02), .g_dot = REAL( 5.2193791724028342e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =   9, m =   6)
+    { .g = REAL(-3.7188076603370199e+01), .h = REAL(-4.1320085114855774e+00), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 4.1320085114855774e+00) },  // (n =  10, m =   6)
+    { .g = REAL(-6.5882349610875551e+01), .h = REAL(-1.8823528460250156e+01), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =  11, m =   6)
+    { .g = REAL( 6.2489673035838059e+01), .h = REAL( 1.4580923708362212e+02), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =  12, m =   6)
+    { .g = REAL( 6.3431465230199446e+00), .h = REAL(-1.2297937136467239e+00), .g_dot = REAL( 6.4725984928774938e-01), .h_dot = REAL( 1.9417795478632480e-01) },  // (n =   7, m =   7)
+    { .g = REAL(-4.1362639179842901e+01), .h = REAL(-1.7297103657025211e+01), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 1.0027306467840702e+00) },  // (n =   8, m =   7)
+    { .g = REAL( 6.7048371836716441e+01), .h = REAL( 3.0134099701895032e+00), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL(-1.5067049850947516e+00) },  // (n =   9, m =   7)
+    { .g = REAL( 3.8082052145566891e+01), .h = REAL(-8.4181378427042603e+01), .g_dot = REAL(-2.0043185339772047e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =  10, m =   7)
+    { .g = REAL(-4.9604352946160644e+00), .h = REAL(-8.4327400008473077e+01), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 4.9604352946160644e+00) },  // (n =  11, m =   7)
+    { .g = REAL( 5.8526941135745083e+01), .h = REAL(-1.1705388227149017e+01), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =  12, m =   7)
+    { .g = REAL(-1.8801199627201318e-01), .h = REAL( 1.7547786318721228e+00), .g_dot = REAL( 2.5068266169601755e-01), .h_dot = REAL( 6.2670665424004388e-02) },  // (n =   8, m =   8)
+    { .g = REAL(-2.4030992904895072e+01), .h = REAL(-3.8759665975637212e+00), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 1.2919888658545737e+00) },  // (n =   9, m =   8)
+    { .g = REAL( 1.1455634610577219e+01), .h = REAL(-2.7820826911401817e+01), .g_dot = REAL(-1.6365192300824600e+00), .h_dot = REAL(-8.1825961504123002e-01) },  // (n =  10, m =   8)
+    { .g = REAL( 3.1864053296089850e+01), .h = REAL(-3.6416060909816977e+01), .g_dot = REAL(-2.2760038068635611e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =  11, m =   8)
+    { .g = REAL(-1.1705388227149017e+01), .h = REAL( 3.5116164681447046e+01), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 5.8526941135745085e+00) },  // (n =  12, m =   8)
+    { .g = REAL(-7.2476877668887321e+00), .h = REAL( 5.9077791041025796e+00), .g_dot = REAL(-2.4361975687020948e-01), .h_dot = REAL( 1.2180987843510474e-01) },  // (n =   9, m =   9)
+    { .g = REAL(-6.3714834050831515e+00), .h = REAL(-2.6547847521179796e-01), .g_dot = REAL(-2.6547847521179796e-01), .h_dot = REAL( 5.3095695042359592e-01) },  // (n =  10, m =   9)
+    { .g = REAL(-5.2889549039323525e+00), .h = REAL(-2.6444774519661763e+01), .g_dot = REAL(-8.8149248398872548e-01), .h_dot = REAL(-8.8149248398872548e-01) },  // (n =  11, m =   9)
+    { .g = REAL(-1.2771625616608405e+01), .h = REAL( 5.1086502466433625e+00), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =  12, m =   9)
+    { .g = REAL(-2.3151488768326356e+00), .h = REAL(-5.2239256708018447e+00), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =  10, m =  10)
+    { .g = REAL( 5.4406897298346402e-01), .h = REAL(-5.4406897298346397e+00), .g_dot = REAL(-2.7203448649173201e-01), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =  11, m =  10)
+    { .g = REAL( 9.4324706362690136e-01), .h = REAL(-8.4892235726421124e+00), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =  12, m =  10)
+    { .g = REAL( 1.7979363691975048e+00), .h = REAL(-1.5079466322301653e+00), .g_dot = REAL(-5.7997947393467898e-02), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =  11, m =  11)
+    { .g = REAL(-3.0596322283672874e+00), .h = REAL( 0.0000000000000000e+00), .g_dot = REAL( 0.0000000000000000e+00), .h_dot = REAL( 0.0000000000000000e+00) },  // (n =  12, m =  11)
+    { .g = REAL(-1.7033040363805696e-01), .h = REAL( 2.8388400606342828e-01), .g_dot = REAL(-5.6776801212685662e-02), .h_dot = REAL(-5.6776801212685662e-02) },  // (n =  12, m =  12)
 };
 
 STATIC_ASSERT(ARRAY_SIZE(COEFFS_WMM2020) == TOTAL_COEFFS, check_coeffs_array_size);
 STATIC_ASSERT(ARRAY_SIZE(SECULAR_WMM2020) == TOTAL_COEFFS, check_secular_coeffs_array_size);
 STATIC_ASSERT(ARRAY_SIZE(SUBMODELS_WMM2020) == NUM_MODELS, check_submodels_array_size);
+STATIC_ASSERT(ARRAY_SIZE(RECURSION_WMM2020) == TOTAL_COEFFS, check_recursion_array_size);
+STATIC_ASSERT(ARRAY_SIZE(DEGREE_BOUNDS_WMM2020) == (N_MAX + 1U), check_degree_bounds_array_size);
+STATIC_ASSERT(ARRAY_SIZE(TERMS_WMM2020) == (NUM_MODELS * TOTAL_COEFFS), check_terms_array_size);
 
 const magneto_Model magneto_MODEL_WMM2020 = {
     .epoch = {
@@ -226,5 +435,8 @@ const magneto_Model magneto_MODEL_WMM2020 = {
     .models = SUBMODELS_WMM2020,
     .last_secular = {
         .coeffs = SECULAR_WMM2020
-    }
+    },
+    .recursion = RECURSION_WMM2020,
+    .degree_bounds = DEGREE_BOUNDS_WMM2020,
+    .terms = TERMS_WMM2020
 };
@@ -1,13 +1,33 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include <doctest/doctest.h>
 
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
 extern "C" {
+#  include <magneto/cache.h>
 #  include <magneto/magneto.h>
 #  include <magneto/model.h>
+#  include <magneto/model_binary.h>
+#  include <magneto/parallel.h>
+#  include <magneto/registry.h>
+#  include <magneto/trace.h>
 #  include <magneto/wmm.h>
 
 // Total hack for unit-testing static stuff
 #  include <magneto/../../src/magneto.c>
+#  include <magneto/../../src/model_private.h>
+
+#  ifdef MAGNETO_DUAL_PRECISION
+#    include "test_single_precision.h"
+#  endif
 }
 
 using doctest::Approx;
@@ -17,6 +37,13 @@ using real = magneto_real;
 static_assert(sizeof(real) == sizeof(double), "Tests expecting double-precision");
 static_assert(sizeof(real) != sizeof(float), "Tests not expecting single-precision just yet");
 
+// Batch kernels of a mixed-precision build only keep single-precision in their basis
+#ifdef MAGNETO_MIXED_PRECISION
+static const real BATCH_EPSILON = 1e-5;
+#else
+static const real BATCH_EPSILON = 1e-12;
+#endif
+
 TEST_CASE(
     "test_constants"
     * doctest::description("Sanity check on library constants")
@@ -195,9 +222,207 @@ TEST_CASE("test_dec_year_from_date_time") {
     // FIXME: more tests
 }
 
+/// Calendar fields of the whole second at or before `seconds` since the Unix epoch, using
+/// `civil_from_days` from Howard Hinnant's date algorithms, as `gmtime` rejects some past years
+static magneto_DateTime date_time_from_unix(const double seconds) {
+    const int64_t whole = (int64_t) std::floor(seconds);
+    const int64_t days = (int64_t) std::floor(seconds / 86400.0);
+    const int64_t sec_of_day = whole - (days * 86400);
+    const int64_t z = days + 719468;
+    const int64_t era = ((z >= 0) ? z : (z - 146096)) / 146097;
+    const int64_t doe = z - (era * 146097);
+    const int64_t yoe = (doe - (doe / 1460) + (doe / 36524) - (doe / 146096)) / 365;
+    const int64_t doy = doe - ((365 * yoe) + (yoe / 4) - (yoe / 100));
+    const int64_t mp = ((5 * doy) + 2) / 153;
+    const int64_t day = doy - (((153 * mp) + 2) / 5) + 1;
+    const int64_t month = (mp < 10) ? (mp + 3) : (mp - 9);
+    const int64_t year = yoe + (era * 400) + ((month <= 2) ? 1 : 0);
+    const magneto_DateTime t_dt = {
+        (uint16_t) year, (uint8_t) month, (uint8_t) day,
+        (uint8_t) (sec_of_day / 3600), (uint8_t) ((sec_of_day / 60) % 60), (uint8_t) (sec_of_day % 60)
+    };
+    return t_dt;
+}
+
+TEST_CASE("test_dec_year_from_unix") {
+    // Epoch & year boundaries are exact
+    CHECK(magneto_DecYear_from_unix(0.0).year == 1970.0);
+    CHECK(magneto_DecYear_from_unix(1609459200.0).year == 2021.0);
+    CHECK(magneto_DecYear_from_unix(1609459199.0).year < 2021.0);
+    CHECK(magneto_DecYear_from_unix(1609459199.0).year > 2020.99999);
+    // March 1st of a leap year, & GPS epoch 1980-01-06
+    CHECK(magneto_DecYear_from_unix(1709251200.0).year == Approx(2024.0 + (60.0 / 366.0)).epsilon(1e-15));
+    CHECK(magneto_DecYear_from_gps(0U, 0.0).year == Approx(1980.0 + (5.0 / 366.0)).epsilon(1e-15));
+    CHECK(magneto_DecYear_from_gps(2200U, 3600.0).year == magneto_DecYear_from_unix(315964800.0 + (2200.0 * 604800.0) + 3600.0).year);
+
+    // Same as splitting into calendar fields, across the valid range
+    std::vector<double> stream;
+    for (double seconds = -12212553600.0; seconds < 253402300800.0; seconds += 7777777.7) {
+        const magneto_DateTime t_dt = date_time_from_unix(seconds);
+        const real expected = magneto_DecYear_from_date_time(t_dt).year;
+        const real frac_sec = (real) (seconds - std::floor(seconds)) / (365.0 * 86400.0);
+        CHECK(magneto_DecYear_from_unix(seconds).year == Approx(expected + frac_sec).epsilon(1e-13));
+        stream.push_back(seconds);
+    }
+
+    // Cached & batch conversions are identical, including on year changes
+    stream.push_back(1e30);
+    stream.push_back(1609459200.0);
+    magneto_YearCache cache = {};
+    std::vector<magneto_DecYear> batch(stream.size());
+    magneto_DecYear_from_unix_batch(stream.size(), stream.data(), batch.data());
+    for (size_t i = 0U; i < stream.size(); ++i) {
+        const real expected = magneto_DecYear_from_unix(stream[i]).year;
+        CHECK(magneto_DecYear_from_unix_cached(&cache, stream[i]).year == expected);
+        CHECK(batch[i].year == expected);
+    }
+    const double one_year[] = { 1609459200.0, 1609459201.5, 1625097600.0, 1640995199.0 };
+    magneto_DecYear one_year_out[ARRAY_SIZE(one_year)];
+    magneto_DecYear_from_unix_batch(ARRAY_SIZE(one_year), one_year, one_year_out);
+    for (size_t i = 0U; i < ARRAY_SIZE(one_year); ++i) {
+        CHECK(one_year_out[i].year == magneto_DecYear_from_unix(one_year[i]).year);
+    }
+
+    // Invalid
+    CHECK(magneto_DecYear_from_unix(-12212553601.0).year == 0.0);
+    CHECK(magneto_DecYear_from_unix(253402300800.0).year == 0.0);
+    CHECK(magneto_DecYear_from_unix(std::numeric_limits<double>::quiet_NaN()).year == 0.0);
+    CHECK(magneto_DecYear_from_unix(std::numeric_limits<double>::infinity()).year == 0.0);
+    CHECK(magneto_DecYear_from_unix_cached(nullptr, 0.0).year == 1970.0);
+}
+
 // FIXME: test `magneto_Coords_from_spherical`
-// FIXME: test `magneto_Coords_from_ecef`
-// FIXME: test `magneto_SphericalCoords_from_coords`
+TEST_CASE("test_coords_from_ecef") {
+    const real lats[] = { -90.0, -89.9999, -45.0, 0.0, 1e-6, 30.0, 60.0, 89.9999, 90.0 };
+    const real heights[] = { -6370e3, -6300e3, -6000e3, -1e6, -1000.0, 0.0, 100e3, 35786e3, 4e8 };
+    const auto distance = [](const magneto_EcefPosition a, const magneto_EcefPosition b) {
+        return std::sqrt(((a.x - b.x) * (a.x - b.x)) + ((a.y - b.y) * (a.y - b.y)) + ((a.z - b.z) * (a.z - b.z)));
+    };
+    for (const real lat : lats) {
+        for (const real height : heights) {
+            const magneto_Coords pos = { .latitude = lat, .longitude = -75.5, .height = height };
+            const magneto_EcefPosition ecef = magneto_EcefPosition_from_coords(pos);
+            const magneto_Coords fast = magneto_Coords_from_ecef_fast(ecef);
+
+            // Round trip is exact up to rounding of the distance from the centre, even near it
+            const real tolerance = 1e-15 * std::fmax(magneto_WGS84_A, std::fabs(magneto_WGS84_A + height));
+            CHECK(distance(magneto_EcefPosition_from_coords(fast), ecef) < tolerance);
+            // Unless the point is so close to the centre that another normal is nearer the surface
+            if (height > -6000e3) {
+                CHECK(std::fabs(fast.height - height) < tolerance);
+                CHECK(std::fabs(fast.latitude - lat) < 1e-12);
+            }
+
+            // Agrees with the iterative conversion, except near the poles & equator where it loses precision
+            if ((height >= -1000.0) && (height <= 35786e3) && (std::fabs(lat) > 1.0) && (std::fabs(lat) < 89.0)) {
+                const magneto_Coords iterative = magneto_Coords_from_ecef(ecef);
+                CHECK(std::fabs(fast.height - iterative.height) < 1e-6);
+                CHECK(std::fabs(fast.latitude - iterative.latitude) < 1e-6);
+            }
+        }
+    }
+
+    // The centre is a semi-minor axis below either pole
+    const magneto_Coords centre = magneto_Coords_from_ecef_fast(magneto_EcefPosition { 0, 0, 0 });
+    CHECK(centre.latitude == 90);
+    CHECK(centre.height == Approx(-magneto_WGS84_B).epsilon(1e-12));
+
+    // Structure-of-arrays batch is the same as each point on its own
+    const size_t N = 4U;
+    const real x[N] = { 6378137.0, 0.0, 1000.0, -4e7 };
+    const real y[N] = { 0.0, 1e-3, 2000.0, 2e7 };
+    const real z[N] = { 0.0, 6356752.0, -500.0, 3e6 };
+    real lat_out[N], lon_out[N], height_out[N];
+    magneto_Coords_from_ecef_fast_batch(N, x, y, z, lat_out, lon_out, height_out);
+    for (size_t i = 0U; i < N; ++i) {
+        const magneto_Coords expected = magneto_Coords_from_ecef_fast(magneto_EcefPosition { x[i], y[i], z[i] });
+        CHECK(lat_out[i] == expected.latitude);
+        CHECK(lon_out[i] == expected.longitude);
+        CHECK(height_out[i] == expected.height);
+    }
+    CHECK_NOTHROW(magneto_Coords_from_ecef_fast_batch(N, x, y, NULL, lat_out, lon_out, height_out));
+}
+
+TEST_CASE("test_geocentric_frame_from_coords") {
+    const real lats[] = { -90.0, -67.5, -12.3, 0.0, 0.001, 45.0, 89.999, 90.0 };
+    const real heights[] = { -1000.0, 0.0, 100e3, 35786e3 };
+    for (const real lat : lats) {
+        for (const real height : heights) {
+            const magneto_Coords pos = { .latitude = lat, .longitude = -75.5, .height = height };
+            const magneto_GeocentricFrame frame = magneto_GeocentricFrame_from_coords(pos);
+
+            // Same as going through ECEF
+            const magneto_SphericalCoords sph = magneto_SphericalCoords_from_ecef(magneto_EcefPosition_from_coords(pos));
+            CHECK(frame.spherical.radius == Approx(sph.radius).epsilon(1e-14));
+            // The `asin` through ECEF loses precision near the poles, unlike `atan2`
+            CHECK(frame.spherical.polar == Approx(sph.polar).epsilon(1e-9).scale(1));
+            CHECK(frame.spherical.azimuth == pos.longitude);
+            CHECK(magneto_SphericalCoords_from_coords(pos).polar == frame.spherical.polar);
+
+            const real polar = magneto_deg_to_rad(frame.spherical.polar);
+            const real eps = magneto_deg_to_rad(lat - frame.spherical.polar);
+            CHECK(frame.sin_polar == Approx(std::sin(polar)).epsilon(1e-14).scale(1));
+            CHECK(frame.cos_polar == Approx(std::cos(polar)).epsilon(1e-14).scale(1));
+            CHECK(frame.sin_eps == Approx(std::sin(eps)).epsilon(1e-14).scale(1));
+            CHECK(frame.cos_eps == Approx(std::cos(eps)).epsilon(1e-14).scale(1));
+        }
+    }
+}
+
+TEST_CASE("test_batch_conversions") {
+    const size_t N = 4U;
+    const magneto_Coords coords[N] = { { 0, 0, 0 }, { 45.5, -75.3, 100 }, { -89.0, 179.0, 1e5 }, { 12.0, 34.0, 56.0 } };
+    magneto_SphericalCoords sph[N];
+    magneto_EcefPosition ecef[N];
+    magneto_GeocentricFrame frames[N];
+    magneto_Coords coords_from_ecef[N];
+    magneto_Coords coords_from_sph[N];
+    magneto_SphericalCoords sph_from_ecef[N];
+    magneto_EcefPosition ecef_from_sph[N];
+    magneto_SphericalCoords_from_coords_batch(N, coords, sph);
+    magneto_EcefPosition_from_coords_batch(N, coords, ecef);
+    magneto_GeocentricFrame_from_coords_batch(N, coords, frames);
+    magneto_Coords_from_ecef_batch(N, ecef, coords_from_ecef);
+    magneto_Coords_from_spherical_batch(N, sph, coords_from_sph);
+    magneto_SphericalCoords_from_ecef_batch(N, ecef, sph_from_ecef);
+    magneto_EcefPosition_from_spherical_batch(N, sph, ecef_from_sph);
+
+    real B_ned[3U * N];
+    real B_ecef[3U * N];
+    real B_ned_back[3U * N];
+    magneto_FieldState fields[N];
+    for (size_t i = 0U; i < (3U * N); ++i) {
+        B_ned[i] = (real) ((i * 7919U) % 1000U) - 500;
+    }
+    magneto_convert_vector_ned_to_ecef_batch(N, coords, B_ned, B_ecef);
+    magneto_convert_vector_ecef_to_ned_batch(N, coords, B_ecef, B_ned_back);
+    magneto_FieldState_from_ned_batch(N, B_ned, fields);
+
+    for (size_t i = 0U; i < N; ++i) {
+        const magneto_SphericalCoords sph_i = magneto_SphericalCoords_from_coords(coords[i]);
+        const magneto_EcefPosition ecef_i = magneto_EcefPosition_from_coords(coords[i]);
+        const magneto_GeocentricFrame frame_i = magneto_GeocentricFrame_from_coords(coords[i]);
+        const magneto_Coords from_ecef_i = magneto_Coords_from_ecef(ecef_i);
+        const magneto_Coords from_sph_i = magneto_Coords_from_spherical(sph_i);
+        const magneto_SphericalCoords sph_from_ecef_i = magneto_SphericalCoords_from_ecef(ecef_i);
+        const magneto_EcefPosition ecef_from_sph_i = magneto_EcefPosition_from_spherical(sph_i);
+        const magneto_FieldState field_i = magneto_FieldState_from_ned(&B_ned[3U * i]);
+        CHECK(std::memcmp(&sph[i], &sph_i, sizeof(sph_i)) == 0);
+        CHECK(std::memcmp(&ecef[i], &ecef_i, sizeof(ecef_i)) == 0);
+        CHECK(std::memcmp(&frames[i], &frame_i, sizeof(frame_i)) == 0);
+        CHECK(std::memcmp(&coords_from_ecef[i], &from_ecef_i, sizeof(from_ecef_i)) == 0);
+        CHECK(std::memcmp(&coords_from_sph[i], &from_sph_i, sizeof(from_sph_i)) == 0);
+        CHECK(std::memcmp(&sph_from_ecef[i], &sph_from_ecef_i, sizeof(sph_from_ecef_i)) == 0);
+        CHECK(std::memcmp(&ecef_from_sph[i], &ecef_from_sph_i, sizeof(ecef_from_sph_i)) == 0);
+        CHECK(std::memcmp(&fields[i], &field_i, sizeof(field_i)) == 0);
+        for (size_t k = 0U; k < 3U; ++k) {
+            CHECK(B_ned_back[(3U * i) + k] == Approx(B_ned[(3U * i) + k]).epsilon(1e-12).scale(1));
+        }
+    }
+    CHECK_NOTHROW(magneto_Coords_from_ecef_batch(N, NULL, coords_from_ecef));
+    CHECK_NOTHROW(magneto_convert_vector_ned_to_ecef_batch(N, coords, NULL, B_ecef));
+}
+
 // FIXME: test `magneto_SphericalCoords_from_ecef`
 // FIXME: test `magneto_EcefPosition_from_coords`
 // FIXME: test `magneto_EcefPosition_from_spherical`
@@ -217,6 +442,44 @@ TEST_CASE("test_wmm2020_model_definition") {
     CHECK(magneto_MODEL_WMM2020.models[0].coeffs);
 }
 
+TEST_CASE("test_wmm2020_terms_table") {
+    const magneto_Model &model = magneto_MODEL_WMM2020;
+    REQUIRE(model.terms);
+    std::vector<bool> is_used(model.num_model_coeffs, false);
+    size_t num_used = 0U;
+    for (size_t m = 0U; m <= model.nm_max; ++m) {
+        for (size_t n = MAX_OF(m, 1U); n <= model.nm_max; ++n) {
+            // Consecutive within an order
+            const size_t i = MAGNETO_CALC_ORDER_INDEX(n, m, model.nm_max);
+            CHECK(i == (MAGNETO_CALC_ORDER_INDEX(MAX_OF(m, 1U), m, model.nm_max) + n - MAX_OF(m, 1U)));
+            REQUIRE(i < model.num_model_coeffs);
+            CHECK(!is_used[i]);
+            is_used[i] = true;
+            ++num_used;
+
+            const size_t idx_coeff = MAGNETO_CALC_INDEX(n, m);
+            CHECK(model.terms[i].g == model.models[0].coeffs[idx_coeff].g);
+            CHECK(model.terms[i].h == model.models[0].coeffs[idx_coeff].h);
+            CHECK(model.terms[i].g_dot == model.last_secular.coeffs[idx_coeff].g);
+            CHECK(model.terms[i].h_dot == model.last_secular.coeffs[idx_coeff].h);
+        }
+    }
+    CHECK(num_used == model.num_model_coeffs);
+}
+
+TEST_CASE("test_wmm2020_recursion_table") {
+    const magneto_Model &model = magneto_MODEL_WMM2020;
+    REQUIRE(model.recursion);
+    for (size_t n = 1U; n <= model.nm_max; ++n) {
+        for (size_t m = 0U; m <= n; ++m) {
+            const magneto_RecursionConsts &consts = model.recursion[MAGNETO_CALC_INDEX(n, m)];
+            CHECK(consts.K == Approx(calc_K((real) n, (real) m)).epsilon(1e-15));
+            CHECK(consts.n_plus_1 == (real) (n + 1U));
+            CHECK(consts.m == (real) m);
+        }
+    }
+}
+
 TEST_CASE("test_wmm2020_sanity") {
     const magneto_DecYear t = { .year = 2020 };
     const magneto_Coords pos = { .latitude = 80, .longitude = 0, .height = 0 };
@@ -230,3 +493,1442 @@ TEST_CASE("test_wmm2020_sanity") {
 
     MESSAGE("B_ned = { ", B.B_ned[0], ", ", B.B_ned[1], ", ", B.B_ned[2], " }");
 }
+
+TEST_CASE(
+    "test_wmm2020_test_values"
+    * doctest::description("Compare against test values published in the WMM2020 report")
+) {
+    struct TestValue {
+        real year, lat, lon, height, X, Y, Z;
+    };
+    const TestValue values[] = {
+        { 2020.0,  80,   0,      0,  6570.4,  -146.3,  54606.0 },
+        { 2020.0,   0, 120,      0, 39624.3,   109.9, -10932.5 },
+        { 2020.0, -80, 240,      0,  5940.6, 15772.1, -52480.8 },
+        { 2020.0,  80,   0, 100000,  6261.8,  -185.5,  52429.1 },
+        { 2022.5,  80,   0,      0,  6529.9,     1.1,  54713.4 },
+        { 2022.5, -80, 240, 100000,  5815.0, 14803.0, -49755.3 },
+    };
+    for (const TestValue &v : values) {
+        const magneto_DecYear t = { .year = v.year };
+        const magneto_Coords pos = { .latitude = v.lat, .longitude = v.lon, .height = v.height };
+        const magneto_FieldState B = eval_field(&magneto_MODEL_WMM2020, t, pos);
+        CHECK(std::fabs(B.B_ned[0] - v.X) < 0.1);
+        CHECK(std::fabs(B.B_ned[1] - v.Y) < 0.1);
+        CHECK(std::fabs(B.B_ned[2] - v.Z) < 0.1);
+    }
+}
+
+TEST_CASE("test_eval_field_batch") {
+    const size_t N = 5U;
+    const real lat[N] = { 80, 0, -80, 45.5, -12.25 };
+    const real lon[N] = { 0, 120, 240, -75.3, 33.3 };
+    const real height[N] = { 0, 0, 1000, 100000, 35786000 };
+    const magneto_DecYear time[N] = { { 2020.0 }, { 2020.0 }, { 2021.5 }, { 2024.9 }, { 2024.9 } };
+    const magneto_CoordsBatch in = { lat, lon, height, time };
+
+    real B_n[N], B_e[N], B_d[N], F[N], H[N], D[N], I[N];
+    const magneto_FieldStateBatch out = { { B_n, B_e, B_d }, F, H, D, I };
+    eval_field_batch(&magneto_MODEL_WMM2020, N, &in, &out);
+
+    for (size_t i = 0U; i < N; ++i) {
+        const magneto_Coords pos = { .latitude = lat[i], .longitude = lon[i], .height = height[i] };
+        const magneto_FieldState B = eval_field(&magneto_MODEL_WMM2020, time[i], pos);
+        CHECK(B_n[i] == Approx(B.B_ned[0]).epsilon(BATCH_EPSILON));
+        CHECK(B_e[i] == Approx(B.B_ned[1]).epsilon(BATCH_EPSILON));
+        CHECK(B_d[i] == Approx(B.B_ned[2]).epsilon(BATCH_EPSILON));
+        CHECK(F[i] == Approx(B.F).epsilon(BATCH_EPSILON));
+        CHECK(H[i] == Approx(B.H).epsilon(BATCH_EPSILON));
+        CHECK(D[i] == Approx(B.D).epsilon(BATCH_EPSILON));
+        CHECK(I[i] == Approx(B.I).epsilon(BATCH_EPSILON));
+    }
+
+    // Only requested outputs are written
+    real D_only[N] = { 0 };
+    real F_only[N] = { 0 };
+    const magneto_FieldStateBatch out_partial = { { NULL, NULL, NULL }, F_only, NULL, D_only, NULL };
+    eval_field_batch(&magneto_MODEL_WMM2020, N, &in, &out_partial);
+    for (size_t i = 0U; i < N; ++i) {
+        CHECK(D_only[i] == D[i]);
+        CHECK(F_only[i] == F[i]);
+    }
+
+    CHECK_NOTHROW(eval_field_batch(&magneto_MODEL_WMM2020, N, &in, NULL));
+    CHECK_NOTHROW(eval_field_batch(&magneto_MODEL_WMM2020, 0U, &in, &out));
+}
+
+TEST_CASE("test_eval_field_with_rates") {
+    const magneto_Model *const model = &magneto_MODEL_WMM2020;
+    const real lats[] = { -90.0, -80.0, 0.0, 45.5, 89.0 };
+    const real dt = 1e-3;
+    for (const real lat : lats) {
+        const magneto_Coords pos = { .latitude = lat, .longitude = 240, .height = 100000 };
+        const magneto_DecYear t = { .year = 2022.5 };
+        magneto_FieldRates rates;
+        const magneto_FieldState B = eval_field_with_rates(model, t, pos, &rates);
+
+        // Field is unchanged by also summing the rates
+        const magneto_FieldState B_expected = eval_field(model, t, pos);
+        CHECK(std::memcmp(&B, &B_expected, sizeof(B)) == 0);
+
+        // Compare against central differences, exact up to rounding for the linear components
+        const magneto_DecYear t_before = { .year = t.year - dt };
+        const magneto_DecYear t_after = { .year = t.year + dt };
+        const magneto_FieldState B_before = eval_field(model, t_before, pos);
+        const magneto_FieldState B_after = eval_field(model, t_after, pos);
+        for (size_t i = 0U; i < 3U; ++i) {
+            CHECK(std::fabs(rates.B_ned[i] - ((B_after.B_ned[i] - B_before.B_ned[i]) / (2 * dt))) < 1e-6);
+        }
+        CHECK(std::fabs(rates.F - ((B_after.F - B_before.F) / (2 * dt))) < 1e-6);
+        CHECK(std::fabs(rates.H - ((B_after.H - B_before.H) / (2 * dt))) < 1e-6);
+        CHECK(std::fabs(rates.D - ((B_after.D - B_before.D) / (2 * dt))) < 1e-6);
+        CHECK(std::fabs(rates.I - ((B_after.I - B_before.I) / (2 * dt))) < 1e-6);
+    }
+
+    // Secular variation test value published in the WMM2020 report
+    const magneto_Coords pos = { .latitude = 80, .longitude = 0, .height = 0 };
+    magneto_FieldRates rates;
+    eval_field_with_rates(model, magneto_DecYear { 2020.0 }, pos, &rates);
+    CHECK(std::fabs(rates.B_ned[0] - -16.2) < 0.1);
+    CHECK(std::fabs(rates.B_ned[1] - 59.0) < 0.1);
+    CHECK(std::fabs(rates.B_ned[2] - 42.9) < 0.1);
+
+    CHECK_NOTHROW(eval_field_with_rates(model, magneto_DecYear { 2020.0 }, pos, NULL));
+
+    // Undefined angle rates are zero
+    const real B_zero[3] = { 0, 0, 0 };
+    const real B_dot[3] = { 1, 2, 3 };
+    const magneto_FieldRates zero_rates = magneto_FieldRates_from_ned(B_zero, B_dot);
+    CHECK(zero_rates.B_ned[2] == 3);
+    CHECK(zero_rates.F == 0);
+    CHECK(zero_rates.D == 0);
+    CHECK(zero_rates.I == 0);
+}
+
+TEST_CASE("test_eval_field_with_gradient") {
+    const magneto_Model *const model = &magneto_MODEL_WMM2020;
+    const magneto_DecYear t = { .year = 2022.5 };
+    const magneto_Coords points[] = {
+        { .latitude = 80, .longitude = 0, .height = 0 },
+        { .latitude = 0, .longitude = 120, .height = 0 },
+        { .latitude = -80, .longitude = 240, .height = 100000 },
+        { .latitude = 45.5, .longitude = -75.3, .height = 10000 },
+        { .latitude = -33.9, .longitude = 151.2, .height = 35786000 },
+        { .latitude = 89.9, .longitude = 10, .height = 500 },
+    };
+    // Steps in latitude & longitude [deg] and height [m] for central differences
+    const real steps[3] = { 1e-4, 1e-4, 1.0 };
+    for (const magneto_Coords &pos : points) {
+        magneto_FieldGradient gradient;
+        const magneto_FieldState B = eval_field_with_gradient(model, t, pos, &gradient);
+
+        const magneto_FieldState B_expected = eval_field(model, t, pos);
+        for (size_t i = 0U; i < 3U; ++i) {
+            CHECK(B.B_ned[i] == Approx(B_expected.B_ned[i]).epsilon(1e-12));
+        }
+        CHECK(B.F == Approx(B_expected.F).epsilon(1e-12));
+
+        for (size_t j = 0U; j < 3U; ++j) {
+            magneto_Coords pos_before = pos;
+            magneto_Coords pos_after = pos;
+            real *const x_before[3] = { &pos_before.latitude, &pos_before.longitude, &pos_before.height };
+            real *const x_after[3] = { &pos_after.latitude, &pos_after.longitude, &pos_after.height };
+            *x_before[j] -= steps[j];
+            *x_after[j] += steps[j];
+            const magneto_FieldState B_before = eval_field(model, t, pos_before);
+            const magneto_FieldState B_after = eval_field(model, t, pos_after);
+            for (size_t i = 0U; i < 3U; ++i) {
+                const real expected = (B_after.B_ned[i] - B_before.B_ned[i]) / (2 * steps[j]);
+                CHECK(gradient.dB_ned[i][j] == Approx(expected).epsilon(1e-6).scale(1));
+            }
+        }
+    }
+
+    const magneto_Coords pos = points[0];
+    CHECK_NOTHROW(eval_field_with_gradient(model, t, pos, NULL));
+    CHECK(eval_field_with_gradient(NULL, t, pos, NULL).F == 0);
+}
+
+TEST_CASE("test_eval_field_truncated") {
+    const magneto_Model &wmm = magneto_MODEL_WMM2020;
+    const magneto_DecYear t = { .year = 2023.7 };
+    magneto_TruncationInfo info;
+
+    // Nothing left out by default
+    const magneto_Coords ground = { .latitude = 51.5, .longitude = -0.1, .height = 0 };
+    const magneto_FieldState B_ground = eval_field(&wmm, t, ground);
+    CHECK(eval_field_truncated(&wmm, t, ground, NULL, &info).B_ned[0] == B_ground.B_ned[0]);
+    CHECK(info.degree == wmm.nm_max);
+    CHECK(info.error_bound == 0);
+
+    // Higher & further out needs fewer degrees, but stays within the bound
+    const magneto_Coords points[] = {
+        { .latitude = 51.5, .longitude = -0.1, .height = 0 },
+        { .latitude = -20.0, .longitude = 80.0, .height = 550e3 },
+        { .latitude = 5.0, .longitude = -150.0, .height = 20200e3 },
+        { .latitude = 0.0, .longitude = 30.0, .height = 35786e3 },
+    };
+    const magneto_TruncationOptions options = { .tolerance = 1.0, .max_degree = 0U };
+    size_t prev_degree = wmm.nm_max + 1U;
+    for (const magneto_Coords &pos : points) {
+        const magneto_FieldState B = eval_field(&wmm, t, pos);
+        const magneto_FieldState B_trunc = eval_field_truncated(&wmm, t, pos, &options, &info);
+        CHECK(info.degree <= prev_degree);
+        CHECK(info.error_bound <= options.tolerance);
+        real error = 0;
+        for (size_t i = 0U; i < 3U; ++i) {
+            error += sq(B_trunc.B_ned[i] - B.B_ned[i]);
+        }
+        error = std::sqrt(error);
+        CHECK(error <= info.error_bound);
+        prev_degree = info.degree;
+    }
+    CHECK(prev_degree < 4U);
+
+    // Capped degree reports a bound even if outside the tolerance
+    const magneto_TruncationOptions capped = { .tolerance = 0, .max_degree = 3U };
+    const magneto_FieldState B_capped = eval_field_truncated(&wmm, t, ground, &capped, &info);
+    CHECK(info.degree == 3U);
+    CHECK(std::fabs(B_capped.B_ned[2] - B_ground.B_ned[2]) <= info.error_bound);
+
+    // Without bounds only the cap applies
+    const magneto_Model unbounded = {
+        wmm.epoch, wmm.nm_max, wmm.num_model_coeffs, wmm.num_models, wmm.model_interval, wmm.models,
+        wmm.last_secular, wmm.recursion, magneto_NORMALIZATION_GAUSS, nullptr
+    };
+    eval_field_truncated(&unbounded, t, points[3], &options, &info);
+    CHECK(info.degree == wmm.nm_max);
+    CHECK(info.error_bound == 0);
+    eval_field_truncated(&unbounded, t, points[3], &capped, &info);
+    CHECK(info.degree == 3U);
+    CHECK(std::isinf(info.error_bound));
+
+    CHECK(eval_field_truncated(NULL, t, ground, &options, &info).F == 0);
+}
+
+/// Bounds of a high-degree model at GNSS & GEO radii, where (a/r)^(n+2) of the top degrees underflows
+TEST_CASE("test_eval_field_truncated_high_degree") {
+    const size_t nm_max = 720U;
+    const magneto_DecYear t = { .year = 2020.0 };
+    const size_t num_coeffs = MAGNETO_CALC_INDEX(nm_max, nm_max) + 1U;
+    const std::vector<magneto_SphericalHarmonicCoeff> coeffs(num_coeffs, magneto_SphericalHarmonicCoeff { 0, 0 });
+    const magneto_ModelCoeffs models[1] = { { coeffs.data() } };
+    // Pessimistic bounds that don't fall off with degree
+    const std::vector<real> degree_bounds(nm_max + 1U, 2e4);
+    const magneto_Model model = {
+        t, nm_max, num_coeffs, 1U, { 5.0 }, models, { coeffs.data() }, nullptr, magneto_NORMALIZATION_SCHMIDT,
+        degree_bounds.data()
+    };
+
+    const real radii[] = { 26560e3, 42164e3 };
+    const magneto_TruncationOptions options = { .tolerance = 1.0, .max_degree = 0U };
+    for (const real radius : radii) {
+        const magneto_Coords pos = { .latitude = 0, .longitude = 0, .height = radius - magneto_WGS84_A };
+        const real normed_r = magneto_GEOMAG_REF_RADIUS / magneto_SphericalCoords_from_coords(pos).radius;
+        REQUIRE(std::pow(normed_r, (real) (nm_max + 2U)) == 0);
+
+        // Reference truncation, with every degree's bound raised to its own power
+        size_t expected_degree = nm_max;
+        real expected_bound = 0;
+        for (; expected_degree > 1U; --expected_degree) {
+            const real term = degree_bounds[expected_degree] * std::pow(normed_r, (real) (expected_degree + 2U));
+            if ((expected_bound + term) > options.tolerance) {
+                break;
+            }
+            expected_bound += term;
+        }
+        REQUIRE(expected_degree > 1U);
+
+        magneto_TruncationInfo info;
+        const magneto_FieldState B = eval_field_truncated(&model, t, pos, &options, &info);
+        CHECK(std::isfinite(B.F));
+        CHECK(info.degree == expected_degree);
+        CHECK(std::fabs(info.error_bound - expected_bound) <= 1e-6);
+        CHECK(info.error_bound > 0);
+    }
+}
+
+TEST_CASE("test_eval_field_snapshot") {
+    const magneto_Model *const model = &magneto_MODEL_WMM2020;
+    const magneto_DecYear t = { .year = 2023.25 };
+    real buffer[MAGNETO_SNAPSHOT_LEN(90U)];
+
+    const magneto_ModelSnapshot snapshot = magneto_ModelSnapshot_from_model(model, t, buffer, ARRAY_SIZE(buffer));
+    REQUIRE(snapshot.model == model);
+    CHECK(snapshot.t.year == t.year);
+    CHECK(snapshot.coeffs == buffer);
+
+    const magneto_Coords positions[] = {
+        { 80, 0, 0 },
+        { 0, 120, 0 },
+        { -80, 240, 100000 },
+        { 45.5, -75.3, 12000 },
+    };
+    for (const magneto_Coords &pos : positions) {
+        const magneto_FieldState B = eval_field(model, t, pos);
+        const magneto_FieldState B_snap = eval_field_snapshot(&snapshot, pos);
+        CHECK(B_snap.B_ned[0] == Approx(B.B_ned[0]).epsilon(1e-12));
+        CHECK(B_snap.B_ned[1] == Approx(B.B_ned[1]).epsilon(1e-12));
+        CHECK(B_snap.B_ned[2] == Approx(B.B_ned[2]).epsilon(1e-12));
+        CHECK(B_snap.D == Approx(B.D).epsilon(1e-12));
+    }
+
+    // Buffer too small or missing
+    const magneto_ModelSnapshot bad = magneto_ModelSnapshot_from_model(model, t, buffer, ARRAY_SIZE(buffer) - 1U);
+    CHECK(bad.model == nullptr);
+    CHECK(magneto_ModelSnapshot_from_model(model, t, nullptr, ARRAY_SIZE(buffer)).model == nullptr);
+    CHECK(eval_field_snapshot(&bad, positions[0]).F == 0);
+}
+
+/// Reference evaluation calling `sin`, `cos` & `pow` for every term, as `eval_field` did originally
+static void eval_field_direct(
+    const magneto_Model &model,
+    const magneto_DecYear t,
+    const magneto_Coords pos,
+    real *const B_ned
+) {
+    const magneto_SphericalCoords sph = magneto_SphericalCoords_from_coords(pos);
+    const real delta_t = t.year - model.epoch.year;
+    const real sin_theta = std::cos(magneto_deg_to_rad(sph.polar));
+    const real cos_theta = std::sin(magneto_deg_to_rad(sph.polar));
+    const real phi = magneto_deg_to_rad(sph.azimuth);
+    const real normed_r = magneto_GEOMAG_REF_RADIUS / sph.radius;
+
+    real B_r = 0, B_theta = 0, B_phi = 0;
+    real P_n_n = 1, dP_n_n = 0;
+    for (size_t m = 0U; m <= model.nm_max; ++m) {
+        if (m > 0U) {
+            dP_n_n = (sin_theta * dP_n_n) + (cos_theta * P_n_n);
+            P_n_n = sin_theta * P_n_n;
+        }
+        real P_prev = 1, P_prevprev = 0, dP_prev = 0, dP_prevprev = 0;
+        for (size_t n = (m > 1U) ? m : 1U; n <= model.nm_max; ++n) {
+            real P = P_n_n, dP = dP_n_n;
+            if (n != m) {
+                const real K = calc_K((real) n, (real) m);
+                P = (cos_theta * P_prev) - (K * P_prevprev);
+                dP = (cos_theta * dP_prev) - (sin_theta * P_prev) - (K * dP_prevprev);
+            }
+            P_prevprev = P_prev;
+            P_prev = P;
+            dP_prevprev = dP_prev;
+            dP_prev = dP;
+
+            const size_t idx = MAGNETO_CALC_INDEX(n, m);
+            const real g = model.models[0].coeffs[idx].g + (delta_t * model.last_secular.coeffs[idx].g);
+            const real h = model.models[0].coeffs[idx].h + (delta_t * model.last_secular.coeffs[idx].h);
+            const real r_scalar = std::pow(normed_r, (real) (n + 2U));
+            const real c = std::cos((real) m * phi);
+            const real s = std::sin((real) m * phi);
+            B_r += r_scalar * ((g * c) + (h * s)) * (real) (n + 1U) * P;
+            B_theta -= r_scalar * ((g * c) + (h * s)) * dP;
+            B_phi -= r_scalar * (real) m * ((-g * s) + (h * c)) * P;
+        }
+    }
+    B_phi /= sin_theta;
+
+    const real eps = magneto_deg_to_rad(pos.latitude - sph.polar);
+    B_ned[0] = (-B_theta * std::cos(eps)) - (B_r * std::sin(eps));
+    B_ned[1] = B_phi;
+    B_ned[2] = (B_theta * std::sin(eps)) - (B_r * std::cos(eps));
+}
+
+TEST_CASE(
+    "test_eval_field_recurrence_accuracy"
+    * doctest::description("Trig & radial recurrences against direct evaluation with libm")
+) {
+    const magneto_DecYear t = { .year = 2021.7 };
+    real max_err = 0;
+    for (real lat = -89.5; lat <= 89.5; lat += 7.9) {
+        for (real lon = -180; lon <= 180; lon += 11.3) {
+            for (const real height : { -1000.0, 0.0, 400e3, 35786e3 }) {
+                const magneto_Coords pos = { .latitude = lat, .longitude = lon, .height = height };
+                const magneto_FieldState B = eval_field(&magneto_MODEL_WMM2020, t, pos);
+                real B_ref[3];
+                eval_field_direct(magneto_MODEL_WMM2020, t, pos, B_ref);
+                for (size_t k = 0U; k < 3U; ++k) {
+                    max_err = std::fmax(max_err, std::fabs(B.B_ned[k] - B_ref[k]));
+                }
+            }
+        }
+    }
+    MESSAGE("Max abs error vs direct evaluation: ", max_err, " nT");
+    CHECK(max_err < 1e-8);
+}
+
+TEST_CASE("test_eval_field_grid") {
+    const real lat[] = { -89.0, -33.3, 0.0, 51.5, 80.0 };
+    const real lon[] = { -180.0, -120.5, -45.0, 0.0, 10.0, 99.9, 179.0 };
+    const real height[] = { -500.0, 0.0, 400e3 };
+    const size_t N_lat = ARRAY_SIZE(lat);
+    const size_t N_lon = ARRAY_SIZE(lon);
+    const size_t N_h = ARRAY_SIZE(height);
+    const size_t N = N_lat * N_lon * N_h;
+    const magneto_CoordsGrid grid = { lat, lon, height, N_lat, N_lon, N_h };
+    const magneto_DecYear t = { .year = 2022.1 };
+
+    real workspace[MAGNETO_GRID_WORKSPACE_LEN(12U, ARRAY_SIZE(lon))];
+    real B_n[N], B_e[N], B_d[N], D[N], I[N];
+    const magneto_FieldStateBatch out = { { B_n, B_e, B_d }, NULL, NULL, D, I };
+    eval_field_grid(&magneto_MODEL_WMM2020, t, &grid, &out, workspace, ARRAY_SIZE(workspace));
+
+    for (size_t i_h = 0U; i_h < N_h; ++i_h) {
+        for (size_t i_lat = 0U; i_lat < N_lat; ++i_lat) {
+            for (size_t i_lon = 0U; i_lon < N_lon; ++i_lon) {
+                const size_t i = (((i_h * N_lat) + i_lat) * N_lon) + i_lon;
+                const magneto_Coords pos = { .latitude = lat[i_lat], .longitude = lon[i_lon], .height = height[i_h] };
+                const magneto_FieldState B = eval_field(&magneto_MODEL_WMM2020, t, pos);
+                CHECK(B_n[i] == Approx(B.B_ned[0]).epsilon(1e-11));
+                CHECK(B_e[i] == Approx(B.B_ned[1]).epsilon(1e-11));
+                CHECK(B_d[i] == Approx(B.B_ned[2]).epsilon(1e-11));
+                CHECK(D[i] == Approx(B.D).epsilon(1e-11));
+                CHECK(I[i] == Approx(B.I).epsilon(1e-11));
+            }
+        }
+    }
+
+    // Workspace too small
+    B_n[0] = 0;
+    eval_field_grid(&magneto_MODEL_WMM2020, t, &grid, &out, workspace, ARRAY_SIZE(workspace) - 1U);
+    CHECK(B_n[0] == 0);
+}
+
+TEST_CASE("test_eval_field_incremental") {
+    real workspace[MAGNETO_EVALUATOR_WORKSPACE_LEN(12U, 90U)];
+    magneto_Evaluator evaluator = magneto_Evaluator_from_model(&magneto_MODEL_WMM2020, workspace, ARRAY_SIZE(workspace));
+    REQUIRE(evaluator.model == &magneto_MODEL_WMM2020);
+
+    struct Query {
+        real year, lat, lon, height;
+    };
+    const Query queries[] = {
+        { 2021.0, 45.0, -75.0, 100.0 },
+        { 2021.0, 45.0, -75.0, 100.0 },    // Nothing changed
+        { 2021.0, 45.0, -74.9, 100.0 },    // Only longitude
+        { 2021.1, 45.0, -74.9, 100.0 },    // Only time
+        { 2021.1, 45.0, -74.9, 350.0 },    // Only height
+        { 2021.1, 45.1, -74.9, 350.0 },    // Only latitude
+        { 2024.9, -60.0, 170.0, 9000.0 },  // Everything
+    };
+    for (const Query &q : queries) {
+        const magneto_DecYear t = { .year = q.year };
+        const magneto_Coords pos = { .latitude = q.lat, .longitude = q.lon, .height = q.height };
+        const magneto_FieldState B = eval_field(&magneto_MODEL_WMM2020, t, pos);
+        const magneto_FieldState B_inc = eval_field_incremental(&evaluator, t, pos);
+        CHECK(B_inc.B_ned[0] == Approx(B.B_ned[0]).epsilon(1e-12));
+        CHECK(B_inc.B_ned[1] == Approx(B.B_ned[1]).epsilon(1e-12));
+        CHECK(B_inc.B_ned[2] == Approx(B.B_ned[2]).epsilon(1e-12));
+        CHECK(B_inc.I == Approx(B.I).epsilon(1e-12));
+    }
+
+    // Workspace too small
+    magneto_Evaluator bad = magneto_Evaluator_from_model(&magneto_MODEL_WMM2020, workspace, ARRAY_SIZE(workspace) - 1U);
+    CHECK(bad.model == nullptr);
+    const magneto_DecYear t = { .year = 2021.0 };
+    const magneto_Coords pos = { .latitude = 0, .longitude = 0, .height = 0 };
+    CHECK(eval_field_incremental(&bad, t, pos).F == 0);
+}
+
+/// Largest error of trilinear interpolation at the non-corner points of each leaf's 3x3x3 lattice,
+/// for the subtree at node `idx` with the box between `min` & `max`
+static real max_leaf_error(
+    const magneto_FieldCacheHeader *const cache,
+    const size_t idx,
+    const magneto_Coords min,
+    const magneto_Coords max
+) {
+    const magneto_FieldCacheNode *const nodes = (const magneto_FieldCacheNode *) (const void *) (cache + 1);
+    const magneto_FieldCacheNode &node = nodes[idx];
+    const auto lattice = [&](const real u, const real v, const real w) {
+        const magneto_Coords pos = {
+            .latitude = min.latitude + ((max.latitude - min.latitude) * u),
+            .longitude = min.longitude + ((max.longitude - min.longitude) * v),
+            .height = min.height + ((max.height - min.height) * w),
+        };
+        return pos;
+    };
+
+    real error = 0;
+    if (node.first_child != 0U) {
+        for (size_t c = 0U; c < 8U; ++c) {
+            const real u = (real) ((c >> 2U) & 1U) / 2;
+            const real v = (real) ((c >> 1U) & 1U) / 2;
+            const real w = (real) (c & 1U) / 2;
+            const real child_error = max_leaf_error(
+                cache, node.first_child + c, lattice(u, v, w), lattice(u + 0.5, v + 0.5, w + 0.5)
+            );
+            error = MAX_OF(error, child_error);
+        }
+        return error;
+    }
+    for (size_t i = 0U; i < 27U; ++i) {
+        const real u = (real) (i / 9U) / 2;
+        const real v = (real) ((i / 3U) % 3U) / 2;
+        const real w = (real) (i % 3U) / 2;
+        if ((u != 0.5) && (v != 0.5) && (w != 0.5)) {
+            continue;
+        }
+        real B_interp[3] = { 0, 0, 0 };
+        for (size_t c = 0U; c < 8U; ++c) {
+            const real weight = (((c >> 2U) & 1U) ? u : (1 - u)) * (((c >> 1U) & 1U) ? v : (1 - v)) * ((c & 1U) ? w : (1 - w));
+            for (size_t d = 0U; d < 3U; ++d) {
+                B_interp[d] += weight * node.B_ned[c][d];
+            }
+        }
+        const magneto_FieldState B = eval_field(&magneto_MODEL_WMM2020, cache->t, lattice(u, v, w));
+        const real error_i = sqrt(
+            sq(B_interp[0] - B.B_ned[0]) + sq(B_interp[1] - B.B_ned[1]) + sq(B_interp[2] - B.B_ned[2])
+        );
+        error = MAX_OF(error, error_i);
+    }
+    return error;
+}
+
+TEST_CASE("test_field_cache") {
+    const magneto_DecYear t = { .year = 2022.5 };
+    const magneto_Coords min = { .latitude = 44.0, .longitude = -76.0, .height = 0.0 };
+    const magneto_Coords max = { .latitude = 45.0, .longitude = -75.0, .height = 10e3 };
+    const real tolerance = 1.0;
+
+    // Stored as reals to be suitably aligned
+    static real buffer[MAGNETO_FIELD_CACHE_SIZE(256U) / sizeof(real)];
+    const size_t size = magneto_FieldCache_build(&magneto_MODEL_WMM2020, t, min, max, tolerance, 8U, buffer, sizeof(buffer));
+    REQUIRE(size > 0U);
+    const magneto_FieldCacheHeader *const cache = (const magneto_FieldCacheHeader *) buffer;
+    REQUIRE(magneto_FieldCache_is_valid(cache, size));
+    CHECK(cache->num_nodes > 1U);
+    CHECK(size == MAGNETO_FIELD_CACHE_SIZE(cache->num_nodes));
+    CHECK(cache->depth < 8U);
+    CHECK(cache->max_error <= tolerance);
+    CHECK(cache->max_error == Approx(max_leaf_error(cache, 0U, min, max)).epsilon(1e-9));
+
+    // Interior points, including the corners & split planes, aren't bounded by `max_error` but
+    // stay close to it for a field this smooth
+    for (size_t i = 0U; i <= 16U; ++i) {
+        for (size_t j = 0U; j <= 16U; ++j) {
+            const real frac = (real) ((i * 7U + j * 3U) % 17U) / 16.0;
+            const magneto_Coords pos = {
+                .latitude = min.latitude + ((max.latitude - min.latitude) * (real) i / 16.0),
+                .longitude = min.longitude + ((max.longitude - min.longitude) * (real) j / 16.0),
+                .height = min.height + ((max.height - min.height) * frac),
+            };
+            real B_ned[3];
+            REQUIRE(magneto_FieldCache_lookup(cache, pos, B_ned));
+            const magneto_FieldState B = eval_field(&magneto_MODEL_WMM2020, t, pos);
+            const real error = sqrt(
+                sq(B_ned[0] - B.B_ned[0]) + sq(B_ned[1] - B.B_ned[1]) + sq(B_ned[2] - B.B_ned[2])
+            );
+            CHECK(error <= 2 * tolerance);
+        }
+    }
+
+    // Outside of region
+    real B_ned[3];
+    const magneto_Coords outside = { .latitude = 45.1, .longitude = -75.5, .height = 0.0 };
+    CHECK_FALSE(magneto_FieldCache_lookup(cache, outside, B_ned));
+
+    // Not built with enough space, or invalid
+    CHECK(magneto_FieldCache_build(&magneto_MODEL_WMM2020, t, min, max, tolerance, 8U, buffer, size - 1U) == 0U);
+    CHECK(magneto_FieldCache_build(&magneto_MODEL_WMM2020, t, max, min, tolerance, 8U, buffer, sizeof(buffer)) == 0U);
+    CHECK_FALSE(magneto_FieldCache_is_valid(cache, size - 1U));
+
+    // Children looping back or past the last node
+    magneto_FieldCacheNode *const root = (magneto_FieldCacheNode *) (void *) ((magneto_FieldCacheHeader *) buffer + 1);
+    const uint32_t first_child = root->first_child;
+    REQUIRE(first_child != 0U);
+    const uint32_t corrupt[] = { cache->num_nodes - 7U, 0xFFFFFFFFU };
+    for (const uint32_t index : corrupt) {
+        root->first_child = index;
+        CHECK_FALSE(magneto_FieldCache_is_valid(cache, size));
+    }
+    root->first_child = first_child;
+    REQUIRE(magneto_FieldCache_is_valid(cache, size));
+    root[first_child].first_child = first_child;
+    CHECK_FALSE(magneto_FieldCache_is_valid(cache, size));
+}
+
+TEST_CASE("test_result_cache") {
+    const magneto_Model *const model = &magneto_MODEL_WMM2020;
+    const magneto_ResultCacheSteps steps = { 1e-4, 1e-4, 1.0, 1.0 / 365.25 };
+    // Stored as `int64_t` to be suitably aligned
+    static int64_t buffer[MAGNETO_RESULT_CACHE_SIZE(64U) / sizeof(int64_t)];
+    magneto_ResultCache *const cache = magneto_ResultCache_init(model, steps, buffer, sizeof(buffer));
+    REQUIRE(cache != nullptr);
+    CHECK(cache->num_slots == 64U);
+
+    // Evaluated at the nearest lattice point, hit or not
+    const magneto_DecYear t = { .year = 2022.5 };
+    const magneto_Coords site = { .latitude = 43.65432, .longitude = -79.38321, .height = 76.4 };
+    const magneto_Coords lattice = { .latitude = 43.6543, .longitude = -79.3832, .height = 76.0 };
+    const magneto_DecYear t_lattice = { .year = std::floor((2022.5 * 365.25) + 0.5) / 365.25 };
+    const magneto_FieldState B_expected = eval_field(model, t_lattice, lattice);
+    const magneto_FieldState B_miss = eval_field_cached(cache, t, site);
+    const magneto_Coords nearby = { .latitude = 43.65428, .longitude = -79.38318, .height = 76.1 };
+    const magneto_FieldState B_hit = eval_field_cached(cache, magneto_DecYear { t.year + 1e-4 }, nearby);
+    for (size_t i = 0U; i < 3U; ++i) {
+        CHECK(B_miss.B_ned[i] == Approx(B_expected.B_ned[i]).epsilon(1e-12));
+        CHECK(B_hit.B_ned[i] == B_miss.B_ned[i]);
+    }
+    CHECK(B_hit.F == B_miss.F);
+    magneto_ResultCacheStats stats = magneto_ResultCache_stats(cache);
+    CHECK(stats.hits == 1U);
+    CHECK(stats.misses == 1U);
+
+    // Different lattice point, & exact match without a step
+    const magneto_Coords moved = { .latitude = site.latitude + 1e-3, .longitude = site.longitude, .height = site.height };
+    eval_field_cached(cache, t, moved);
+    CHECK(magneto_ResultCache_stats(cache).misses == 2U);
+    const magneto_ResultCacheSteps exact = { 0, 0, 0, 0 };
+    magneto_ResultCache *const exact_cache = magneto_ResultCache_init(model, exact, buffer, sizeof(buffer));
+    REQUIRE(exact_cache != nullptr);
+    CHECK(eval_field_cached(exact_cache, t, site).B_ned[2] == eval_field(model, t, site).B_ned[2]);
+    CHECK(eval_field_cached(exact_cache, t, site).B_ned[2] == eval_field(model, t, site).B_ned[2]);
+    eval_field_cached(exact_cache, t, nearby);
+    stats = magneto_ResultCache_stats(exact_cache);
+    CHECK(stats.hits == 1U);
+    CHECK(stats.misses == 2U);
+
+#ifdef HAVE_ATOMICS
+    // Sites hammered from several threads, whose results must never be torn
+    magneto_ResultCache *const shared = magneto_ResultCache_init(model, steps, buffer, sizeof(buffer));
+    const size_t num_sites = 96U;
+    const size_t num_threads = 4U;
+    const size_t num_queries = 2000U;
+    std::vector<magneto_Coords> sites;
+    std::vector<magneto_FieldState> expected;
+    for (size_t i = 0U; i < num_sites; ++i) {
+        sites.push_back({ -60.0 + (1.25 * (real) i), (real) ((i * 37U) % 360U) - 180.0, 100.0 * (real) (i % 7U) });
+        expected.push_back(eval_field(model, t_lattice, sites.back()));
+    }
+    std::vector<size_t> num_wrong(num_threads, 0U);
+    std::vector<std::thread> threads;
+    for (size_t k = 0U; k < num_threads; ++k) {
+        threads.emplace_back([&, k]() {
+            for (size_t q = 0U; q < num_queries; ++q) {
+                const size_t i = ((q * 13U) + (k * 7U)) % num_sites;
+                const magneto_FieldState B = eval_field_cached(shared, t, sites[i]);
+                num_wrong[k] += (B.B_ned[0] != expected[i].B_ned[0]) || (B.B_ned[2] != expected[i].B_ned[2]);
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    for (size_t k = 0U; k < num_threads; ++k) {
+        CHECK(num_wrong[k] == 0U);
+    }
+    stats = magneto_ResultCache_stats(shared);
+    CHECK((stats.hits + stats.misses) == (num_threads * num_queries));
+    CHECK(stats.hits > 0U);
+#endif
+
+    // Invalid
+    CHECK(magneto_ResultCache_init(nullptr, steps, buffer, sizeof(buffer)) == nullptr);
+    CHECK(magneto_ResultCache_init(model, steps, buffer, MAGNETO_RESULT_CACHE_SIZE(1U) - 1U) == nullptr);
+    CHECK(magneto_ResultCache_init(model, steps, (char *) buffer + 4, sizeof(buffer) - 8U) == nullptr);
+    CHECK(eval_field_cached(nullptr, t, site).F == 0);
+    CHECK(magneto_ResultCache_stats(nullptr).hits == 0U);
+}
+
+TEST_CASE("test_model_registry") {
+    const magneto_Model *const wmm = &magneto_MODEL_WMM2020;
+    static magneto_RegistryReader readers[4];
+    magneto_ModelRegistry registry;
+    REQUIRE(magneto_ModelRegistry_init(&registry, wmm, readers, ARRAY_SIZE(readers)));
+
+    const magneto_DecYear t = { 2022.5 };
+    const magneto_Coords pos = { .latitude = 43.6, .longitude = -79.4, .height = 100.0 };
+    const real F_expected = eval_field(wmm, t, pos).F;
+    CHECK(magneto_ModelRegistry_acquire(&registry, 0U) == wmm);
+    magneto_ModelRegistry_release(&registry, 0U);
+    CHECK(eval_field_registry(&registry, 1U, t, pos).F == F_expected);
+
+    // Later readers see the new model, & the replaced one is handed back
+    const magneto_Model copy = *wmm;
+    CHECK(magneto_ModelRegistry_publish(&registry, &copy) == wmm);
+    CHECK(magneto_ModelRegistry_acquire(&registry, 2U) == &copy);
+    magneto_ModelRegistry_release(&registry, 2U);
+    CHECK(magneto_ModelRegistry_publish(&registry, wmm) == &copy);
+
+#ifdef HAVE_ATOMICS
+    // Readers evaluating while models are swapped & freed under them never see a freed one
+    const size_t num_threads = 3U;
+    std::atomic<bool> is_done(false);
+    std::vector<size_t> num_wrong(num_threads, 0U);
+    std::vector<size_t> num_evals(num_threads, 0U);
+    std::vector<std::thread> threads;
+    for (size_t k = 0U; k < num_threads; ++k) {
+        threads.emplace_back([&, k]() {
+            while (!is_done.load() || (num_evals[k] == 0U)) {
+                const magneto_Model *const model = magneto_ModelRegistry_acquire(&registry, k);
+                num_wrong[k] += (model->nm_max != 12U) || (eval_field(model, t, pos).F != F_expected);
+                magneto_ModelRegistry_release(&registry, k);
+                ++num_evals[k];
+            }
+        });
+    }
+    for (size_t i = 0U; i < 100U; ++i) {
+        const magneto_Model *const prev = magneto_ModelRegistry_publish(&registry, new magneto_Model(*wmm));
+        if (prev != wmm) {
+            std::memset(const_cast<magneto_Model *>(prev), 0, sizeof(*prev));
+            delete prev;
+        }
+    }
+    delete magneto_ModelRegistry_publish(&registry, wmm);
+    is_done = true;
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    for (size_t k = 0U; k < num_threads; ++k) {
+        CHECK(num_wrong[k] == 0U);
+        CHECK(num_evals[k] > 0U);
+    }
+#endif
+
+    // Invalid
+    CHECK_FALSE(magneto_ModelRegistry_init(nullptr, wmm, readers, ARRAY_SIZE(readers)));
+    CHECK_FALSE(magneto_ModelRegistry_init(&registry, wmm, readers, 0U));
+    CHECK(magneto_ModelRegistry_acquire(&registry, ARRAY_SIZE(readers)) == nullptr);
+    CHECK(magneto_ModelRegistry_publish(&registry, nullptr) == nullptr);
+    CHECK(eval_field_registry(&registry, ARRAY_SIZE(readers), t, pos).F == 0);
+    CHECK(eval_field_registry(&registry, 3U, t, pos).F == F_expected);
+}
+
+/// Write `model` in the binary model format, same as `tools/gen_coeffs.py`
+static size_t write_model_binary(const magneto_Model &model, unsigned char *const out, const size_t out_len) {
+    const size_t align = MAGNETO_MODEL_BINARY_ALIGNMENT;
+    const size_t coeffs_bytes = model.num_model_coeffs * sizeof(magneto_SphericalHarmonicCoeff);
+    const size_t models_bytes = model.num_models * coeffs_bytes;
+    const size_t recursion_bytes = (model.recursion != nullptr)
+        ? (model.num_model_coeffs * sizeof(magneto_RecursionConsts))
+        : 0U;
+    const size_t bounds_bytes = (model.degree_bounds != nullptr) ? ((model.nm_max + 1U) * sizeof(real)) : 0U;
+    const size_t terms_bytes = (model.terms != nullptr)
+        ? (model.num_models * model.num_model_coeffs * sizeof(magneto_SphericalHarmonicTerm))
+        : 0U;
+    const size_t roots_bytes = (model.roots != nullptr) ? (((2U * model.nm_max) + 1U) * sizeof(magneto_SquareRoot)) : 0U;
+    auto align_up = [align](const size_t x) { return ((x + align - 1U) / align) * align; };
+
+    magneto_ModelBinaryHeader header = {};
+    header.magic = MAGNETO_MODEL_BINARY_MAGIC;
+    header.version = MAGNETO_MODEL_BINARY_VERSION;
+    header.real_size = sizeof(real);
+    header.nm_max = (uint32_t) model.nm_max;
+    header.num_model_coeffs = (uint32_t) model.num_model_coeffs;
+    header.num_models = (uint32_t) model.num_models;
+    header.flags = ((recursion_bytes > 0U) ? MAGNETO_MODEL_BINARY_HAS_RECURSION : 0U)
+        | ((model.normalization == magneto_NORMALIZATION_SCHMIDT) ? MAGNETO_MODEL_BINARY_SCHMIDT : 0U)
+        | ((bounds_bytes > 0U) ? MAGNETO_MODEL_BINARY_HAS_BOUNDS : 0U)
+        | ((terms_bytes > 0U) ? MAGNETO_MODEL_BINARY_HAS_TERMS : 0U)
+        | ((roots_bytes > 0U) ? MAGNETO_MODEL_BINARY_HAS_ROOTS : 0U);
+    header.epoch = model.epoch.year;
+    header.model_interval = model.model_interval.year;
+    header.coeffs_offset = align_up(sizeof(header));
+    header.secular_offset = align_up(header.coeffs_offset + models_bytes);
+    header.recursion_offset = align_up(header.secular_offset + coeffs_bytes);
+    header.bounds_offset = align_up(header.recursion_offset + recursion_bytes);
+    header.terms_offset = align_up(header.bounds_offset + bounds_bytes);
+    header.roots_offset = align_up(header.terms_offset + terms_bytes);
+    header.file_size = align_up(header.roots_offset + roots_bytes);
+    REQUIRE(header.file_size <= out_len);
+
+    memset(out, 0, header.file_size);
+    memcpy(out, &header, sizeof(header));
+    for (size_t i = 0U; i < model.num_models; ++i) {
+        memcpy(out + header.coeffs_offset + (i * coeffs_bytes), model.models[i].coeffs, coeffs_bytes);
+    }
+    memcpy(out + header.secular_offset, model.last_secular.coeffs, coeffs_bytes);
+    if (recursion_bytes > 0U) {
+        memcpy(out + header.recursion_offset, model.recursion, recursion_bytes);
+    }
+    if (bounds_bytes > 0U) {
+        memcpy(out + header.bounds_offset, model.degree_bounds, bounds_bytes);
+    }
+    if (terms_bytes > 0U) {
+        memcpy(out + header.terms_offset, model.terms, terms_bytes);
+    }
+    if (roots_bytes > 0U) {
+        memcpy(out + header.roots_offset, model.roots, roots_bytes);
+    }
+    return header.file_size;
+}
+
+TEST_CASE("test_model_from_binary") {
+    alignas(MAGNETO_MODEL_BINARY_ALIGNMENT) static unsigned char data[16384];
+    const size_t size = write_model_binary(magneto_MODEL_WMM2020, data, sizeof(data));
+
+    magneto_ModelCoeffs models[1];
+    const magneto_Model model = magneto_Model_from_binary(data, size, models, ARRAY_SIZE(models));
+    REQUIRE(model.num_model_coeffs == magneto_MODEL_WMM2020.num_model_coeffs);
+    CHECK(model.nm_max == magneto_MODEL_WMM2020.nm_max);
+    CHECK(model.epoch.year == magneto_MODEL_WMM2020.epoch.year);
+    CHECK(model.recursion != nullptr);
+    CHECK(model.degree_bounds[1] == magneto_MODEL_WMM2020.degree_bounds[1]);
+    CHECK(model.terms[0].g_dot == magneto_MODEL_WMM2020.terms[0].g_dot);
+    // Zero-copy view of the data
+    CHECK((const void *) model.models[0].coeffs == (const void *) (data + 128U));
+
+    const magneto_DecYear t = { .year = 2023.3 };
+    const magneto_Coords pos = { .latitude = -12.3, .longitude = 145.6, .height = 2500.0 };
+    const magneto_FieldState B = eval_field(&magneto_MODEL_WMM2020, t, pos);
+    const magneto_FieldState B_bin = eval_field(&model, t, pos);
+    CHECK(B_bin.B_ned[0] == B.B_ned[0]);
+    CHECK(B_bin.B_ned[1] == B.B_ned[1]);
+    CHECK(B_bin.B_ned[2] == B.B_ned[2]);
+
+    // Invalid
+    CHECK(magneto_Model_from_binary(data, size - 1U, models, 1U).nm_max == 0U);
+    CHECK(magneto_Model_from_binary(data, size, models, 0U).nm_max == 0U);
+    CHECK(magneto_Model_from_binary(data + 8U, size - 8U, models, 1U).nm_max == 0U);
+    data[0] ^= 0xFFU;
+    CHECK(magneto_Model_from_binary(data, size, models, 1U).nm_max == 0U);
+    data[0] ^= 0xFFU;
+
+    // Through a mapped file
+    const char *const path = "test_model_from_binary.bin";
+    FILE *const f = fopen(path, "wb");
+    REQUIRE(f != nullptr);
+    REQUIRE(fwrite(data, 1U, size, f) == size);
+    fclose(f);
+    magneto_ModelFile file = magneto_ModelFile_open(path);
+    REQUIRE(file.data != nullptr);
+    CHECK(file.size == size);
+    const magneto_Model mapped = magneto_Model_from_binary(file.data, file.size, models, ARRAY_SIZE(models));
+    CHECK(eval_field(&mapped, t, pos).F == B.F);
+    magneto_ModelFile_close(&file);
+    CHECK(file.data == nullptr);
+    remove(path);
+    CHECK(magneto_ModelFile_open(path).data == nullptr);
+}
+
+TEST_CASE("test_eval_field_sub_models") {
+    // Series of 3 sub-models 5 years apart, each a scaled copy of WMM2020
+    const magneto_Model &wmm = magneto_MODEL_WMM2020;
+    const size_t num_models = 3U;
+    const real scales[num_models] = { 1.0, 1.02, 0.97 };
+    std::vector<std::vector<magneto_SphericalHarmonicCoeff>> coeffs(num_models);
+    for (size_t k = 0U; k < num_models; ++k) {
+        for (size_t i = 0U; i < wmm.num_model_coeffs; ++i) {
+            coeffs[k].push_back({ scales[k] * wmm.models[0].coeffs[i].g, scales[k] * wmm.models[0].coeffs[i].h });
+        }
+    }
+    const magneto_ModelCoeffs models[num_models] = { { coeffs[0].data() }, { coeffs[1].data() }, { coeffs[2].data() } };
+    const magneto_Model series = {
+        { 2000.0 }, wmm.nm_max, wmm.num_model_coeffs, num_models, { 5.0 }, models, wmm.last_secular, wmm.recursion,
+        magneto_NORMALIZATION_GAUSS
+    };
+    // Each sub-model on its own, only valid at its epoch or after the last one
+    auto eval_sub_model = [&](const size_t k, const real year, const magneto_Coords pos) {
+        const magneto_Model single = {
+            { 2000.0 + (5.0 * (real) k) }, wmm.nm_max, wmm.num_model_coeffs, 1U, { 5.0 }, &models[k],
+            wmm.last_secular, wmm.recursion, magneto_NORMALIZATION_GAUSS
+        };
+        return eval_field(&single, magneto_DecYear { year }, pos);
+    };
+
+    const magneto_Coords pos = { .latitude = 51.5, .longitude = -0.1, .height = 400e3 };
+    const magneto_FieldState B_0 = eval_sub_model(0U, 2000.0, pos);
+    const magneto_FieldState B_1 = eval_sub_model(1U, 2005.0, pos);
+    const magneto_FieldState B_2 = eval_sub_model(2U, 2010.0, pos);
+    for (size_t i = 0U; i < 3U; ++i) {
+        // At each epoch
+        CHECK(eval_field(&series, magneto_DecYear { 2000.0 }, pos).B_ned[i] == Approx(B_0.B_ned[i]).epsilon(1e-12));
+        CHECK(eval_field(&series, magneto_DecYear { 2005.0 }, pos).B_ned[i] == Approx(B_1.B_ned[i]).epsilon(1e-12));
+        CHECK(eval_field(&series, magneto_DecYear { 2010.0 }, pos).B_ned[i] == Approx(B_2.B_ned[i]).epsilon(1e-12));
+        // Interpolated between epochs & extrapolated before the first
+        const real B_mid = (B_0.B_ned[i] + B_1.B_ned[i]) / 2;
+        CHECK(eval_field(&series, magneto_DecYear { 2002.5 }, pos).B_ned[i] == Approx(B_mid).epsilon(1e-12));
+        const real B_before = B_0.B_ned[i] - (0.2 * (B_1.B_ned[i] - B_0.B_ned[i]));
+        CHECK(eval_field(&series, magneto_DecYear { 1999.0 }, pos).B_ned[i] == Approx(B_before).epsilon(1e-12));
+        // Last sub-model extrapolated with the secular variation
+        const real B_after = eval_sub_model(2U, 2013.5, pos).B_ned[i];
+        CHECK(eval_field(&series, magneto_DecYear { 2013.5 }, pos).B_ned[i] == Approx(B_after).epsilon(1e-12));
+    }
+
+    // Rates are the difference between sub-models
+    magneto_FieldRates rates;
+    eval_field_with_rates(&series, magneto_DecYear { 2006.0 }, pos, &rates);
+    CHECK(rates.B_ned[2] == Approx((B_2.B_ned[2] - B_1.B_ned[2]) / 5.0).epsilon(1e-10));
+
+    // Snapshot & grid at a single time
+    const magneto_DecYear t = { .year = 2007.25 };
+    const magneto_FieldState B = eval_field(&series, t, pos);
+    real snapshot_buffer[MAGNETO_SNAPSHOT_LEN(90U)];
+    const magneto_ModelSnapshot snapshot = magneto_ModelSnapshot_from_model(&series, t, snapshot_buffer, ARRAY_SIZE(snapshot_buffer));
+    CHECK(eval_field_snapshot(&snapshot, pos).B_ned[0] == Approx(B.B_ned[0]).epsilon(1e-12));
+    real B_d_grid[1];
+    real workspace[MAGNETO_GRID_WORKSPACE_LEN(12U, 1U)];
+    const magneto_CoordsGrid grid = { &pos.latitude, &pos.longitude, &pos.height, 1U, 1U, 1U };
+    const magneto_FieldStateBatch grid_out = { { NULL, NULL, B_d_grid }, NULL, NULL, NULL, NULL };
+    eval_field_grid(&series, t, &grid, &grid_out, workspace, ARRAY_SIZE(workspace));
+    CHECK(B_d_grid[0] == Approx(B.B_ned[2]).epsilon(1e-12));
+
+    // Batch with unsorted times, so chunks span several sub-models
+    const size_t N = 21U;
+    std::vector<real> lat(N, pos.latitude), lon(N), height(N, pos.height), B_d(N);
+    std::vector<magneto_DecYear> time(N);
+    for (size_t i = 0U; i < N; ++i) {
+        lon[i] = (real) (i * 17U);
+        time[i].year = 1998.0 + (real) ((i * 7U) % 19U);
+    }
+    const magneto_CoordsBatch in = { lat.data(), lon.data(), height.data(), time.data() };
+    const magneto_FieldStateBatch out = { { NULL, NULL, B_d.data() }, NULL, NULL, NULL, NULL };
+    eval_field_batch(&series, N, &in, &out);
+    for (size_t i = 0U; i < N; ++i) {
+        const magneto_Coords pos_i = { .latitude = lat[i], .longitude = lon[i], .height = height[i] };
+        CHECK(B_d[i] == Approx(eval_field(&series, time[i], pos_i).B_ned[2]).epsilon(BATCH_EPSILON));
+    }
+
+    // Binary models store every sub-model
+    alignas(MAGNETO_MODEL_BINARY_ALIGNMENT) static unsigned char data[32768];
+    const size_t size = write_model_binary(series, data, sizeof(data));
+    magneto_ModelCoeffs binary_models[num_models];
+    const magneto_Model binary = magneto_Model_from_binary(data, size, binary_models, num_models);
+    REQUIRE(binary.num_models == num_models);
+    CHECK(eval_field(&binary, t, pos).B_ned[2] == B.B_ned[2]);
+    CHECK(magneto_Model_from_binary(data, size, binary_models, num_models - 1U).nm_max == 0U);
+
+    // Order-major terms, with rates towards the next sub-model
+    std::vector<magneto_SphericalHarmonicTerm> terms;
+    for (size_t k = 0U; k < num_models; ++k) {
+        for (size_t m = 0U; m <= wmm.nm_max; ++m) {
+            for (size_t n = MAX_OF(m, 1U); n <= wmm.nm_max; ++n) {
+                const size_t i = MAGNETO_CALC_INDEX(n, m);
+                const bool is_last = ((k + 1U) == num_models);
+                const real g_dot = is_last ? wmm.last_secular.coeffs[i].g : ((coeffs[k + 1U][i].g - coeffs[k][i].g) / 5.0);
+                const real h_dot = is_last ? wmm.last_secular.coeffs[i].h : ((coeffs[k + 1U][i].h - coeffs[k][i].h) / 5.0);
+                terms.push_back({ coeffs[k][i].g, coeffs[k][i].h, g_dot, h_dot });
+            }
+        }
+    }
+    const magneto_Model ordered = {
+        { 2000.0 }, wmm.nm_max, wmm.num_model_coeffs, num_models, { 5.0 }, models, wmm.last_secular, wmm.recursion,
+        magneto_NORMALIZATION_GAUSS, nullptr, terms.data()
+    };
+    const real years[] = { 1999.0, 2002.5, 2007.25, 2013.5 };
+    for (const real year : years) {
+        const magneto_FieldState B_year = eval_field(&series, magneto_DecYear { year }, pos);
+        const magneto_FieldState B_ordered = eval_field(&ordered, magneto_DecYear { year }, pos);
+        CHECK(B_ordered.B_ned[0] == Approx(B_year.B_ned[0]).epsilon(1e-12));
+        CHECK(B_ordered.B_ned[2] == Approx(B_year.B_ned[2]).epsilon(1e-12));
+    }
+    eval_field_batch(&ordered, N, &in, &out);
+    for (size_t i = 0U; i < N; ++i) {
+        const magneto_Coords pos_i = { .latitude = lat[i], .longitude = lon[i], .height = height[i] };
+        CHECK(B_d[i] == Approx(eval_field(&series, time[i], pos_i).B_ned[2]).epsilon(BATCH_EPSILON));
+    }
+    const size_t ordered_size = write_model_binary(ordered, data, sizeof(data));
+    const magneto_Model ordered_binary = magneto_Model_from_binary(data, ordered_size, binary_models, num_models);
+    REQUIRE(ordered_binary.terms != nullptr);
+    CHECK(eval_field(&ordered_binary, t, pos).B_ned[2] == eval_field(&ordered, t, pos).B_ned[2]);
+}
+
+/// Table of square roots for a Schmidt model of degree `nm_max`
+static std::vector<magneto_SquareRoot> square_roots(const size_t nm_max) {
+    std::vector<magneto_SquareRoot> roots;
+    for (size_t k = 0U; k <= (2U * nm_max); ++k) {
+        const real root = std::sqrt((real) k);
+        roots.push_back({ root, (k > 0U) ? (1 / root) : 0 });
+    }
+    return roots;
+}
+
+TEST_CASE("test_eval_field_schmidt") {
+    // Undo the Gauss normalization of WMM2020, using the Schmidt factors S_{n,m}
+    const magneto_Model &wmm = magneto_MODEL_WMM2020;
+    std::vector<magneto_SphericalHarmonicCoeff> coeffs;
+    std::vector<magneto_SphericalHarmonicCoeff> secular;
+    real S_n_0 = 1;
+    for (size_t n = 1U; n <= wmm.nm_max; ++n) {
+        S_n_0 *= (real) ((2U * n) - 1U) / (real) n;
+        real S_n_m = S_n_0;
+        for (size_t m = 0U; m <= n; ++m) {
+            if (m > 0U) {
+                S_n_m *= std::sqrt((real) ((n - m + 1U) * ((m == 1U) ? 2U : 1U)) / (real) (n + m));
+            }
+            const size_t i = MAGNETO_CALC_INDEX(n, m);
+            coeffs.push_back({ wmm.models[0].coeffs[i].g / S_n_m, wmm.models[0].coeffs[i].h / S_n_m });
+            secular.push_back({ wmm.last_secular.coeffs[i].g / S_n_m, wmm.last_secular.coeffs[i].h / S_n_m });
+        }
+    }
+    const magneto_ModelCoeffs models[1] = { { coeffs.data() } };
+    const magneto_Model schmidt = {
+        wmm.epoch, wmm.nm_max, wmm.num_model_coeffs, 1U, wmm.model_interval, models, { secular.data() }, nullptr,
+        magneto_NORMALIZATION_SCHMIDT
+    };
+
+    const magneto_DecYear t = { .year = 2024.2 };
+    const real lats[] = { -90.0, -45.0, 0.0, 33.3, 89.99, 90.0 };
+    for (const real lat : lats) {
+        const magneto_Coords pos = { .latitude = lat, .longitude = -123.4, .height = 1e3 };
+        const magneto_FieldState B = eval_field(&wmm, t, pos);
+        const magneto_FieldState B_schmidt = eval_field(&schmidt, t, pos);
+        CHECK(B_schmidt.B_ned[0] == Approx(B.B_ned[0]).epsilon(1e-10));
+        CHECK(B_schmidt.B_ned[1] == Approx(B.B_ned[1]).epsilon(1e-10));
+        CHECK(B_schmidt.B_ned[2] == Approx(B.B_ned[2]).epsilon(1e-10));
+
+        magneto_FieldRates rates;
+        magneto_FieldRates rates_schmidt;
+        eval_field_with_rates(&wmm, t, pos, &rates);
+        eval_field_with_rates(&schmidt, t, pos, &rates_schmidt);
+        CHECK(rates_schmidt.B_ned[0] == Approx(rates.B_ned[0]).epsilon(1e-10));
+        CHECK(rates_schmidt.B_ned[1] == Approx(rates.B_ned[1]).epsilon(1e-10));
+        CHECK(rates_schmidt.B_ned[2] == Approx(rates.B_ned[2]).epsilon(1e-10));
+    }
+
+    // Batch & grid fall back to evaluating each point
+    const real lon[] = { 10.0, 20.0 };
+    const real height[] = { 0.0 };
+    const magneto_DecYear time[] = { t, t };
+    real B_d[2];
+    const magneto_CoordsBatch batch = { lats, lon, height, time };
+    const magneto_FieldStateBatch out = { { NULL, NULL, B_d }, NULL, NULL, NULL, NULL };
+    const magneto_Coords pos_0 = { .latitude = lats[0], .longitude = lon[0], .height = 0.0 };
+    eval_field_batch(&schmidt, 1U, &batch, &out);
+    CHECK(B_d[0] == Approx(eval_field(&wmm, t, pos_0).B_ned[2]).epsilon(1e-10));
+    const magneto_CoordsGrid grid = { lats, lon, height, 1U, 2U, 1U };
+    real workspace[MAGNETO_GRID_WORKSPACE_LEN(12U, 2U)];
+    eval_field_grid(&schmidt, t, &grid, &out, workspace, ARRAY_SIZE(workspace));
+    CHECK(B_d[0] == Approx(eval_field(&wmm, t, pos_0).B_ned[2]).epsilon(1e-10));
+
+    real evaluator_workspace[MAGNETO_EVALUATOR_WORKSPACE_LEN(12U, 90U)];
+    CHECK(magneto_Evaluator_from_model(&schmidt, evaluator_workspace, ARRAY_SIZE(evaluator_workspace)).model == nullptr);
+    CHECK(eval_field_with_gradient(&schmidt, t, pos_0, NULL).F == 0);
+
+    // Order-major terms are summed the same
+    std::vector<magneto_SphericalHarmonicTerm> terms;
+    for (size_t m = 0U; m <= wmm.nm_max; ++m) {
+        for (size_t n = MAX_OF(m, 1U); n <= wmm.nm_max; ++n) {
+            const size_t i = MAGNETO_CALC_INDEX(n, m);
+            terms.push_back({ coeffs[i].g, coeffs[i].h, secular[i].g, secular[i].h });
+        }
+    }
+    const magneto_Model schmidt_ordered = {
+        wmm.epoch, wmm.nm_max, wmm.num_model_coeffs, 1U, wmm.model_interval, models, { secular.data() }, nullptr,
+        magneto_NORMALIZATION_SCHMIDT, nullptr, terms.data()
+    };
+    magneto_FieldRates rates;
+    magneto_FieldRates rates_ordered;
+    const magneto_FieldState B_schmidt = eval_field_with_rates(&schmidt, t, pos_0, &rates);
+    const magneto_FieldState B_ordered = eval_field_with_rates(&schmidt_ordered, t, pos_0, &rates_ordered);
+    CHECK(B_ordered.B_ned[0] == B_schmidt.B_ned[0]);
+    CHECK(B_ordered.B_ned[2] == B_schmidt.B_ned[2]);
+    CHECK(rates_ordered.B_ned[1] == rates.B_ned[1]);
+
+    // Square roots looked up in a table instead
+    const std::vector<magneto_SquareRoot> roots = square_roots(wmm.nm_max);
+    const magneto_Model schmidt_roots = {
+        wmm.epoch, wmm.nm_max, wmm.num_model_coeffs, 1U, wmm.model_interval, models, { secular.data() }, nullptr,
+        magneto_NORMALIZATION_SCHMIDT, nullptr, nullptr, roots.data()
+    };
+    for (const real lat : lats) {
+        const magneto_Coords pos = { .latitude = lat, .longitude = 77.7, .height = 400e3 };
+        magneto_FieldRates rates_roots;
+        const magneto_FieldState B_plain = eval_field_with_rates(&schmidt, t, pos, &rates);
+        const magneto_FieldState B_roots = eval_field_with_rates(&schmidt_roots, t, pos, &rates_roots);
+        for (size_t i = 0U; i < 3U; ++i) {
+            CHECK(B_roots.B_ned[i] == Approx(B_plain.B_ned[i]).epsilon(1e-12).scale(1e-9));
+            CHECK(rates_roots.B_ned[i] == Approx(rates.B_ned[i]).epsilon(1e-12).scale(1e-9));
+        }
+    }
+    alignas(MAGNETO_MODEL_BINARY_ALIGNMENT) static unsigned char data[16384];
+    const size_t size = write_model_binary(schmidt_roots, data, sizeof(data));
+    magneto_ModelCoeffs binary_models[1];
+    const magneto_Model binary = magneto_Model_from_binary(data, size, binary_models, 1U);
+    REQUIRE(binary.roots != nullptr);
+    CHECK(binary.normalization == magneto_NORMALIZATION_SCHMIDT);
+    CHECK(binary.recursion == nullptr);
+    CHECK(binary.roots[7].inv_root == roots[7].inv_root);
+    CHECK(eval_field(&binary, t, pos_0).B_ned[2] == eval_field(&schmidt_roots, t, pos_0).B_ned[2]);
+    CHECK(magneto_Model_from_binary(data, size - MAGNETO_MODEL_BINARY_ALIGNMENT, binary_models, 1U).nm_max == 0U);
+
+    // Truncates the same as Gauss
+    const magneto_TruncationOptions capped = { .tolerance = 0, .max_degree = 4U };
+    const magneto_FieldState B_trunc = eval_field_truncated(&wmm, t, pos_0, &capped, NULL);
+    const magneto_FieldState B_trunc_schmidt = eval_field_truncated(&schmidt, t, pos_0, &capped, NULL);
+    CHECK(B_trunc_schmidt.B_ned[0] == Approx(B_trunc.B_ned[0]).epsilon(1e-10));
+    CHECK(B_trunc_schmidt.B_ned[2] == Approx(B_trunc.B_ned[2]).epsilon(1e-10));
+}
+
+/// Single high-degree terms at spots where the unscaled recursion under- or overflows
+TEST_CASE("test_eval_field_high_degree") {
+    const magneto_DecYear t = { .year = 2020.0 };
+    struct Term {
+        size_t n, m;
+        real lat, lon;
+    };
+    const Term terms[] = {
+        { 700U, 0U, 90.0, 0.0 },        // Zonal at the pole
+        { 700U, 700U, 0.0, 0.1 },       // Sectoral at the equator
+        { 700U, 350U, 88.0, 10.0 },     // Vanishingly small near the pole
+        { 700U, 600U, -30.0, 25.0 },
+        { 2000U, 1000U, 62.0, 25.0 },   // sin(theta)^m alone underflows
+    };
+    for (const Term &term : terms) {
+        const size_t num_coeffs = MAGNETO_CALC_INDEX(term.n, term.n) + 1U;
+        std::vector<magneto_SphericalHarmonicCoeff> coeffs;
+        for (size_t i = 0U; i < num_coeffs; ++i) {
+            coeffs.push_back({ (i == MAGNETO_CALC_INDEX(term.n, term.m)) ? 1.0 : 0.0, 0.0 });
+        }
+        const std::vector<magneto_SphericalHarmonicCoeff> secular(num_coeffs, magneto_SphericalHarmonicCoeff { 0, 0 });
+        const magneto_ModelCoeffs models[1] = { { coeffs.data() } };
+        const magneto_Model model = {
+            t, term.n, num_coeffs, 1U, { 5.0 }, models, { secular.data() }, nullptr, magneto_NORMALIZATION_SCHMIDT
+        };
+        const std::vector<magneto_SquareRoot> roots = square_roots(term.n);
+        const magneto_Model model_roots = {
+            t, term.n, num_coeffs, 1U, { 5.0 }, models, { secular.data() }, nullptr, magneto_NORMALIZATION_SCHMIDT,
+            nullptr, nullptr, roots.data()
+        };
+
+        const magneto_Coords pos = { .latitude = term.lat, .longitude = term.lon, .height = 0.0 };
+        const magneto_SphericalCoords sph = magneto_SphericalCoords_from_coords(pos);
+        const magneto_FieldState B = eval_field(&model, t, pos);
+        REQUIRE(std::isfinite(B.B_ned[0]));
+        REQUIRE(std::isfinite(B.B_ned[1]));
+        REQUIRE(std::isfinite(B.B_ned[2]));
+
+        // Reference B_r in extended range by the plain Schmidt recursion, if it's available
+        if (std::numeric_limits<long double>::max_exponent10 < 1000) {
+            continue;
+        }
+        const long double theta = (long double) (90.0 - sph.polar) * (long double) magneto_PI / 180;
+        const long double u = std::sin(theta);
+        const long double c = std::cos(theta);
+        long double P_m_m = 1;
+        for (size_t k = 1U; k <= term.m; ++k) {
+            P_m_m *= u * ((k > 1U) ? std::sqrt((long double) ((2U * k) - 1U) / (long double) (2U * k)) : 1);
+        }
+        long double P_nprev = P_m_m;
+        long double P_nprevprev = 0;
+        for (size_t n = term.m + 1U; n <= term.n; ++n) {
+            const long double root_n = std::sqrt((long double) ((n - term.m) * (n + term.m)));
+            const long double root_nprev = std::sqrt((long double) ((n - 1U - term.m) * (n - 1U + term.m)));
+            const long double P = ((((2 * n) - 1) * c * P_nprev) - (root_nprev * P_nprevprev)) / root_n;
+            P_nprevprev = P_nprev;
+            P_nprev = P;
+        }
+        const long double ratio = (long double) magneto_GEOMAG_REF_RADIUS / sph.radius;
+        const long double B_r_ref = (term.n + 1U) * std::pow(ratio, (long double) (term.n + 2U)) * P_nprev
+            * std::cos((long double) term.m * (long double) sph.azimuth * (long double) magneto_PI / 180);
+
+        // Undo the rotation from the geocentric to geodetic frame
+        const real eps = magneto_deg_to_rad(pos.latitude - sph.polar);
+        const real B_r = -((B.B_ned[0] * std::sin(eps)) + (B.B_ned[2] * std::cos(eps)));
+        CHECK(B_r == Approx((real) B_r_ref).epsilon(1e-10).scale(1e-300));
+        const magneto_FieldState B_roots = eval_field(&model_roots, t, pos);
+        const real B_r_roots = -((B_roots.B_ned[0] * std::sin(eps)) + (B_roots.B_ned[2] * std::cos(eps)));
+        CHECK(B_r_roots == Approx((real) B_r_ref).epsilon(1e-10).scale(1e-300));
+    }
+}
+
+/// Pool running tasks on a new `std::thread` each, in reverse order
+static void reverse_thread_pool(void *const pool, const magneto_TaskFn fn, void *const context, const size_t num_tasks) {
+    size_t *const num_calls = (size_t *) pool;
+    *num_calls += 1U;
+    std::vector<std::thread> threads;
+    for (size_t i = num_tasks; i > 0U; --i) {
+        threads.emplace_back(fn, context, i - 1U);
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+TEST_CASE("test_eval_field_batch_parallel") {
+    const size_t N = 1000U;
+    std::vector<real> lat(N), lon(N), height(N);
+    std::vector<magneto_DecYear> time(N);
+    for (size_t i = 0U; i < N; ++i) {
+        lat[i] = -89.0 + (178.0 * (real) i / N);
+        lon[i] = -180.0 + (real) ((i * 37U) % 360U);
+        height[i] = (real) ((i * 977U) % 100000U);
+        time[i].year = 2020.0 + (5.0 * (real) i / N);
+    }
+    const magneto_CoordsBatch in = { lat.data(), lon.data(), height.data(), time.data() };
+
+    std::vector<real> B_d(N), F(N);
+    const magneto_FieldStateBatch serial_out = { { NULL, NULL, B_d.data() }, F.data(), NULL, NULL, NULL };
+    eval_field_batch(&magneto_MODEL_WMM2020, N, &in, &serial_out);
+
+    size_t num_pool_calls = 0U;
+    const magneto_TaskPool pool = { reverse_thread_pool, &num_pool_calls };
+    const magneto_ParallelOptions options[] = {
+        { 0U, 0U, NULL },       // Serial
+        { 4U, 0U, NULL },       // Single chunk
+        { 3U, 50U, NULL },      // Chunk rounded up to a whole kernel width
+        { 8U, 8U, NULL },
+        { 1000U, 1U, NULL },    // More threads than allowed
+        { 4U, SIZE_MAX, NULL }, // Chunks too large to round up
+        { 2U, SIZE_MAX - 1U, NULL },
+        { 0U, 64U, &pool },
+    };
+    for (const magneto_ParallelOptions &opt : options) {
+        std::vector<real> B_d_par(N, 0.0), F_par(N, 0.0);
+        const magneto_FieldStateBatch out = { { NULL, NULL, B_d_par.data() }, F_par.data(), NULL, NULL, NULL };
+        eval_field_batch_parallel(&magneto_MODEL_WMM2020, N, &in, &out, &opt);
+        // Bitwise identical to the serial path
+        CHECK(memcmp(B_d_par.data(), B_d.data(), N * sizeof(real)) == 0);
+        CHECK(memcmp(F_par.data(), F.data(), N * sizeof(real)) == 0);
+    }
+    CHECK(num_pool_calls == 1U);
+}
+
+static void count_trace_terms(const magneto_TraceTerm *const term, void *const context) {
+    size_t *const count = static_cast<size_t *>(context);
+    CHECK(term->m <= term->n);
+    *count += 1U;
+}
+
+TEST_CASE("test_trace_stats") {
+    size_t hook_terms = 0U;
+    magneto_trace_reset();
+    magneto_trace_set_hook(count_trace_terms, &hook_terms);
+
+    const magneto_DecYear t = { .year = 2021.0 };
+    const magneto_Coords pos = { .latitude = 45, .longitude = -75, .height = 0 };
+    eval_field(&magneto_MODEL_WMM2020, t, pos);
+
+    const magneto_TraceStats stats = magneto_trace_stats();
+    magneto_trace_set_hook(NULL, NULL);
+    magneto_trace_reset();
+
+#ifdef MAGNETO_TRACE
+    CHECK(hook_terms == magneto_MODEL_WMM2020.num_model_coeffs);
+    CHECK(stats.terms == magneto_MODEL_WMM2020.num_model_coeffs);
+    CHECK(stats.stages[magneto_TRACE_STAGE_COORDS].calls == 1U);
+    CHECK(stats.stages[magneto_TRACE_STAGE_LEGENDRE].calls == magneto_MODEL_WMM2020.num_model_coeffs);
+    CHECK(stats.stages[magneto_TRACE_STAGE_COEFFS].calls == magneto_MODEL_WMM2020.num_model_coeffs);
+    CHECK(stats.stages[magneto_TRACE_STAGE_SUMMATION].calls == magneto_MODEL_WMM2020.num_model_coeffs);
+    CHECK(stats.stages[magneto_TRACE_STAGE_ROTATION].calls == 1U);
+    CHECK(magneto_trace_stats().terms == 0U);
+
+    // Snapshot terms that don't contribute are skipped, but still close their coefficient stage
+    real buffer[MAGNETO_SNAPSHOT_LEN(90U)];
+    const magneto_ModelSnapshot snapshot = magneto_ModelSnapshot_from_model(&magneto_MODEL_WMM2020, t, buffer, ARRAY_SIZE(buffer));
+    REQUIRE(snapshot.coeffs == buffer);
+    const size_t idx_zero[] = { MAGNETO_CALC_INDEX(3U, 1U), MAGNETO_CALC_INDEX(7U, 7U) };
+    for (const size_t idx : idx_zero) {
+        buffer[2U * idx] = 0;
+        buffer[(2U * idx) + 1U] = 0;
+    }
+    eval_field_snapshot(&snapshot, pos);
+    const magneto_TraceStats snapshot_stats = magneto_trace_stats();
+    magneto_trace_reset();
+    CHECK(snapshot_stats.terms == (magneto_MODEL_WMM2020.num_model_coeffs - ARRAY_SIZE(idx_zero)));
+    CHECK(snapshot_stats.stages[magneto_TRACE_STAGE_COEFFS].calls == magneto_MODEL_WMM2020.num_model_coeffs);
+    CHECK(
+        snapshot_stats.stages[magneto_TRACE_STAGE_SUMMATION].calls
+        == (magneto_MODEL_WMM2020.num_model_coeffs - ARRAY_SIZE(idx_zero))
+    );
+#else
+    // Instrumentation compiles to nothing
+    CHECK(hook_terms == 0U);
+    CHECK(stats.terms == 0U);
+    for (size_t i = 0U; i < magneto_TRACE_NUM_STAGES; ++i) {
+        CHECK(stats.stages[i].calls == 0U);
+        CHECK(stats.stages[i].cycles == 0U);
+    }
+#endif
+}
+
+#ifdef MAGNETO_CLI_PATH
+/// Write `text` to the file at `path`
+static void write_file(const char *const path, const std::string &text) {
+    FILE *const f = fopen(path, "wb");
+    REQUIRE(f != nullptr);
+    REQUIRE(fwrite(text.data(), 1U, text.size(), f) == text.size());
+    fclose(f);
+}
+
+/// Whole contents of the file at `path`
+static std::string read_file(const char *const path) {
+    std::string text;
+    FILE *const f = fopen(path, "rb");
+    REQUIRE(f != nullptr);
+    char buffer[4096];
+    size_t len = 0U;
+    while ((len = fread(buffer, 1U, sizeof(buffer), f)) > 0U) {
+        text.append(buffer, len);
+    }
+    fclose(f);
+    return text;
+}
+
+/// Run the command-line tool with `args`, returning its exit status
+static int run_cli(const std::string &args) {
+    const std::string command = std::string("\"") + MAGNETO_CLI_PATH + "\" " + args;
+    return std::system(command.c_str());
+}
+
+TEST_CASE(
+    "test_cli"
+    * doctest::description("Pipe points through the command-line tool & compare with the library")
+) {
+    // Over 1 MiB of varied number formats, so streams are refilled mid-line & some fields are
+    // only parsed by the fallback to `strtod`
+    const size_t N = 25000U;
+    std::string csv = "# latitude,longitude,height,year\n\n";
+    std::vector<real> points;
+    for (size_t i = 0U; i < N; ++i) {
+        const double lat = -89.5 + std::fmod((double) i * 0.7919, 179.0);
+        const double lon = -180.0 + std::fmod((double) i * 1.618, 360.0);
+        const double height = std::fmod((double) i * 37.1, 1e5);
+        const double year = 2020.0 + std::fmod((double) i * 0.00123, 4.9);
+        char line[256];
+        switch (i % 4U) {
+        case 0U:
+            snprintf(line, sizeof(line), "%.6f,%.6f,%.3f,%.6f\n", lat, lon, height, year);
+            break;
+        case 1U:
+            snprintf(line, sizeof(line), "%+.9f, %.9f,%.4e,%.17g\r\n", lat, lon, height, year);
+            break;
+        case 2U:
+            snprintf(line, sizeof(line), "  %.0f,%.3f,%.0f,%.4f\n", lat, lon, height, year);
+            break;
+        default:
+            snprintf(line, sizeof(line), "%.17g,%.17g,%.17g,%.17g\n", lat, lon, height, year);
+            break;
+        }
+        csv += line;
+        // Same values the tool parses, as `strtod` would
+        const char *pos = line;
+        for (size_t j = 0U; j < 4U; ++j) {
+            char *end = nullptr;
+            points.push_back((real) strtod(pos, &end));
+            pos = end + 1;
+        }
+    }
+    REQUIRE(csv.size() > (1U << 20U));
+    write_file("test_cli_input.csv", csv);
+
+    // Same points evaluated as a batch, like the tool does
+    std::vector<real> lat(N), lon(N), height(N);
+    std::vector<magneto_DecYear> time(N);
+    for (size_t i = 0U; i < N; ++i) {
+        lat[i] = points[4U * i];
+        lon[i] = points[(4U * i) + 1U];
+        height[i] = points[(4U * i) + 2U];
+        time[i].year = points[(4U * i) + 3U];
+    }
+    std::vector<std::vector<real>> fields(7U, std::vector<real>(N));
+    const magneto_CoordsBatch in = { lat.data(), lon.data(), height.data(), time.data() };
+    const magneto_FieldStateBatch out = {
+        { fields[0].data(), fields[1].data(), fields[2].data() },
+        fields[3].data(), fields[4].data(), fields[5].data(), fields[6].data()
+    };
+    eval_field_batch(&magneto_MODEL_WMM2020, N, &in, &out);
+
+    // Fields to 4 decimals in nT & 6 in deg, within batch precision in case lanes are grouped differently
+    REQUIRE(run_cli("test_cli_input.csv --output test_cli_mapped.csv") == 0);
+    const std::string output = read_file("test_cli_mapped.csv");
+    const char *pos = output.c_str();
+    size_t num_lines = 0U;
+    for (; (*pos != '\0') && (num_lines < N); ++num_lines) {
+        for (size_t j = 0U; j < 7U; ++j) {
+            char *end = nullptr;
+            const real value = (real) strtod(pos, &end);
+            const real expected = fields[j][num_lines];
+            CHECK(std::fabs(value - expected) <= (((j < 5U) ? 1e-4 : 1e-6) + (BATCH_EPSILON * std::fabs(expected))));
+            CHECK(*end == ((j < 6U) ? ',' : '\n'));
+            pos = end + 1;
+        }
+    }
+    CHECK(num_lines == N);
+    CHECK(*pos == '\0');
+
+    // Streamed from stdin, pipelined or not, and from binary records
+    REQUIRE(run_cli("- < test_cli_input.csv > test_cli_stdin.csv") == 0);
+    CHECK(read_file("test_cli_stdin.csv") == output);
+    REQUIRE(run_cli("--serial < test_cli_input.csv > test_cli_serial.csv") == 0);
+    CHECK(read_file("test_cli_serial.csv") == output);
+    write_file("test_cli_input.bin", std::string((const char *) points.data(), points.size() * sizeof(real)));
+    REQUIRE(run_cli("--input-format binary - < test_cli_input.bin > test_cli_binary.csv") == 0);
+    CHECK(read_file("test_cli_binary.csv") == output);
+
+    // Same model from a binary file
+    alignas(MAGNETO_MODEL_BINARY_ALIGNMENT) static unsigned char data[16384];
+    const size_t size = write_model_binary(magneto_MODEL_WMM2020, data, sizeof(data));
+    write_file("test_cli_model.bin", std::string((const char *) data, size));
+    REQUIRE(run_cli("--model test_cli_model.bin test_cli_input.csv > test_cli_model.csv") == 0);
+    CHECK(read_file("test_cli_model.csv") == output);
+
+    // Sub-models that can't fit in the file are rejected before allocating any
+    magneto_ModelBinaryHeader header;
+    memcpy(&header, data, sizeof(header));
+    header.num_models = 0xFFFFFFFFU;
+    memcpy(data, &header, sizeof(header));
+    write_file("test_cli_model.bin", std::string((const char *) data, size));
+    CHECK(run_cli("--model test_cli_model.bin test_cli_input.csv > test_cli_model.csv 2> test_cli_error.txt") != 0);
+    CHECK(read_file("test_cli_error.txt").find("Could not load model") != std::string::npos);
+
+    // Invalid line past the first 1 MiB, reported by line number
+    const size_t i_invalid = csv.find('\n', (1U << 20U) + 100U) + 1U;
+    size_t line_invalid = 1U;
+    for (size_t i = 0U; i < i_invalid; ++i) {
+        line_invalid += (csv[i] == '\n') ? 1U : 0U;
+    }
+    csv.insert(i_invalid, "1.0,2.0,x,2021.0\n");
+    write_file("test_cli_input.csv", csv);
+    const std::string expected_error = "line " + std::to_string(line_invalid) + "\n";
+    const char *const invalid_runs[] = {
+        "test_cli_input.csv > test_cli_mapped.csv 2> test_cli_error.txt",
+        "- < test_cli_input.csv > test_cli_stdin.csv 2> test_cli_error.txt",
+        "--serial < test_cli_input.csv > test_cli_serial.csv 2> test_cli_error.txt",
+    };
+    for (const char *const args : invalid_runs) {
+        CHECK(run_cli(args) != 0);
+        CHECK(read_file("test_cli_error.txt").find(expected_error) != std::string::npos);
+    }
+
+    const char *const paths[] = {
+        "test_cli_input.csv", "test_cli_input.bin", "test_cli_model.bin", "test_cli_error.txt", "test_cli_mapped.csv",
+        "test_cli_stdin.csv", "test_cli_serial.csv", "test_cli_binary.csv", "test_cli_model.csv",
+    };
+    for (const char *const path : paths) {
+        remove(path);
+    }
+}
+#endif
+
+#ifdef MAGNETO_DUAL_PRECISION
+TEST_CASE(
+    "test_dual_precision"
+    * doctest::description("Single-precision half of a dual build stays separate & agrees with double-precision")
+) {
+    struct TestValue {
+        real year, lat, lon, height;
+    };
+    const TestValue values[] = {
+        { 2020.0,  80,   0,      0 },
+        { 2020.0,   0, 120,      0 },
+        { 2020.0, -80, 240,      0 },
+        { 2022.5,  80,   0, 100000 },
+        { 2022.5, -80, 240, 100000 },
+        { 2024.9,  45, -75, 400000 },
+    };
+    for (const TestValue &v : values) {
+        const magneto_DecYear t = { .year = v.year };
+        const magneto_Coords pos = { .latitude = v.lat, .longitude = v.lon, .height = v.height };
+        const magneto_FieldState B = eval_field(&magneto_MODEL_WMM2020, t, pos);
+        double B_f[3];
+        single_precision_eval_field(v.year, v.lat, v.lon, v.height, B_f);
+        for (size_t i = 0U; i < 3U; ++i) {
+            // Within a few float ulps of the total intensity
+            CHECK(std::fabs(B_f[i] - B.B_ned[i]) < 1e-5 * B.F);
+        }
+    }
+
+    // Each half counts only its own evaluations
+    magneto_trace_reset();
+    single_precision_trace_reset();
+    single_precision_eval_field(2021.0, 45, -75, 0, std::vector<double>(3).data());
+    CHECK(magneto_trace_stats().terms == 0U);
+#  ifdef MAGNETO_TRACE
+    CHECK(single_precision_trace_terms() == magneto_MODEL_WMM2020.num_model_coeffs);
+#  else
+    CHECK(single_precision_trace_terms() == 0U);
+#  endif
+    single_precision_trace_reset();
+}
+#endif
@@ -0,0 +1,34 @@
+// Compiled as a single-precision translation unit of a dual-precision build, so every
+// library name below maps onto its `_f` suffixed symbol
+#define MAGNETO_SINGLE_PRECISION
+
+#include "test_single_precision.h"
+
+#include <magneto/magneto.h>
+#include <magneto/trace.h>
+#include <magneto/wmm.h>
+
+typedef char expecting_single_precision[(sizeof(magneto_real) == sizeof(float)) ? 1 : -1];
+
+void single_precision_eval_field(
+    const double year,
+    const double latitude,
+    const double longitude,
+    const double height,
+    double B_ned[3]
+) {
+    const magneto_DecYear t = { (magneto_real) year };
+    const magneto_Coords pos = { (magneto_real) latitude, (magneto_real) longitude, (magneto_real) height };
+    const magneto_FieldState B = eval_field(&magneto_MODEL_WMM2020, t, pos);
+    for (int i = 0; i < 3; ++i) {
+        B_ned[i] = (double) B.B_ned[i];
+    }
+}
+
+uint64_t single_precision_trace_terms(void) {
+    return magneto_trace_stats().terms;
+}
+
+void single_precision_trace_reset(void) {
+    magneto_trace_reset();
+}
@@ -0,0 +1,18 @@
+#ifndef TEST_SINGLE_PRECISION_H
+#define TEST_SINGLE_PRECISION_H
+
+#include <stdint.h>
+
+// Entry points into the single-precision half of a dual-precision build, with
+// plain `double` arguments so they're callable from the double-precision tests
+
+/// Evaluate `magneto_MODEL_WMM2020` with `eval_field_f`
+void single_precision_eval_field(double year, double latitude, double longitude, double height, double B_ned[3]);
+
+/// Number of terms counted by the single-precision half's trace stats, since its last reset
+uint64_t single_precision_trace_terms(void);
+
+/// Reset the single-precision half's trace stats
+void single_precision_trace_reset(void);
+
+#endif  // TEST_SINGLE_PRECISION_H
@@ -1,7 +1,8 @@
 
 from dataclasses import dataclass
 from functools import reduce
-from math import sqrt, factorial
+from math import hypot, sqrt, factorial
+import struct
 from typing import Any
 
 
@@ -23,7 +24,7 @@ def diag_index(n: int, m: int) -> int:
 
 def S_n_m(n: int, m: int) -> float:
     def double_fac(i: int) -> int:
-        return reduce(lambda a, b: a * b, range(1, n + 1, 2))
+        return reduce(lambda a, b: a * b, range(1, i + 1, 2), 1)
     kron_m_0 = (1 if m == 0 else 0)
     return sqrt(
         ((2 - kron_m_0) * factorial(n - m)) / factorial(n + m)
@@ -31,7 +32,7 @@ def S_n_m(n: int, m: int) -> float:
 
 
 def print_number(x: float, max_width: int) -> str:
-    return f"REAL({x:> {max_width}.16e}"
+    return f"REAL({x:> {max_width}.16e})"
 
 def gen_coeff_table(nm: list[tuple[int, int]], g: list[float], h: list[float]) -> str:
     max_width = max(max(len(str(x)) for x in col) for col in (g, h))
@@ -43,7 +44,159 @@ def gen_coeff_table(nm: list[tuple[int, int]], g: list[float], h: list[float]) -
     return "\n".join(code_lines)
 
 
-def read_wmm_cof(fname: str) -> WmmModel:
+def order_terms(models: list[WmmModel], interval: float) -> list[tuple[int, int, list[float]]]:
+    """Every sub-model's {g, h, g_dot, h_dot} in order-major order, like `MAGNETO_CALC_ORDER_INDEX`
+
+    Sub-models change linearly towards the next one, and the last with its secular variation.
+    """
+    nm_max = max(n for n, _ in models[-1].nm)
+    terms: list[tuple[int, int, list[float]]] = []
+    for i, sub in enumerate(models):
+        following = models[i + 1] if i + 1 < len(models) else None
+        for m in range(nm_max + 1):
+            for n in range(max(m, 1), nm_max + 1):
+                j = diag_index(n, m)
+                if following is None:
+                    g_dot, h_dot = sub.g_dot[j], sub.h_dot[j]
+                else:
+                    g_dot = (following.g[j] - sub.g[j]) / interval
+                    h_dot = (following.h[j] - sub.h[j]) / interval
+                terms.append((n, m, [sub.g[j], sub.h[j], g_dot, h_dot]))
+    return terms
+
+
+def gen_terms_table(terms: list[tuple[int, int, list[float]]]) -> str:
+    max_width = max(len(str(x)) for _, _, term in terms for x in term)
+    def print_num(x: float): return print_number(x, max_width)
+    code_lines: list[str] = ["// Auto-generated table by `tools/gen_coeffs.py`"]
+    for n, m, (g, h, g_dot, h_dot) in terms:
+        line = (
+            f"{{ .g = {print_num(g)}, .h = {print_num(h)}, .g_dot = {print_num(g_dot)}, .h_dot = {print_num(h_dot)} }},"
+            f"  // (n = {n:>3}, m = {m:>3})"
+        )
+        code_lines.append(line)
+    return "\n".join(code_lines)
+
+
+def K_n_m(n: int, m: int) -> float:
+    if n <= 1:
+        return 0.0
+    return ((n - 1) ** 2 - m ** 2) / ((2 * n - 1) * (2 * n - 3))
+
+
+def gen_recursion_table(nm: list[tuple[int, int]]) -> str:
+    # Constants only depend on degree & order, so the kernel needs no divisions
+    K = [K_n_m(n, m) for n, m in nm]
+    max_width = max(len(str(x)) for x in K)
+    def print_num(x: float): return print_number(x, max_width)
+    code_lines: list[str] = ["// Auto-generated table by `tools/gen_coeffs.py`"]
+    for (n_i, m_i), K_i in zip(nm, K):
+        line = (
+            f"{{ .K = {print_num(K_i)}, .n_plus_1 = REAL({n_i + 1:>3}.0), .m = REAL({m_i:>3}.0) }},"
+            f"  // (n = {n_i:>3}, m = {m_i:>3})"
+        )
+        code_lines.append(line)
+    return "\n".join(code_lines)
+
+
+def degree_bounds(models: list[WmmModel], interval: float, schmidt: bool = False) -> list[float]:
+    """Bound on the field magnitude [nT] of each degree at the reference radius, indexed by degree
+
+    Schmidt semi-normalized functions are bounded by 1 and, by Bernstein's inequality, so is their
+    derivative along any great circle by n, so degree n contributes at most
+    `sqrt((n + 1)^2 + n^2) * sum_m |(g, h)|`. Sub-models are interpolated towards the next, so each
+    coefficient is largest at either end, and the last is extrapolated over an interval.
+    """
+    last = models[-1]
+    nm_max = max(n for n, _ in last.nm)
+    bounds = [0.0] * (nm_max + 1)
+    for i, (n, m) in enumerate(last.nm):
+        scale = 1.0 if schmidt else S_n_m(n, m)
+        largest = max(hypot(sub.g[i], sub.h[i]) for sub in models)
+        largest = max(largest, hypot(last.g[i], last.h[i]) + interval * hypot(last.g_dot[i], last.h_dot[i]))
+        bounds[n] += sqrt((n + 1) ** 2 + n ** 2) * largest / scale
+    return bounds
+
+
+def gen_bounds_table(bounds: list[float]) -> str:
+    max_width = max(len(str(x)) for x in bounds)
+    code_lines: list[str] = ["// Auto-generated table by `tools/gen_coeffs.py`"]
+    for n, bound in enumerate(bounds):
+        code_lines.append(f"{print_number(bound, max_width)},  // (n = {n:>3})")
+    return "\n".join(code_lines)
+
+
+# Binary model format, must match `include/magneto/model_binary.h`
+BINARY_MAGIC = 0x444D474D
+BINARY_VERSION = 4
+BINARY_ALIGNMENT = 64
+BINARY_HAS_RECURSION = 1 << 0
+BINARY_SCHMIDT = 1 << 1
+BINARY_HAS_BOUNDS = 1 << 2
+BINARY_HAS_TERMS = 1 << 3
+BINARY_HAS_ROOTS = 1 << 4
+BINARY_HEADER = struct.Struct("<IHHIIIIddQQQQQQQ32s")
+
+
+def gen_binary(models: list[WmmModel], single: bool = False, interval: float = 5.0, schmidt: bool = False) -> bytes:
+    # Sub-models are consecutive & evenly spaced, only the secular variation of the last is stored
+    real_fmt, real_size = ("f", 4) if single else ("d", 8)
+    model = models[-1]
+    nm_max = max(n for n, _ in model.nm)
+    num_coeffs = len(model.nm)
+    assert num_coeffs == diag_index(nm_max, nm_max) + 1
+    assert all(sub.nm == model.nm for sub in models)
+
+    def pack_reals(xs: list[float]) -> bytes:
+        return struct.pack(f"<{len(xs)}{real_fmt}", *xs)
+
+    def interleave(*cols: list[float]) -> list[float]:
+        return [x for row in zip(*cols) for x in row]
+
+    sections = [
+        b"".join(pack_reals(interleave(sub.g, sub.h)) for sub in models),
+        pack_reals(interleave(model.g_dot, model.h_dot)),
+        pack_reals(degree_bounds(models, interval, schmidt)),
+        pack_reals([x for _, _, term in order_terms(models, interval) for x in term]),
+    ]
+    # Recursion constants are only for the Gauss normalized recursion, and square roots for the Schmidt one
+    flags = BINARY_HAS_BOUNDS | BINARY_HAS_TERMS
+    if schmidt:
+        flags |= BINARY_SCHMIDT | BINARY_HAS_ROOTS
+        roots = [sqrt(k) for k in range(2 * nm_max + 1)]
+        sections.append(pack_reals(interleave(roots, [(1 / x) if x > 0 else 0.0 for x in roots])))
+    else:
+        flags |= BINARY_HAS_RECURSION
+        K = [K_n_m(n, m) for n, m in model.nm]
+        sections.append(
+            pack_reals(interleave(K, [float(n + 1) for n, _ in model.nm], [float(m) for _, m in model.nm]))
+        )
+
+    # Every section starts aligned, so the reals can be used in-place from a mapped file
+    def align(x: int) -> int:
+        return -(-x // BINARY_ALIGNMENT) * BINARY_ALIGNMENT
+    offsets: list[int] = []
+    end = align(BINARY_HEADER.size)
+    for section in sections:
+        offsets.append(end)
+        end = align(end + len(section))
+    recursion_offset = 0 if schmidt else offsets[4]
+    roots_offset = offsets[4] if schmidt else 0
+
+    header = BINARY_HEADER.pack(
+        BINARY_MAGIC, BINARY_VERSION, real_size,
+        nm_max, num_coeffs, len(models), flags,
+        models[0].epoch, interval, end, offsets[0], offsets[1], recursion_offset, offsets[2], offsets[3], roots_offset,
+        model.title.encode("ascii")[:31],
+    )
+    out = bytearray(end)
+    out[:len(header)] = header
+    for offset, section in zip(offsets, sections):
+        out[offset:offset + len(section)] = section
+    return bytes(out)
+
+
+def read_wmm_cof(fname: str, schmidt: bool = False) -> WmmModel:
     with open(fname) as f:
         # Parse header
         header = [x.strip() for x in f.readline().strip().split()]
@@ -69,9 +222,9 @@ def read_wmm_cof(fname: str) -> WmmModel:
             ns.append(n)
             ms.append(m)
 
-            # Compute correctly normed coefficients
+            # Compute correctly normed coefficients, unless kept Schmidt semi-normalized as published
             coeffs_i = (float(x) for x in data[2:])
-            normed_coeffs = (S_n_m(n, m) * x for x in coeffs_i)
+            normed_coeffs = (x if schmidt else S_n_m(n, m) * x for x in coeffs_i)
             normed_coeffs = (0.0 if x == 0.0 else x for x in normed_coeffs)
             g, h, g_dot, h_dot = normed_coeffs
             gs.append(g)
@@ -89,3 +242,100 @@ def read_wmm_cof(fname: str) -> WmmModel:
 
     nm, g, h, g_dot, h_dot = zip(*coeffs)
     return WmmModel(name, date, epoch, nm, g, h, g_dot, h_dot)  # type: ignore
+
+
+def read_igrf_coeffs(fname: str, schmidt: bool = False) -> tuple[list[WmmModel], float]:
+    """Read a multi-epoch IGRF-format table into one model per epoch & their interval
+
+    Rows are `g/h n m` followed by a coefficient per epoch & the secular variation of the
+    last epoch. Only the last model has non-zero rates, as sub-models in between are
+    linearly interpolated to the next one.
+    """
+    epochs: list[float] = []
+    rows: dict[tuple[int, int], list[list[float]]] = {}
+    with open(fname) as f:
+        for line in f:
+            data = line.split()
+            if not data or data[0].startswith("#") or data[0] == "c/s":
+                continue
+            if data[0] == "g/h":
+                epochs = [float(x) for x in data[3:-1]]
+                continue
+            assert epochs and data[0] in ("g", "h") and len(data) == len(epochs) + 4
+            n, m = int(data[1]), int(data[2])
+            row = rows.setdefault((n, m), [[0.0] * (len(epochs) + 1), [0.0] * (len(epochs) + 1)])
+            row[0 if data[0] == "g" else 1] = [float(x) for x in data[3:]]
+
+    # Sub-models must be evenly spaced
+    intervals = {round(b - a, 6) for a, b in zip(epochs, epochs[1:])}
+    assert len(intervals) <= 1, f"Epochs aren't evenly spaced: {epochs}"
+    interval = intervals.pop() if intervals else 5.0
+
+    nm_max = max(n for n, _ in rows)
+    nm = [(n, m) for n in range(1, nm_max + 1) for m in range(n + 1)]
+    assert all(diag_index(n, m) == i for i, (n, m) in enumerate(nm))
+    assert set(nm) == set(rows), "Missing coefficients"
+
+    def normed(n: int, m: int, x: float) -> float:
+        x = x if schmidt else S_n_m(n, m) * x
+        return 0.0 if x == 0.0 else x
+
+    name = fname.rsplit("/", 1)[-1].split(".")[0]
+    models: list[WmmModel] = []
+    for i, epoch in enumerate(epochs):
+        is_last = (i + 1) == len(epochs)
+        g = [normed(n, m, rows[n, m][0][i]) for n, m in nm]
+        h = [normed(n, m, rows[n, m][1][i]) for n, m in nm]
+        g_dot = [normed(n, m, rows[n, m][0][-1]) if is_last else 0.0 for n, m in nm]
+        h_dot = [normed(n, m, rows[n, m][1][-1]) if is_last else 0.0 for n, m in nm]
+        models.append(WmmModel(name, f"{epoch:.1f}", epoch, nm, g, h, g_dot, h_dot))
+    return models, interval
+
+
+def read_coeffs(fname: str, schmidt: bool = False) -> tuple[list[WmmModel], float | None]:
+    """Read either a single-epoch WMM `.COF` file or a multi-epoch IGRF table"""
+    with open(fname) as f:
+        first = f.readline().split()
+    if first and (first[0].startswith("#") or first[0] in ("c/s", "g/h")):
+        return read_igrf_coeffs(fname, schmidt)
+    return [read_wmm_cof(fname, schmidt)], None
+
+
+if __name__ == "__main__":
+    import argparse
+    parser = argparse.ArgumentParser(description="Generate C tables from a WMM or IGRF-format coefficient file")
+    parser.add_argument("cof", help="Path to `.COF` coefficient file, or multi-epoch IGRF coefficient table")
+    parser.add_argument("--binary", metavar="FILE", help="Write a binary model for `magneto_Model_from_binary` instead")
+    parser.add_argument("--single", action="store_true", help="Use single-precision floats in the binary model")
+    parser.add_argument(
+        "--interval", type=float, default=5.0,
+        help="Model validity interval in years, only for single-epoch files as IGRF tables have their own",
+    )
+    parser.add_argument(
+        "--schmidt", action="store_true",
+        help="Keep Schmidt semi-normalized coefficients in the binary model, needed beyond degree ~100",
+    )
+    args = parser.parse_args()
+
+    schmidt = args.binary is not None and args.schmidt
+    models, interval = read_coeffs(args.cof, schmidt)
+    interval = args.interval if interval is None else interval
+    if args.binary:
+        with open(args.binary, "wb") as f:
+            f.write(gen_binary(models, args.single, interval, schmidt))
+        raise SystemExit(0)
+    for sub in models:
+        print(f"// Coefficients of {sub.title} ({sub.date})")
+        print(gen_coeff_table(sub.nm, sub.g, sub.h))
+        print("")
+    model = models[-1]
+    if len(models) > 1:
+        print(f"// Sub-models every {interval} years from {models[0].epoch}")
+    print("// Secular variation coefficients")
+    print(gen_coeff_table(model.nm, model.g_dot, model.h_dot))
+    print("\n// Recursion constants")
+    print(gen_recursion_table(model.nm))
+    print("\n// Field bounds of each degree")
+    print(gen_bounds_table(degree_bounds(models, interval, schmidt)))
+    print("\n// Order-major coefficients & rates of every sub-model")
+    print(gen_terms_table(order_terms(models, interval)))